@@ -14,6 +14,7 @@
 # HAVE_VARIADIC_TEMPLATES          True if variadic templates are supprt
 # HAVE_VARIADIC_CONSTRUCTOR_SFINAE True if variadic constructor sfinae is supported
 # HAVE_RVALUE_REFERENCES           True if rvalue references are supported
+# HAVE_STD_THREAD                  True if std::thread, std::mutex and std::atomic are supported
 
 include(CMakePushCheckState)
 cmake_push_check_state()
@@ -299,4 +300,30 @@ CHECK_CXX_SOURCE_COMPILES("
   }
 " HAVE_RVALUE_REFERENCES
 )
+
+# std::thread, std::mutex and std::atomic
+find_package(Threads)
+set(CMAKE_REQUIRED_LIBRARIES ${CMAKE_REQUIRED_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+CHECK_CXX_SOURCE_COMPILES("
+  #include <atomic>
+  #include <mutex>
+  #include <thread>
+
+  std::atomic<int> counter(0);
+  std::mutex m;
+
+  void work()
+  {
+    std::lock_guard<std::mutex> lock(m);
+    ++counter;
+  }
+
+  int main(void)
+  {
+    std::thread t(work);
+    t.join();
+    return counter == 1 ? 0 : 1;
+  }
+" HAVE_STD_THREAD
+)
 cmake_pop_check_state()
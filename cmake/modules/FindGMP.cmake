@@ -40,7 +40,7 @@ include(CMakePushCheckState)
 cmake_push_check_state()
 set(CMAKE_REQUIRED_INCLUDES ${CMAKE_REQUIRED_INCLUDES} ${GMP_INCLUDE_DIR})
 include(CheckIncludeFileCXX)
-check_include_file_cxx("gmpxx.h" GMP_FOUND)
+check_include_file_cxx("gmpxx.h" GMP_HEADER_USABLE)
 
 # look for library gmp, only at positions given by the user
 find_library(GMP_LIB gmp 
@@ -62,10 +62,13 @@ find_library(GMPXX_LIB gmpxx)
 
 # check if library works
 set(GMP_FOUND "GMP_FOUND-NOTFOUND")
-if(GMP_LIB AND GMPXX_LIB)
-  include(CheckSymbolExists)
-  check_symbol_exists(__gmpz_abs ${GMP_LIB} GMP_FOUND)
-endif(GMP_LIB AND GMPXX_LIB)
+if(GMP_HEADER_USABLE AND GMP_LIB AND GMPXX_LIB)
+  include(CheckLibraryExists)
+  check_library_exists(${GMP_LIB} __gmpz_abs "" GMP_LIB_WORKS)
+  if(GMP_LIB_WORKS)
+    set(GMP_FOUND TRUE)
+  endif(GMP_LIB_WORKS)
+endif(GMP_HEADER_USABLE AND GMP_LIB AND GMPXX_LIB)
 cmake_pop_check_state()
 
 # behave like a CMake module is supposed to behave
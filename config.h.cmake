@@ -158,6 +158,9 @@
 /* Define to 1 if rvalue references are supported */
 #cmakedefine HAVE_RVALUE_REFERENCES 1
 
+/* Define to 1 if std::thread, std::mutex and std::atomic are supported */
+#cmakedefine HAVE_STD_THREAD 1
+
 /* Include always useful headers */
 #include <dune/common/deprecated.hh>
 #include <dune/common/unused.hh>
@@ -109,7 +109,75 @@ namespace Dune
 #endif
       };
   };
-  
+
+  /**
+   * @brief Alignment in bytes used for SIMD friendly storage.
+   *
+   * Defaults to 32, the width of AVX registers. Define it before
+   * including this file to change it.
+   */
+#ifndef DUNE_SIMD_ALIGNMENT
+#define DUNE_SIMD_ALIGNMENT 32
+#endif
+
+  /**
+   * @brief Attribute forcing the alignment of a type or variable to a bytes.
+   *
+   * Expands to nothing for compilers that are not known to support it,
+   * the storage is then only padded but not aligned.
+   */
+#if defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define DUNE_ALIGNED(a) __attribute__((aligned(a)))
+#else
+#define DUNE_ALIGNED(a)
+#endif
+
+  /**
+   * @brief Calculates the number of entries of type T needed to store
+   * N entries padded to a multiple of A bytes.
+   *
+   * If sizeof(T) does not divide A, no padding is added.
+   */
+  template <class T, std::size_t N, std::size_t A = DUNE_SIMD_ALIGNMENT>
+  struct PaddedLength
+  {
+    enum
+      {
+	/** @brief The number of entries of T in A bytes. */
+	lanes = (A % sizeof(T) == 0) ? A / sizeof(T) : 1,
+	/** @brief N rounded up to a multiple of lanes. */
+	value = (N + lanes - 1) / lanes * lanes
+      };
+  };
+
+  /**
+   * @brief Array of N entries of type T, padded to a multiple of A bytes
+   * and aligned to A bytes.
+   *
+   * All PaddedLength<T,N,A>::value entries are accessible, so that
+   * kernels can process the array with full width aligned loads and
+   * without a remainder loop. Objects on the heap are only aligned if
+   * they are allocated accordingly, e.g. by AlignedMallocAllocator.
+   */
+  template <class T, std::size_t N, std::size_t A = DUNE_SIMD_ALIGNMENT>
+  struct AlignedArray
+  {
+    enum
+      {
+	/** @brief The number of used entries. */
+	size = N,
+	/** @brief The number of stored entries, including the padding. */
+	paddedSize = PaddedLength<T, N, A>::value,
+	/** @brief The alignment of the storage. */
+	alignment = A < std::size_t(AlignmentOf<T>::value) ? std::size_t(AlignmentOf<T>::value) : A
+      };
+
+    T data[paddedSize] DUNE_ALIGNED(alignment);
+
+    T& operator[] (std::size_t i) { return data[i]; }
+    const T& operator[] (std::size_t i) const { return data[i]; }
+  };
+
   /** @} */
 }
 #endif
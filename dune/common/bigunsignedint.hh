@@ -6,6 +6,8 @@
 #include<iostream>
 #include<limits>
 #include<cstdlib>
+#include<cmath>
+#include<stdint.h>
 #include<dune/common/exceptions.hh>
 #include<dune/common/hash.hh>
 
@@ -27,12 +29,31 @@ namespace Dune
   struct MPITraits;
 #endif
 
+  namespace BigUnsignedIntImpl
+  {
+    // The limbs are 64 bits wide if the compiler has a 128 bit integer
+    // type to hold their products, otherwise 32 bits wide.
+#ifdef __SIZEOF_INT128__
+    typedef uint64_t limb_type;
+    __extension__ typedef unsigned __int128 double_limb_type;
+#else
+    typedef uint32_t limb_type;
+    typedef uint64_t double_limb_type;
+#endif
+  }
+
   /**
    * @brief Portable very large unsigned integers 
    *
    * Implements (arbitrarily) large unsigned integers to be used as global
    * ids in some grid managers. Size is a template parameter.
    *
+   * The number is stored in n limbs of type limb_type, least
+   * significant limb first. Multiplication is the schoolbook algorithm,
+   * division and modulo use Knuth's long division, which reduces to a
+   * single pass over the limbs for divisors fitting into one limb.
+   * The comparisons always look at all limbs.
+   *
    * \tparam k Number of bits of the integer type
    */
 
@@ -40,10 +61,12 @@ namespace Dune
   class bigunsignedint {
   public:
 
-	// unsigned short is 16 bits wide, n is the number of digits needed
-    enum { bits=std::numeric_limits<unsigned short>::digits, n=k/bits+(k%bits!=0), 
-	   hexdigits=4, bitmask=0xFFFF, compbitmask=0xFFFF0000, 
-	   overflowmask=0x1 };
+    //! type of the limbs holding the digits of the number
+    typedef BigUnsignedIntImpl::limb_type limb_type;
+
+	// bits is the width of a limb, n is the number of limbs needed
+    enum { bits=std::numeric_limits<limb_type>::digits, n=k/bits+(k%bits!=0), 
+	   hexdigits=bits/4 };
 
 	//! Construct uninitialized
 	bigunsignedint ();
@@ -70,13 +93,9 @@ namespace Dune
 	bigunsignedint<k>& operator++ ();
 
 	//! divide
-        //! \warning This function is very slow and its usage should be
-        //! prevented if possible
 	bigunsignedint<k> operator/ (const bigunsignedint<k>& x) const;
 
 	//! modulo
-        //! \warning This function is very slow and its usage should be
-        //! prevented if possible
 	bigunsignedint<k> operator% (const bigunsignedint<k>& x) const;
 
 
@@ -129,26 +148,35 @@ namespace Dune
      */
     double todouble() const;
 
-	friend class bigunsignedint<k/2>;
     friend struct std::numeric_limits< bigunsignedint<k> >;
     
 #if HAVE_DUNE_HASH
 
     inline friend std::size_t hash_value(const bigunsignedint& arg)
     {
-      return hash_range(arg.digit,arg.digit + arg.n);
+      return hash_contiguous_range(arg.digit,arg.digit + arg.n);
     }
 
 #endif // HAVE_DUNE_HASH
 
   private:
-	unsigned short digit[n];
+    typedef BigUnsignedIntImpl::double_limb_type double_limb_type;
+
+	limb_type digit[n];
 #if HAVE_MPI
     friend struct MPITraits<bigunsignedint<k> >;
 #endif
     inline void assign(std::size_t x);
-    
-    
+
+    // -1, 0 or 1 if x is less than, equal to or greater than y
+    static int compare(const bigunsignedint<k>& x, const bigunsignedint<k>& y);
+
+    // q = u / v, returns u % v
+    static limb_type divmod(const bigunsignedint<k>& u, limb_type v, bigunsignedint<k>& q);
+
+    // q = u / v and r = u % v
+    static void divmod(const bigunsignedint<k>& u, const bigunsignedint<k>& v,
+                       bigunsignedint<k>& q, bigunsignedint<k>& r);
   } ;
 
   // Constructors
@@ -173,60 +201,45 @@ namespace Dune
   template<int k>
   void bigunsignedint<k>::assign(std::size_t x)
   {
-    int no=std::min(static_cast<int>(n),
-		    static_cast<int>(std::numeric_limits<std::size_t>::digits/bits));
-    
-    for(int i=0; i<no; ++i){
-	digit[i] = (x&bitmask);
-	x=x>>bits;
+    for (int i=0; i<n; ++i) {
+      digit[i] = static_cast<limb_type>(x);
+      // two steps, a single shift by the full width of x is undefined
+      x = (x>>(bits/2))>>(bits/2);
     }
-    for (unsigned int i=no; i<n; i++) digit[i]=0;
   }
 
   // export
   template<int k>
   inline unsigned int bigunsignedint<k>::touint () const
   {
-	return (digit[1]<<bits)+digit[0];
+	return static_cast<unsigned int>(digit[0]);
   }
 
   template<int k>
   inline double bigunsignedint<k>::todouble() const
   {
-    int firstInZeroRange=n;
-    for(int i=n-1; i>=0; --i)
-      if(digit[i]!=0)
-	break;
-      else
-	--firstInZeroRange;
-    int representableDigits=std::numeric_limits<double>::digits/bits;
-    int lastInRepresentableRange=0;
-    if(representableDigits<firstInZeroRange)
-      lastInRepresentableRange=firstInZeroRange-representableDigits;
     double val=0;
-    for(int i=firstInZeroRange-1; i>=lastInRepresentableRange; --i)
-      val =val*(1<<bits)+digit[i];
-    return val*(1<<(bits*lastInRepresentableRange));
+    for(int i=n-1; i>=0; --i)
+      val = std::ldexp(val, bits) + static_cast<double>(digit[i]);
+    return val;
   }
   // print
   template<int k>
   inline void bigunsignedint<k>::print (std::ostream& s) const
   {    
-	bool leading=false;
+	bool leading=true;
 
-	// print from left to right
+	// print from left to right, without leading zeros
 	for (int i=n-1; i>=0; i--)
 	  for (int d=hexdigits-1; d>=0; d--)
 		{
 		  // extract one hex digit
 		  int current = (digit[i]>>(d*4))&0xF;
-		  if (current!=0)
+		  if (current!=0 || !leading)
 			{
-			  //			  s.setf(std::ios::noshowbase);
 			  s << std::hex << current;
 			  leading = false;
 			}
-		  else if (!leading) s << std::hex << current;
 		}
 	if (leading) s << "0";
 	s << std::dec;
@@ -245,13 +258,14 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator+ (const bigunsignedint<k>& x) const
   {
 	bigunsignedint<k> result;
-	int overflow=0;
+	limb_type carry=0;
 
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  {
-		int sum = ((int)digit[i]) + ((int)x.digit[i]) + overflow;
-		result.digit[i] = sum&bitmask;
-		overflow = (sum>>bits)&overflowmask;
+		limb_type sum = digit[i] + carry;
+		carry = (sum < carry);
+		result.digit[i] = sum + x.digit[i];
+		carry += (result.digit[i] < sum);
 	  }
 	return result;
   }
@@ -260,18 +274,14 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator- (const bigunsignedint<k>& x) const
   {
 	bigunsignedint<k> result;
-	int overflow=0;
+	limb_type borrow=0;
 
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  {
-		int diff = ((int)digit[i]) - (((int)x.digit[i]) + overflow);
-		if (diff>=0)
-		  result.digit[i] = (unsigned short) diff;
-		else
-		  {
-			result.digit[i] = (unsigned short) (diff+bitmask);
-  			overflow = 1;
-		  }
+		limb_type diff = digit[i] - x.digit[i];
+		limb_type next = (digit[i] < x.digit[i]);
+		result.digit[i] = diff - borrow;
+		borrow = next | (diff < borrow);
 	  }
 	return result;
   }
@@ -279,73 +289,157 @@ namespace Dune
   template <int k>
   inline bigunsignedint<k> bigunsignedint<k>::operator* (const bigunsignedint<k>& x) const
   {
-	bigunsignedint<2*k> finalproduct(0);
+	bigunsignedint<k> result(0);
 
-	for (unsigned int m=0; m<n; m++) // digit in right factor
+	// schoolbook multiplication, dropping the limbs beyond n
+	for (int i=0; i<n; i++)
 	  {
-		bigunsignedint<2*k> singleproduct(0);
-		unsigned int overflow(0);
-		for (unsigned int i=0; i<n; i++) 
+		if (digit[i]==0)
+		  continue;
+		limb_type carry=0;
+		for (int j=0; i+j<n; j++)
 		  {
-			unsigned int digitproduct = ((unsigned int)digit[i])*((unsigned int)x.digit[m])+overflow;
-			singleproduct.digit[i+m] = (unsigned short) (digitproduct&bitmask);
-			overflow = (digitproduct>>bits)&bitmask;
+			double_limb_type t = static_cast<double_limb_type>(digit[i])*x.digit[j]
+			  + result.digit[i+j] + carry;
+			result.digit[i+j] = static_cast<limb_type>(t);
+			carry = static_cast<limb_type>(t>>bits);
 		  }
-		finalproduct = finalproduct+singleproduct;
 	  }
-
-	bigunsignedint<k> result;
-	for (unsigned int i=0; i<n; i++) result.digit[i] = finalproduct.digit[i];
 	return result;
   }
 
   template <int k>
   inline  bigunsignedint<k>& bigunsignedint<k>::operator++ ()
   {
-	int overflow=1;
-
-	for (unsigned int i=0; i<n; i++)
-	  {
-		int sum = ((int)digit[i]) + overflow;
-		digit[i] = sum&bitmask;
-		overflow = (sum>>bits)&overflowmask;
-	  }
+	for (int i=0; i<n; i++)
+	  if (++digit[i]!=0)
+		break;
 	return *this;
   }
 
   template <int k>
-  inline bigunsignedint<k> bigunsignedint<k>::operator/ (const bigunsignedint<k>& x) const
+  inline typename bigunsignedint<k>::limb_type
+  bigunsignedint<k>::divmod (const bigunsignedint<k>& u, limb_type v, bigunsignedint<k>& q)
   {
-    if(x==0)
-      DUNE_THROW(Dune::MathError, "division by zero!");
+	double_limb_type r=0;
+	for (int i=n-1; i>=0; i--)
+	  {
+		double_limb_type t = (r<<bits) | u.digit[i];
+		limb_type qi = static_cast<limb_type>(t/v);
+		q.digit[i] = qi;
+		r = t - static_cast<double_limb_type>(qi)*v;
+	  }
+	return static_cast<limb_type>(r);
+  }
 
-	// better slow than nothing
-	bigunsignedint<k> temp(*this);
-	bigunsignedint<k> result(0);
+  template <int k>
+  inline void bigunsignedint<k>::divmod (const bigunsignedint<k>& u, const bigunsignedint<k>& v,
+                                         bigunsignedint<k>& q, bigunsignedint<k>& r)
+  {
+	// number of significant limbs of the divisor and the dividend
+	int m=n;
+	while (m>0 && v.digit[m-1]==0) --m;
+	if (m==0)
+	  DUNE_THROW(Dune::MathError, "division by zero!");
+	if (m==1)
+	  {
+		r = bigunsignedint<k>(0);
+		r.digit[0] = divmod(u, v.digit[0], q);
+		return;
+	  }
+	int l=n;
+	while (l>0 && u.digit[l-1]==0) --l;
+	if (l<m)
+	  {
+		r = u;
+		q = bigunsignedint<k>(0);
+		return;
+	  }
 
-	while (temp>=x)
+	// Knuth, TAOCP Vol. 2, 4.3.1, Algorithm D: normalize such that the
+	// leading limb of the divisor has its highest bit set
+	int s=0;
+	for (limb_type top=v.digit[m-1]; !(top>>(bits-1)); top<<=1)
+	  ++s;
+	limb_type vn[n], un[n+1];
+	for (int i=m-1; i>0; i--)
+	  vn[i] = (v.digit[i]<<s) | (s ? v.digit[i-1]>>(bits-s) : 0);
+	vn[0] = v.digit[0]<<s;
+	un[l] = s ? u.digit[l-1]>>(bits-s) : 0;
+	for (int i=l-1; i>0; i--)
+	  un[i] = (u.digit[i]<<s) | (s ? u.digit[i-1]>>(bits-s) : 0);
+	un[0] = u.digit[0]<<s;
+
+	q = bigunsignedint<k>(0);
+	for (int j=l-m; j>=0; j--)
 	  {
-		++result;
-		temp = temp-x;
+		// estimate the quotient limb, it is at most two too large
+		double_limb_type num = (static_cast<double_limb_type>(un[j+m])<<bits) | un[j+m-1];
+		double_limb_type qhat = num/vn[m-1];
+		double_limb_type rhat = num - qhat*vn[m-1];
+		while ((qhat>>bits) != 0
+			   || qhat*vn[m-2] > ((rhat<<bits) | un[j+m-2]))
+		  {
+			--qhat;
+			rhat += vn[m-1];
+			if ((rhat>>bits) != 0)
+			  break;
+		  }
+
+		// subtract qhat times the divisor
+		limb_type carry=0, borrow=0;
+		for (int i=0; i<m; i++)
+		  {
+			double_limb_type p = qhat*vn[i] + carry;
+			carry = static_cast<limb_type>(p>>bits);
+			limb_type pl = static_cast<limb_type>(p);
+			limb_type diff = un[i+j] - pl;
+			limb_type next = (un[i+j] < pl);
+			un[i+j] = diff - borrow;
+			borrow = next | (diff < borrow);
+		  }
+		limb_type diff = un[j+m] - carry;
+		limb_type next = (un[j+m] < carry);
+		un[j+m] = diff - borrow;
+		borrow = next | (diff < borrow);
+
+		// the estimate was one too large, add the divisor back
+		if (borrow)
+		  {
+			--qhat;
+			limb_type c=0;
+			for (int i=0; i<m; i++)
+			  {
+				limb_type sum = un[i+j] + c;
+				c = (sum < c);
+				un[i+j] = sum + vn[i];
+				c += (un[i+j] < sum);
+			  }
+			un[j+m] += c;
+		  }
+		q.digit[j] = static_cast<limb_type>(qhat);
 	  }
 
-	return result;
+	// the remainder is the unnormalized rest of the dividend
+	r = bigunsignedint<k>(0);
+	for (int i=0; i<m; i++)
+	  r.digit[i] = (un[i]>>s) | (s ? un[i+1]<<(bits-s) : 0);
   }
 
   template <int k>
-  inline bigunsignedint<k> bigunsignedint<k>::operator% (const bigunsignedint<k>& x) const
+  inline bigunsignedint<k> bigunsignedint<k>::operator/ (const bigunsignedint<k>& x) const
   {
-	// better slow than nothing
-	bigunsignedint<k> temp(*this);
-	bigunsignedint<k> result(0);
-
-	while (temp>=x)
-	  {
-		++result;
-		temp = temp-x;
-	  }
+	bigunsignedint<k> quotient, remainder;
+	divmod(*this, x, quotient, remainder);
+	return quotient;
+  }
 
-	return temp;
+  template <int k>
+  inline bigunsignedint<k> bigunsignedint<k>::operator% (const bigunsignedint<k>& x) const
+  {
+	bigunsignedint<k> quotient, remainder;
+	divmod(*this, x, quotient, remainder);
+	return remainder;
   }
 
 
@@ -353,7 +447,7 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator& (const bigunsignedint<k>& x) const
   {
 	bigunsignedint<k> result;
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  result.digit[i] = digit[i]&x.digit[i];
 	return result;
   }
@@ -362,7 +456,7 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator^ (const bigunsignedint<k>& x) const
   {
 	bigunsignedint<k> result;
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  result.digit[i] = digit[i]^x.digit[i];
 	return result;
   }
@@ -371,7 +465,7 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator| (const bigunsignedint<k>& x) const
   {
 	bigunsignedint<k> result;
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  result.digit[i] = digit[i]|x.digit[i];
 	return result;
   }
@@ -380,7 +474,7 @@ namespace Dune
   inline bigunsignedint<k> bigunsignedint<k>::operator~ () const
   {
 	bigunsignedint<k> result;
-	for (unsigned int i=0; i<n; i++)
+	for (int i=0; i<n; i++)
 	  result.digit[i] = ~digit[i];
 	return result;
   }
@@ -390,22 +484,15 @@ namespace Dune
   {
 	bigunsignedint<k> result(0);
 
-	// multiples of bits
+	// whole limbs and the remaining bits
 	int j=shift/bits;
-	for (int i=n-1-j; i>=0; i--)
-	  result.digit[i+j] = digit[i];
-
-	// remainder
-	j=shift%bits;
-	for (int i=n-1; i>=0; i--)
+	int s=shift%bits;
+	for (int i=n-1; i>=j; i--)
 	  {
-		unsigned int temp = result.digit[i];
-		temp = temp<<j;
-		result.digit[i] = (unsigned short) (temp&bitmask);
-		temp = temp>>bits;
-		if (i+1<(int)n)
-		  result.digit[i+1] = result.digit[i+1]|temp;
-	  }	
+		result.digit[i] = digit[i-j]<<s;
+		if (s!=0 && i-j>0)
+		  result.digit[i] |= digit[i-j-1]>>(bits-s);
+	  }
 
 	return result;
   }
@@ -415,67 +502,70 @@ namespace Dune
   {
 	bigunsignedint<k> result(0);
 
-	// multiples of bits
+	// whole limbs and the remaining bits
 	int j=shift/bits;
-	for (unsigned int i=0; i<n-j; i++)
-	  result.digit[i] = digit[i+j];
-
-	// remainder
-	j=shift%bits;
-	for (unsigned int i=0; i<n; i++)
+	int s=shift%bits;
+	for (int i=0; i+j<n; i++)
 	  {
-		unsigned int temp = result.digit[i];
-		temp = temp<<(bits-j);
-		result.digit[i] = (unsigned short) ((temp&compbitmask)>>bits);
-		if (i>0)
-		  result.digit[i-1] = result.digit[i-1] | (temp&bitmask);
+		result.digit[i] = digit[i+j]>>s;
+		if (s!=0 && i+j+1<n)
+		  result.digit[i] |= digit[i+j+1]<<(bits-s);
 	  }
 
 	return result;
   }
 
+  template <int k>
+  inline int bigunsignedint<k>::compare (const bigunsignedint<k>& x, const bigunsignedint<k>& y)
+  {
+	// without early exit, a difference in a higher limb overrides
+	// the result for the lower ones
+	int result=0;
+	for (int i=0; i<n; i++)
+	  {
+		int d = int(x.digit[i]>y.digit[i]) - int(x.digit[i]<y.digit[i]);
+		result = d + int(d==0)*result;
+	  }
+	return result;
+  }
+
   template <int k>
   inline bool bigunsignedint<k>::operator!= (const bigunsignedint<k>& x) const
   {
-	for (unsigned int i=0; i<n; i++)
-	  if (digit[i]!=x.digit[i]) return true;
-	return false;
+	return !((*this)==x);
   }
 
   template <int k>
   inline bool bigunsignedint<k>::operator== (const bigunsignedint<k>& x) const
   {
-	return !((*this)!=x);
+	limb_type diff=0;
+	for (int i=0; i<n; i++)
+	  diff |= digit[i]^x.digit[i];
+	return diff==0;
   }
 
   template <int k>
   inline bool bigunsignedint<k>::operator< (const bigunsignedint<k>& x) const
   {
-	for (int i=n-1; i>=0; i--) 
-	  if (digit[i]<x.digit[i]) return true;
-	  else if (digit[i]>x.digit[i]) return false;
-	return false;
+	return compare(*this,x)<0;
   }
 
   template <int k>
   inline bool bigunsignedint<k>::operator<= (const bigunsignedint<k>& x) const
   {
-	for (int i=n-1; i>=0; i--) 
-	  if (digit[i]<x.digit[i]) return true;
-	  else if (digit[i]>x.digit[i]) return false;
-	return true;
+	return compare(*this,x)<=0;
   }
 
   template <int k>
   inline bool bigunsignedint<k>::operator> (const bigunsignedint<k>& x) const
   {
-	return !((*this)<=x);	
+	return compare(*this,x)>0;
   }
 
   template <int k>
   inline bool bigunsignedint<k>::operator>= (const bigunsignedint<k>& x) const
   {
-	return !((*this)<x);	
+	return compare(*this,x)>=0;
   }
 
 
@@ -570,7 +660,7 @@ namespace std
     {
       Dune::bigunsignedint<k> max_;
       for(std::size_t i=0; i < Dune::bigunsignedint<k>::n; ++i)
-        max_.digit[i]=std::numeric_limits<unsigned short>::max();
+        max_.digit[i]=std::numeric_limits<typename Dune::bigunsignedint<k>::limb_type>::max();
       return max_;
     }
     
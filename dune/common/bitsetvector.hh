@@ -5,10 +5,12 @@
     \brief Efficient implementation of a dynamic array of static arrays of booleans
 */
 
+#include <cassert>
 #include <vector>
 #include <bitset>
 #include <iostream>
 #include <algorithm>
+#include <stdint.h> // for uint64_t
 
 #include <dune/common/genericiterator.hh>
 #include <dune/common/exceptions.hh>
@@ -18,6 +20,64 @@ namespace Dune {
     template <int block_size, class Alloc> class BitSetVector;
     template <int block_size, class Alloc> class BitSetVectorReference;
 
+    /**
+       \brief A proxy class that acts as a mutable reference to a single
+       bit in a BitSetVector.
+
+       It stores the address of the word containing the bit together with
+       a mask selecting the bit inside this word.
+     */
+    class BitSetVectorBitReference
+    {
+    public:
+        //! The type of the words used to store the bits
+        typedef uint64_t word_type;
+
+        BitSetVectorBitReference(word_type& word, word_type mask) :
+            word(&word),
+            mask(mask)
+        {}
+
+        //! Return the value of the bit
+        operator bool() const
+        {
+            return (*word & mask) != 0;
+        }
+
+        //! Return the negated value of the bit
+        bool operator~() const
+        {
+            return (*word & mask) == 0;
+        }
+
+        //! Set the bit to b
+        BitSetVectorBitReference& operator=(bool b)
+        {
+            if (b)
+                *word |= mask;
+            else
+                *word &= ~mask;
+            return *this;
+        }
+
+        //! Assign the value of another bit, not the reference itself
+        BitSetVectorBitReference& operator=(const BitSetVectorBitReference& b)
+        {
+            return (*this) = bool(b);
+        }
+
+        //! Flip the bit
+        BitSetVectorBitReference& flip()
+        {
+            *word ^= mask;
+            return *this;
+        }
+
+    private:
+        word_type* word;
+        word_type mask;
+    };
+
     /**
        \brief A proxy class that acts as a const reference to a single
        bitset in a BitSetVector.
@@ -49,8 +109,8 @@ namespace Dune {
         typedef std::bitset<block_size> bitset;
 
         // bitset interface typedefs
-        typedef typename std::vector<bool, Alloc>::const_reference reference;
-        typedef typename std::vector<bool, Alloc>::const_reference const_reference;
+        typedef bool reference;
+        typedef bool const_reference;
         typedef size_t size_type;
         
         //! Returns a copy of *this shifted left by n bits.
@@ -221,9 +281,9 @@ namespace Dune {
         //! bitset interface typedefs
         //! \{
         //! A proxy class that acts as a reference to a single bit.
-        typedef typename std::vector<bool, Alloc>::reference reference;
-        //! A proxy class that acts as a const reference to a single bit.
-        typedef typename std::vector<bool, Alloc>::const_reference const_reference;
+        typedef BitSetVectorBitReference reference;
+        //! The value of a single bit.
+        typedef bool const_reference;
         //! \}
 
         //! size_type typedef (an unsigned integral type)
@@ -344,6 +404,9 @@ namespace Dune {
         //! Clears every bit.
         BitSetVectorReference& reset()
         {
+            for (size_type i=0; i<block_size; i++)
+                reset(i);
+            return *this;
         }
 
         //! Sets bit n if val is nonzero, and clears bit n if val is zero.
@@ -415,13 +478,31 @@ namespace Dune {
 
     /**
        \brief A dynamic %array of blocks of booleans
+
+       The bits are packed into 64 bit words. Bit j of block i is the
+       bit with the flat index k = i*block_size+j, which is stored as
+       bit k%64 of word k/64. Blocks are therefore contiguous and may
+       straddle word boundaries if block_size does not divide 64. Unused
+       bits of the last word are always kept cleared.
+
+       Operations acting on the whole vector (count(), any(), the bitwise
+       operators, flip(), ...) work on complete words.
     */
     template <int block_size, class Allocator=std::allocator<bool> >
-    class BitSetVector : private std::vector<bool, Allocator>
+    class BitSetVector
     {
-        /** \brief The implementation class: an unblocked bitfield */
+        /** \brief An unblocked bitfield, the former implementation class */
         typedef std::vector<bool, Allocator> BlocklessBaseClass;
-        
+
+    public:
+        /** \brief The type of the words used to store the bits */
+        typedef BitSetVectorBitReference::word_type word_type;
+
+    private:
+        typedef typename Allocator::template rebind<word_type>::other WordAllocator;
+
+        enum { bitsPerWord = 64 };
+
     public:
         //! container interface typedefs
         //! \{
@@ -448,6 +529,9 @@ namespace Dune {
         typedef Allocator allocator_type;
         //! \}
 
+        /** \brief Returned by findFirst() and findNext() if there is no set bit */
+        static const size_type npos = size_type(-1);
+
         //! iterators
         //! \{
         typedef Dune::GenericIterator<BitSetVector<block_size,Allocator>, value_type, reference, std::ptrdiff_t, ForwardIteratorFacade> iterator;
@@ -460,7 +544,7 @@ namespace Dune {
         }
 
         //! Returns a const_iterator pointing to the beginning of the vector.
-        const_iterator begin() const{    
+        const_iterator begin() const{
             return const_iterator(*this, 0);
         }
 
@@ -470,103 +554,209 @@ namespace Dune {
         }
 
         //! Returns a const_iterator pointing to the end of the vector.
-        const_iterator end() const{    
+        const_iterator end() const{
             return const_iterator(*this, size());
         }
-  
+
         //! Default constructor
         BitSetVector() :
-            BlocklessBaseClass()
+            blocks(0)
         {}
-        
+
         //! Construction from an unblocked bitfield
         BitSetVector(const BlocklessBaseClass& blocklessBitField) :
-            BlocklessBaseClass(blocklessBitField)
+            words(numWords(blocklessBitField.size()/block_size), word_type(0)),
+            blocks(blocklessBitField.size()/block_size)
         {
             if (blocklessBitField.size()%block_size != 0)
                 DUNE_THROW(RangeError, "Vector size is not a multiple of the block size!");
+            for (size_type k=0; k<blocklessBitField.size(); ++k)
+                if (blocklessBitField[k])
+                    words[k/bitsPerWord] |= bitMask(k);
         }
-        
+
         /** Constructor with a given length
             \param n Number of blocks
         */
         explicit BitSetVector(int n) :
-            BlocklessBaseClass(n*block_size)
+            words(numWords(n), word_type(0)),
+            blocks(n)
         {}
-        
+
         //! Constructor which initializes the field with true or false
         BitSetVector(int n, bool v) :
-            BlocklessBaseClass(n*block_size,v)
-        {}
+            words(numWords(n), v ? ~word_type(0) : word_type(0)),
+            blocks(n)
+        {
+            clearUnusedBits();
+        }
 
         //! Erases all of the elements.
         void clear()
         {
-            BlocklessBaseClass::clear();
+            words.clear();
+            blocks = 0;
         }
-        
+
         //! Resize field
         void resize(int n, bool v = bool())
         {
-            BlocklessBaseClass::resize(n*block_size, v);
+            size_type oldBits = numBits();
+            words.resize(numWords(n), v ? ~word_type(0) : word_type(0));
+            blocks = n;
+            // set the new bits in the formerly last word
+            if (v && oldBits < numBits() && oldBits%bitsPerWord != 0)
+                words[oldBits/bitsPerWord] |= ~word_type(0) << (oldBits%bitsPerWord);
+            clearUnusedBits();
         }
-        
+
         /** \brief Return the number of blocks */
         size_type size() const
         {
-            return BlocklessBaseClass::size()/block_size;
+            return blocks;
         }
-        
+
         //! Sets all entries to <tt> true </tt>
         void setAll() {
-            this->assign(BlocklessBaseClass::size(), true);
+            std::fill(words.begin(), words.end(), ~word_type(0));
+            clearUnusedBits();
         }
-        
+
         //! Sets all entries to <tt> false </tt>
         void unsetAll() {
-            this->assign(BlocklessBaseClass::size(), false);
+            std::fill(words.begin(), words.end(), word_type(0));
         }
-        
+
         /** \brief Return reference to i-th block */
         reference operator[](int i)
         {
             return reference(*this, i);
         }
-        
+
         /** \brief Return const reference to i-th block */
         const_reference operator[](int i) const
         {
             return const_reference(*this, i);
         }
-        
+
         /** \brief Return reference to last block */
         reference back()
         {
             return reference(*this, size()-1);
         }
-        
+
         /** \brief Return const reference to last block */
         const_reference back() const
         {
             return const_reference(*this, size()-1);
         }
-        
+
         //! Returns the number of bits that are set.
         size_type count() const
         {
-            return std::count(BlocklessBaseClass::begin(), BlocklessBaseClass::end(), true);
+            size_type n = 0;
+            for (size_type w=0; w<words.size(); ++w)
+                n += popcount(words[w]);
+            return n;
         }
-        
+
         //! Returns the number of set bits, while each block is masked with 1<<i
         size_type countmasked(int j) const
         {
             size_type n = 0;
-            size_type blocks = size();
-            for(size_type i=0; i<blocks; ++i)
+            if (bitsPerWord % block_size == 0)
+            {
+                // blocks do not straddle words, so bit j of every block
+                // sits at the same positions in each word
+                word_type pattern = 0;
+                for (size_type k=j; k<size_type(bitsPerWord); k+=block_size)
+                    pattern |= word_type(1) << k;
+                for (size_type w=0; w<words.size(); ++w)
+                    n += popcount(words[w] & pattern);
+                return n;
+            }
+            for(size_type i=0; i<size(); ++i)
                 n += getBit(i,j);
             return n;
         }
-        
+
+        //! Returns true if any bit is set.
+        bool any() const
+        {
+            for (size_type w=0; w<words.size(); ++w)
+                if (words[w])
+                    return true;
+            return false;
+        }
+
+        //! Returns true if no bit is set.
+        bool none() const
+        {
+            return ! any();
+        }
+
+        //! Bitwise and with a vector of the same size
+        BitSetVector& operator&=(const BitSetVector& x)
+        {
+            assert(size() == x.size());
+            for (size_type w=0; w<words.size(); ++w)
+                words[w] &= x.words[w];
+            return *this;
+        }
+
+        //! Bitwise inclusive or with a vector of the same size
+        BitSetVector& operator|=(const BitSetVector& x)
+        {
+            assert(size() == x.size());
+            for (size_type w=0; w<words.size(); ++w)
+                words[w] |= x.words[w];
+            return *this;
+        }
+
+        //! Bitwise exclusive or with a vector of the same size
+        BitSetVector& operator^=(const BitSetVector& x)
+        {
+            assert(size() == x.size());
+            for (size_type w=0; w<words.size(); ++w)
+                words[w] ^= x.words[w];
+            return *this;
+        }
+
+        //! Flips the value of every bit.
+        BitSetVector& flip()
+        {
+            for (size_type w=0; w<words.size(); ++w)
+                words[w] = ~words[w];
+            clearUnusedBits();
+            return *this;
+        }
+
+        /** \brief Return the flat index of the first set bit
+
+            The flat index of bit j in block i is i*block_size+j.
+
+            \return the flat index or npos if no bit is set
+        */
+        size_type findFirst() const
+        {
+            return findFrom(0);
+        }
+
+        /** \brief Return the flat index of the first set bit after position k
+
+            Together with findFirst() this allows to iterate over all set bits:
+            \code
+            for (size_t k = v.findFirst(); k != v.npos; k = v.findNext(k))
+                doSomething(k / block_size, k % block_size);
+            \endcode
+
+            \return the flat index or npos if no further bit is set
+        */
+        size_type findNext(size_type k) const
+        {
+            return findFrom(k+1);
+        }
+
         //! Send bitfield to an output stream
         friend std::ostream& operator<< (std::ostream& s, const BitSetVector& v)
         {
@@ -577,6 +767,70 @@ namespace Dune {
 
     private:
 
+        //! number of words needed for n blocks
+        static size_type numWords(size_type n)
+        {
+            return (n*block_size + bitsPerWord - 1) / bitsPerWord;
+        }
+
+        //! number of bits in use
+        size_type numBits() const
+        {
+            return blocks*block_size;
+        }
+
+        //! mask of the bit with flat index k inside its word
+        static word_type bitMask(size_type k)
+        {
+            return word_type(1) << (k%bitsPerWord);
+        }
+
+        //! clear the bits of the last word which do not belong to any block
+        void clearUnusedBits()
+        {
+            size_type rest = numBits() % bitsPerWord;
+            if (rest != 0)
+                words.back() &= (word_type(1) << rest) - 1;
+        }
+
+        static size_type popcount(word_type w)
+        {
+#if defined(__GNUC__)
+            return __builtin_popcountll(w);
+#else
+            w = w - ((w >> 1) & 0x5555555555555555ULL);
+            w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+            w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return (w * 0x0101010101010101ULL) >> 56;
+#endif
+        }
+
+        //! index of the lowest set bit, w must not be zero
+        static size_type lowestBit(word_type w)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzll(w);
+#else
+            return popcount((w & (~w + 1)) - 1);
+#endif
+        }
+
+        //! flat index of the first set bit at position k or behind
+        size_type findFrom(size_type k) const
+        {
+            if (k >= numBits())
+                return npos;
+            size_type w = k/bitsPerWord;
+            word_type bits = words[w] & (~word_type(0) << (k%bitsPerWord));
+            while (bits == 0)
+            {
+                if (++w == words.size())
+                    return npos;
+                bits = words[w];
+            }
+            return w*bitsPerWord + lowestBit(bits);
+        }
+
         // get a prepresentation as value_type
         value_type getRepr(int i) const
         {
@@ -585,19 +839,27 @@ namespace Dune {
                 bits.set(j, getBit(i,j));
             return bits;
         }
-        
-        typename std::vector<bool>::reference getBit(size_type i, size_type j) {
-            return BlocklessBaseClass::operator[](i*block_size+j);
+
+        BitSetVectorBitReference getBit(size_type i, size_type j) {
+            size_type k = i*block_size+j;
+            return BitSetVectorBitReference(words[k/bitsPerWord], bitMask(k));
         }
-        
-        typename std::vector<bool>::const_reference getBit(size_type i, size_type j) const {
-            return BlocklessBaseClass::operator[](i*block_size+j);
+
+        bool getBit(size_type i, size_type j) const {
+            size_type k = i*block_size+j;
+            return (words[k/bitsPerWord] & bitMask(k)) != 0;
         }
-        
+
+        std::vector<word_type, WordAllocator> words;
+        size_type blocks;
+
         friend class BitSetVectorReference<block_size,Allocator>;
         friend class BitSetVectorConstReference<block_size,Allocator>;
     };
 
+    template <int block_size, class Allocator>
+    const typename BitSetVector<block_size,Allocator>::size_type BitSetVector<block_size,Allocator>::npos;
+
 }  // namespace Dune
 
 #endif
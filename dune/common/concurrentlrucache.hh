@@ -0,0 +1,429 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=8 sw=4 sts=4:
+#ifndef DUNE_COMMON_CONCURRENTLRUCACHE_HH
+#define DUNE_COMMON_CONCURRENTLRUCACHE_HH
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#if HAVE_STD_THREAD
+#include <mutex>
+#endif
+
+#include <dune/common/hash.hh>
+#include <dune/common/lrucache.hh>
+
+/** @file
+    @brief Thread safe cache with sharded locking and CLOCK eviction
+*/
+
+namespace Dune {
+
+#if HAVE_STD_THREAD || DOXYGEN
+
+/**
+    @brief Thread safe cache with approximate LRU eviction
+
+    The keys are distributed over a number of shards, each guarded by
+    its own mutex, so threads accessing different shards never contend.
+    Inside a shard the entries live in a fixed size table which is
+    indexed by an open addressing hash table.
+
+    Instead of maintaining an exact recency list, which would turn every
+    lookup into a list modification, each entry carries a reference
+    bit that is set on access. When a full shard needs room, a clock
+    hand sweeps over the entries, clearing set reference bits and
+    evicting the first entry whose bit is already clear (CLOCK
+    algorithm).
+
+    As references to cached data could be invalidated by other threads
+    at any time, find() copies the data out.
+
+    @tparam _Key   The key type, has to be hashable by _Hash.
+    @tparam _Tp    The data type, has to be default constructible
+                   and copy assignable.
+    @tparam _Evict Functor called as evict(key, data) for every entry
+                   that is evicted automatically. It is called while the
+                   lock of the shard is held.
+    @tparam _Hash  Hash functor for the keys.
+    @tparam _Equal Equality comparison for the keys.
+
+    @note This class is only available if HAVE_STD_THREAD is set.
+ */
+template <typename _Key, typename _Tp,
+          typename _Evict = LRUCacheNoEviction<_Key, _Tp>,
+          typename _Hash = Dune::hash<_Key>,
+          typename _Equal = std::equal_to<_Key> >
+class ConcurrentLRUCache
+{
+    typedef std::size_t index_type;
+
+    struct Entry
+    {
+        std::pair<_Key, _Tp> data;
+        std::size_t hash;
+        bool referenced;
+        bool occupied;
+    };
+
+    struct Shard
+    {
+        Shard () : hand(0), size(0), hits(0), misses(0), evictions(0) {}
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        std::vector<index_type> slots;
+        std::vector<index_type> free;
+        index_type hand;
+        std::size_t size;
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t evictions;
+    };
+
+public:
+    typedef _Key                 key_type;
+    typedef _Tp                  value_type;
+    typedef std::size_t          size_type;
+    typedef _Evict               eviction_handler;
+
+    /**
+     * @brief Construct an empty cache
+     *
+     * @param capacity maximal number of entries, has to be positive
+     * @param shards   number of independently locked shards
+     * @param evict    handler called for automatically evicted entries
+     */
+    explicit ConcurrentLRUCache (size_type capacity, size_type shards = 16,
+                                 const eviction_handler & evict = eviction_handler(),
+                                 const _Hash & hash = _Hash(), const _Equal & equal = _Equal()) :
+        _shards(shards > 0 ? shards : 1),
+        _evict(evict), _hash(hash), _equal(equal)
+    {
+        assert(capacity > 0);
+        _shardCapacity = (capacity + _shards.size() - 1) / _shards.size();
+        std::size_t slots = 16;
+        while (slots < 2 * _shardCapacity)
+            slots *= 2;
+        for (std::size_t i = 0; i < _shards.size(); ++i)
+        {
+            Shard & shard = _shards[i];
+            Entry empty;
+            empty.hash = 0;
+            empty.referenced = false;
+            empty.occupied = false;
+            shard.entries.assign(_shardCapacity, empty);
+            shard.slots.assign(slots, npos());
+            shard.free.reserve(_shardCapacity);
+            for (index_type e = _shardCapacity; e > 0; --e)
+                shard.free.push_back(e - 1);
+        }
+    }
+
+    /**
+     * @brief Look up the data for key
+     *
+     * On success the entry is marked as recently used. The lookup is
+     * counted as hit or miss.
+     *
+     * @param key  the key to look for
+     * @param data set to a copy of the cached data if key is found
+     * @return true if key was found
+     */
+    bool find (const key_type & key, value_type & data)
+    {
+        std::size_t h = _hash(key);
+        Shard & shard = shardFor(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        index_type slot = findSlot(shard, key, h);
+        if (slot == npos())
+        {
+            ++shard.misses;
+            return false;
+        }
+        ++shard.hits;
+        Entry & entry = shard.entries[shard.slots[slot]];
+        entry.referenced = true;
+        data = entry.data.second;
+        return true;
+    }
+
+    /**
+     * @brief Check whether key is cached without changing any state
+     */
+    bool contains (const key_type & key)
+    {
+        std::size_t h = _hash(key);
+        Shard & shard = shardFor(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return findSlot(shard, key, h) != npos();
+    }
+
+    /**
+     * @brief mark data associated with key as recently used
+     *
+     * @return true if key was found
+     */
+    bool touch (const key_type & key)
+    {
+        std::size_t h = _hash(key);
+        Shard & shard = shardFor(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        index_type slot = findSlot(shard, key, h);
+        if (slot == npos())
+            return false;
+        shard.entries[shard.slots[slot]].referenced = true;
+        return true;
+    }
+
+    /**
+     * @brief Insert a value into the container
+     *
+     * Stores data under key and marks it as recently used. If the key
+     * is already present its data is replaced. If the shard of the key
+     * is full, an entry is evicted according to the CLOCK algorithm.
+     *
+     * @param key   associated with data
+     * @param data  to store
+     */
+    void insert (const key_type & key, const value_type & data)
+    {
+        std::size_t h = _hash(key);
+        Shard & shard = shardFor(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        index_type slot = findSlot(shard, key, h);
+        if (slot != npos())
+        {
+            Entry & entry = shard.entries[shard.slots[slot]];
+            entry.data.second = data;
+            entry.referenced = true;
+            return;
+        }
+        if (shard.free.empty())
+            evictOne(shard);
+        index_type e = shard.free.back();
+        shard.free.pop_back();
+        Entry & entry = shard.entries[e];
+        entry.data.first = key;
+        entry.data.second = data;
+        entry.hash = h;
+        entry.referenced = true;
+        entry.occupied = true;
+        insertSlot(shard, e);
+        ++shard.size;
+    }
+
+    /**
+     * @brief Remove the element with the given key
+     *
+     * The eviction handler is not called.
+     *
+     * @return true if an element was removed
+     */
+    bool erase (const key_type & key)
+    {
+        std::size_t h = _hash(key);
+        Shard & shard = shardFor(h);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        index_type slot = findSlot(shard, key, h);
+        if (slot == npos())
+            return false;
+        remove(shard, slot);
+        return true;
+    }
+
+    /**
+     * @brief Remove all entries
+     *
+     * The eviction handler is not called.
+     */
+    void clear ()
+    {
+        for (std::size_t i = 0; i < _shards.size(); ++i)
+        {
+            Shard & shard = _shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (std::size_t s = 0; s < shard.slots.size(); ++s)
+                if (shard.slots[s] != npos())
+                    release(shard, shard.slots[s]);
+            shard.slots.assign(shard.slots.size(), npos());
+        }
+    }
+
+    /**
+     * @brief the number of cached entries
+     *
+     * The result is only a snapshot if other threads modify the cache.
+     */
+    size_type size () const
+    {
+        return sum(&Shard::size);
+    }
+
+    /** @brief maximal number of entries */
+    size_type capacity () const
+    {
+        return _shardCapacity * _shards.size();
+    }
+
+    /** @brief number of shards */
+    size_type shards () const
+    {
+        return _shards.size();
+    }
+
+    /** @brief number of successful lookups */
+    std::size_t hits () const
+    {
+        return sum(&Shard::hits);
+    }
+
+    /** @brief number of failed lookups */
+    std::size_t misses () const
+    {
+        return sum(&Shard::misses);
+    }
+
+    /** @brief number of automatically evicted entries */
+    std::size_t evictions () const
+    {
+        return sum(&Shard::evictions);
+    }
+
+    /** @brief reset the hit, miss and eviction counters */
+    void resetStatistics ()
+    {
+        for (std::size_t i = 0; i < _shards.size(); ++i)
+        {
+            std::lock_guard<std::mutex> lock(_shards[i].mutex);
+            _shards[i].hits = _shards[i].misses = _shards[i].evictions = 0;
+        }
+    }
+
+private:
+    // not copyable
+    ConcurrentLRUCache (const ConcurrentLRUCache &);
+    ConcurrentLRUCache & operator= (const ConcurrentLRUCache &);
+
+    static index_type npos ()
+    {
+        return index_type(-1);
+    }
+
+    /** @brief sum up a counter over all shards */
+    std::size_t sum (std::size_t Shard::* counter) const
+    {
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < _shards.size(); ++i)
+        {
+            std::lock_guard<std::mutex> lock(_shards[i].mutex);
+            s += _shards[i].*counter;
+        }
+        return s;
+    }
+
+    /** @brief select the shard by the upper bits of the mixed hash */
+    Shard & shardFor (std::size_t h)
+    {
+        // Fibonacci hashing decorrelates the shard index from the
+        // lower bits that are used inside the shard
+        std::size_t mixed = h * std::size_t(0x9e3779b97f4a7c15ULL);
+        return _shards[(mixed >> (sizeof(std::size_t) * 4)) % _shards.size()];
+    }
+
+    index_type findSlot (const Shard & shard, const key_type & key, std::size_t h) const
+    {
+        const std::size_t mask = shard.slots.size() - 1;
+        for (std::size_t i = h & mask; ; i = (i + 1) & mask)
+        {
+            index_type e = shard.slots[i];
+            if (e == npos())
+                return npos();
+            if (shard.entries[e].hash == h && _equal(shard.entries[e].data.first, key))
+                return i;
+        }
+    }
+
+    void insertSlot (Shard & shard, index_type e)
+    {
+        const std::size_t mask = shard.slots.size() - 1;
+        std::size_t i = shard.entries[e].hash & mask;
+        while (shard.slots[i] != npos())
+            i = (i + 1) & mask;
+        shard.slots[i] = e;
+    }
+
+    /** @brief remove slot i using backward shift deletion */
+    void eraseSlot (Shard & shard, std::size_t i)
+    {
+        const std::size_t mask = shard.slots.size() - 1;
+        shard.slots[i] = npos();
+        for (std::size_t j = (i + 1) & mask; shard.slots[j] != npos(); j = (j + 1) & mask)
+        {
+            std::size_t ideal = shard.entries[shard.slots[j]].hash & mask;
+            // move the entry back unless its ideal slot lies cyclically in (i,j]
+            bool keep = (i <= j) ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!keep)
+            {
+                shard.slots[i] = shard.slots[j];
+                shard.slots[j] = npos();
+                i = j;
+            }
+        }
+    }
+
+    /** @brief free the entry e, without touching the hash index */
+    void release (Shard & shard, index_type e)
+    {
+        Entry & entry = shard.entries[e];
+        // release resources held by the data
+        entry.data.second = _Tp();
+        entry.occupied = false;
+        entry.referenced = false;
+        shard.free.push_back(e);
+        --shard.size;
+    }
+
+    void remove (Shard & shard, std::size_t slot)
+    {
+        index_type e = shard.slots[slot];
+        eraseSlot(shard, slot);
+        release(shard, e);
+    }
+
+    /** @brief advance the clock hand until an unreferenced entry is found and evict it */
+    void evictOne (Shard & shard)
+    {
+        for (;;)
+        {
+            Entry & entry = shard.entries[shard.hand];
+            shard.hand = (shard.hand + 1) % shard.entries.size();
+            if (!entry.occupied)
+                continue;
+            if (entry.referenced)
+            {
+                entry.referenced = false;
+                continue;
+            }
+            _evict(entry.data.first, entry.data.second);
+            ++shard.evictions;
+            remove(shard, findSlot(shard, entry.data.first, entry.hash));
+            return;
+        }
+    }
+
+    std::vector<Shard> _shards;
+    size_type _shardCapacity;
+    eviction_handler _evict;
+    _Hash _hash;
+    _Equal _equal;
+};
+
+#endif // HAVE_STD_THREAD || DOXYGEN
+
+} // namespace Dune
+
+#endif // DUNE_COMMON_CONCURRENTLRUCACHE_HH
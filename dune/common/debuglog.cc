@@ -0,0 +1,319 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+#if HAVE_STD_THREAD
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#endif
+
+#include <dune/common/debuglog.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/timer.hh>
+
+namespace Dune {
+
+  namespace {
+
+    // every log gets a serial number, so the cache below can tell
+    // logs apart even if one is allocated where another one was
+#if HAVE_STD_THREAD
+    std::atomic<unsigned long> serials(0);
+#else
+    unsigned long serials = 0;
+#endif
+
+    // the log and buffer the calling thread wrote to last
+#if HAVE_STD_THREAD && defined(__GNUC__)
+    __thread unsigned long cachedSerial = 0;
+    __thread void* cachedBuffer = 0;
+#elif HAVE_STD_THREAD
+    thread_local unsigned long cachedSerial = 0;
+    thread_local void* cachedBuffer = 0;
+#else
+    unsigned long cachedSerial = 0;
+    void* cachedBuffer = 0;
+#endif
+
+  } // end anonymous namespace
+
+  // formats the output of one thread into the unused part of data_
+  class DebugLog::Buffer : public std::streambuf
+  {
+  public:
+    Buffer (DebugLog& log, int thread)
+      : log_(log), thread_(thread), data_(4096), stream_(this)
+    {
+      setp(&data_[0], &data_[0] + data_.size());
+    }
+
+    int thread () const
+    {
+      return thread_;
+    }
+
+    std::ostream& stream ()
+    {
+      return stream_;
+    }
+
+    // hands the complete lines over to the log, or everything if all is set
+    void post (bool all)
+    {
+      char* end = pptr();
+      if (!all)
+        while (end != pbase() && end[-1] != '\n')
+          --end;
+      if (end == pbase())
+        return;
+      log_.post(*this, pbase(), end);
+
+      // move the incomplete line to the front
+      const int rest = pptr() - end;
+      std::copy(end, pptr(), pbase());
+      setp(pbase(), epptr());
+      pbump(rest);
+    }
+
+  protected:
+    int_type overflow (int_type c)
+    {
+      post(false);
+      if (pptr() == epptr()) {
+        // a single line longer than the buffer
+        const int used = pptr() - pbase();
+        data_.resize(2 * data_.size());
+        setp(&data_[0], &data_[0] + data_.size());
+        pbump(used);
+      }
+      if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+      }
+      return traits_type::not_eof(c);
+    }
+
+    int sync ()
+    {
+      post(false);
+      return 0;
+    }
+
+  private:
+    DebugLog& log_;
+    int thread_;
+    std::vector<char> data_;
+    std::ostream stream_;
+  };
+
+  struct DebugLog::Shared
+  {
+    unsigned long serial;
+    TimerClocks::WallTime::time_point start;
+    std::vector<Buffer*> buffers;
+#if HAVE_STD_THREAD
+    // writes the queue to target until stop is set
+    void run (std::ostream* target)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        if (!urgent)
+          wake.wait_for(lock, std::chrono::milliseconds(100));
+        urgent = false;
+        if (!queue.empty()) {
+          std::string batch;
+          batch.swap(queue);
+          writing = true;
+          lock.unlock();
+          target->write(batch.data(), batch.size());
+          target->flush();
+          lock.lock();
+          writing = false;
+        }
+        written.notify_all();
+        if (stop && queue.empty())
+          return;
+      }
+    }
+
+    std::map<std::thread::id, Buffer*> threads;
+    // prefixed lines waiting for the writer
+    std::string queue;
+    bool writing, urgent, stop;
+    std::mutex mutex;
+    std::condition_variable wake, written;
+    std::thread writer;
+#endif
+  };
+
+  DebugLog::DebugLog (std::ostream& target, int rank, int prefix)
+    : target_(&target), file_(0), rank_(rank), prefix_(prefix),
+      batchSize_(1 << 14), shared_(0)
+  {
+    init();
+  }
+
+  DebugLog::DebugLog (const std::string& basename, int rank, int prefix)
+    : target_(0), file_(0), rank_(rank), prefix_(prefix),
+      batchSize_(1 << 14), shared_(0)
+  {
+    std::ostringstream name;
+    name << basename << '.' << rank << ".log";
+    std::ofstream* file = new std::ofstream(name.str().c_str());
+    if (!*file) {
+      delete file;
+      DUNE_THROW(IOError, "Could not open " << name.str() << " for writing");
+    }
+    target_ = file_ = file;
+    init();
+  }
+
+  void DebugLog::init ()
+  {
+    shared_ = new Shared;
+    shared_->serial = ++serials;
+    shared_->start = TimerClocks::WallTime::now();
+#if HAVE_STD_THREAD
+    shared_->writing = shared_->urgent = shared_->stop = false;
+    shared_->writer = std::thread(&Shared::run, shared_, target_);
+#endif
+  }
+
+  DebugLog::~DebugLog ()
+  {
+    for (std::size_t i=0; i<shared_->buffers.size(); ++i)
+      shared_->buffers[i]->post(true);
+#if HAVE_STD_THREAD
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      shared_->stop = shared_->urgent = true;
+    }
+    shared_->wake.notify_one();
+    shared_->writer.join();
+#endif
+    target_->flush();
+
+    for (std::size_t i=0; i<shared_->buffers.size(); ++i)
+      delete shared_->buffers[i];
+    delete shared_;
+    delete file_;
+  }
+
+  std::ostream& DebugLog::stream ()
+  {
+    if (cachedSerial == shared_->serial)
+      return static_cast<Buffer*>(cachedBuffer)->stream();
+
+    Buffer* buffer;
+#if HAVE_STD_THREAD
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      Buffer*& b = shared_->threads[std::this_thread::get_id()];
+      if (b == 0) {
+        b = new Buffer(*this, shared_->buffers.size());
+        shared_->buffers.push_back(b);
+      }
+      buffer = b;
+    }
+#else
+    if (shared_->buffers.empty())
+      shared_->buffers.push_back(new Buffer(*this, 0));
+    buffer = shared_->buffers[0];
+#endif
+    cachedSerial = shared_->serial;
+    cachedBuffer = buffer;
+    return buffer->stream();
+  }
+
+  void DebugLog::flush ()
+  {
+    stream().flush();
+#if HAVE_STD_THREAD
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->urgent = true;
+    shared_->wake.notify_one();
+    while (!shared_->queue.empty() || shared_->writing)
+      shared_->written.wait(lock);
+#else
+    target_->flush();
+#endif
+  }
+
+  std::size_t DebugLog::batchSize () const
+  {
+#if HAVE_STD_THREAD
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+#endif
+    return batchSize_;
+  }
+
+  void DebugLog::setBatchSize (std::size_t bytes)
+  {
+#if HAVE_STD_THREAD
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+#endif
+    batchSize_ = bytes;
+  }
+
+  void DebugLog::post (const Buffer& buffer, const char* begin, const char* end)
+  {
+    char prefix[96];
+    int length = 0;
+    const char* separator = "[";
+    if (prefix_ & rankPrefix) {
+      length += snprintf(prefix + length, sizeof(prefix) - length, "%sr%d", separator, rank_);
+      separator = "|";
+    }
+    if (prefix_ & threadPrefix) {
+      length += snprintf(prefix + length, sizeof(prefix) - length, "%st%d", separator, buffer.thread());
+      separator = "|";
+    }
+    if (prefix_ & timePrefix)
+      length += snprintf(prefix + length, sizeof(prefix) - length, "%s%.6fs", separator,
+                         TimerClocks::WallTime::seconds(shared_->start, TimerClocks::WallTime::now()));
+    if (length > 0)
+      length += snprintf(prefix + length, sizeof(prefix) - length, "] ");
+
+    std::string lines;
+    lines.reserve(end - begin + 16 * length);
+    for (const char* line = begin; line != end; ) {
+      const char* next = std::find(line, end, '\n');
+      lines.append(prefix, length);
+      if (next == end) {
+        // an incomplete line left at destruction
+        lines.append(line, end);
+        lines += '\n';
+        break;
+      }
+      lines.append(line, ++next);
+      line = next;
+    }
+
+#if HAVE_STD_THREAD
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    shared_->queue += lines;
+    if (shared_->queue.size() >= batchSize_ && !shared_->urgent) {
+      shared_->urgent = true;
+      shared_->wake.notify_one();
+    }
+#else
+    target_->write(lines.data(), lines.size());
+#endif
+  }
+
+} // end namespace Dune
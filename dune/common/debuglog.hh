@@ -0,0 +1,122 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_COMMON_DEBUGLOG_HH
+#define DUNE_COMMON_DEBUGLOG_HH
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include <dune/common/debugstream.hh>
+
+/** @file
+    @brief Buffered and thread safe output target for DebugStream
+*/
+
+namespace Dune {
+
+  /** @addtogroup DebugOut
+      @{
+  */
+
+  /**
+     @brief Buffered and thread safe output target for DebugStream
+
+     Every thread writing to the log gets its own std::ostream, which
+     formats into a private buffer. Complete lines are handed over to
+     the log when the stream is flushed, e.g. by std::endl, or when the
+     buffer runs full. Each line is prefixed with the rank of the
+     process, a number identifying the thread and the wall time since
+     the construction of the log, for example
+
+     @code
+     [r3|t1|0.012345s] 3: sending 40 to 2
+     @endcode
+
+     and lines of different threads never interleave. A background
+     thread writes the lines in batches of at least batchSize() bytes,
+     or after at most 100 ms, to the target stream. Without
+     HAVE_STD_THREAD the lines are written immediately.
+
+     The log is attached to a DebugStream with
+     DebugStream::attach(DebugSink&), or written to directly through
+     stream().
+
+     @note All threads have to stop writing before the log is
+     destroyed. The destructor writes what is left, including
+     incomplete lines.
+  */
+  class DebugLog : public DebugSink
+  {
+  public:
+    //! Bit flags selecting the parts of the line prefix
+    enum Prefix {
+      noPrefix = 0,
+      //! The rank given to the constructor
+      rankPrefix = 1,
+      //! The number of the thread, in the order of their first output
+      threadPrefix = 2,
+      //! The wall time since construction in seconds
+      timePrefix = 4,
+      allPrefixes = rankPrefix | threadPrefix | timePrefix
+    };
+
+    /**
+       @brief Log to a stream
+
+       @param target The stream to write to, it has to outlive the log.
+       @param rank The rank to put into the prefix.
+       @param prefix The parts of the prefix, a combination of Prefix flags.
+    */
+    explicit DebugLog (std::ostream& target, int rank = 0, int prefix = allPrefixes);
+
+    /**
+       @brief Log to the file basename.rank.log
+
+       @throw IOError if the file cannot be opened.
+    */
+    DebugLog (const std::string& basename, int rank, int prefix = allPrefixes);
+
+    //! Write all remaining output and stop the background thread
+    ~DebugLog ();
+
+    //! The stream of the calling thread
+    std::ostream& stream ();
+
+    /**
+       @brief Hand over the complete lines of the calling thread and
+       wait until all lines handed over so far are written
+    */
+    void flush ();
+
+    //! The number of bytes which wakes up the background thread
+    std::size_t batchSize () const;
+
+    //! Set the number of bytes which wakes up the background thread
+    void setBatchSize (std::size_t bytes);
+
+  private:
+    class Buffer;
+    struct Shared;
+
+    DebugLog (const DebugLog&);
+    DebugLog& operator= (const DebugLog&);
+
+    void init ();
+
+    // prefixes the lines in [begin,end) and queues them for writing
+    void post (const Buffer& buffer, const char* begin, const char* end);
+
+    std::ostream* target_;
+    std::ostream* file_;
+    int rank_;
+    int prefix_;
+    std::size_t batchSize_;
+    Shared* shared_;
+  };
+
+  /** @} */
+
+} // namespace Dune
+
+#endif // DUNE_COMMON_DEBUGLOG_HH
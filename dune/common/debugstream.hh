@@ -93,6 +93,19 @@ namespace Dune {
 
   Dune::dwarn.attach(mylog);
   \endcode
+
+  Output from several threads or processes is best attached to a
+  DebugLog, which buffers the output of every thread, prefixes each
+  line with rank, thread and time and writes the lines in batches from
+  a background thread:
+
+  \code
+  Dune::DebugLog log("application", helper.rank());
+
+  Dune::dverb.attach(log);
+  // ... output goes to application.<rank>.log ...
+  Dune::dverb.detach();
+  \endcode
   */
   /**
      \addtogroup DebugOut
@@ -144,10 +157,33 @@ namespace Dune {
   //! \brief standard exception for the debugstream
   class DebugStreamError : public IOError {};
 
+  /*! \brief Interface for output targets which provide a different
+    std::ostream to every thread
+
+    A DebugStream attach()ed to a DebugSink asks for the stream on
+    every output, see DebugLog for an implementation.
+  */
+  class DebugSink {
+  public:
+    virtual ~DebugSink() {};
+
+    //! \brief the stream to write to from the calling thread
+    virtual std::ostream& stream() = 0;
+  };
+
   class StreamWrap {
   public:
-    StreamWrap(std::ostream& _out) : out(_out) { };
+    StreamWrap(std::ostream& _out) : out(_out), sink(0) { };
+    StreamWrap(DebugSink& _sink) : out(_sink.stream()), sink(&_sink) { };
+
+    //! \brief the stream to write to from the calling thread
+    std::ostream& stream() {
+      return sink ? sink->stream() : out;
+    };
+
+    //! \brief the stream, for a sink that of the thread which attached it
     std::ostream& out;
+    DebugSink* sink;
     StreamWrap *next;
   };
 
@@ -255,17 +291,29 @@ namespace Dune {
       };
     };
 
+    /*! \brief true if the output operations of this stream are compiled in
+
+    If false, all output operations are empty inline functions which
+    vanish together with their arguments, as long as evaluating the
+    arguments has no side effects. Guard expensive arguments with
+    \code
+    if (DVVerbType::enabled && dvverb.active())
+      dvverb << expensiveSummary() << std::endl;
+    \endcode
+    */
+    static const bool enabled = activator<thislevel, dlevel>::value;
+
     //! \brief Generic types are passed on to current output stream
     template <class T>
-    DebugStream& operator<<(const T data) {
+    DebugStream& operator<<(const T& data) {
       // remove the following code if stream wasn't compiled active
       if (activator<thislevel, dlevel>::value) {
         if (! _tied) {
           if (_active)
-            current->out << data;
+            current->stream() << data;
         } else {
           if (_active && tiedstate->_active)
-            tiedstate->current->out << data;        
+            tiedstate->current->stream() << data;        
         };
       };      
 
@@ -284,10 +332,10 @@ namespace Dune {
       if (activator<thislevel, dlevel>::value) {
         if (! _tied) {
           if (_active)
-            current->out << data;
+            current->stream() << data;
         } else {
           if (_active && tiedstate->_active)
-            tiedstate->current->out << data;        
+            tiedstate->current->stream() << data;        
         };
       };      
 
@@ -299,10 +347,10 @@ namespace Dune {
       if (activator<thislevel, dlevel>::value) {
         if (! _tied) {
           if (_active)
-            f(current->out);
+            f(current->stream());
         } else {
           if (_active && tiedstate->_active)
-            f(tiedstate->current->out);
+            f(tiedstate->current->stream());
         };
       }
 
@@ -314,10 +362,10 @@ namespace Dune {
       if (activator<thislevel, dlevel>::value) {
         if (! _tied) {
           if (_active)
-            current->out.flush();
+            current->stream().flush();
         } else {
           if (_active && tiedstate->_active)
-            tiedstate->current->out.flush();
+            tiedstate->current->stream().flush();
         };
       }
 
@@ -368,6 +416,21 @@ namespace Dune {
       current = newcurr;    
     };
     
+    /*! \brief set output to a DebugSink, which may buffer the output
+      per thread.
+
+    Old stream data is stored. The sink has to outlive the stream or
+    be detach()ed before it is destroyed.
+    */
+    void attach(DebugSink& sink) {
+      if (_tied)
+        DUNE_THROW(DebugStreamError, "Cannot attach to a tied stream!");
+
+      StreamWrap* newcurr = new StreamWrap(sink);
+      newcurr->next = current;
+      current = newcurr;
+    };
+
     //! \brief detach current output stream and restore to previous stream
     void detach() throw(DebugStreamError) {
       if (current->next == 0)
@@ -415,6 +478,10 @@ namespace Dune {
     std::stack<bool> _actstack;
   };  
 
+  template <DebugLevel thislevel, DebugLevel dlevel, DebugLevel alevel,
+            template<DebugLevel, DebugLevel> class activator>
+  const bool DebugStream<thislevel, dlevel, alevel, activator>::enabled;
+
   /** /} */
 }
 
@@ -174,7 +174,7 @@ namespace Dune
         
     //===== iterator interface to rows of the matrix
     //! Iterator class for sequential access
-    typedef DenseIterator<DenseMatrix,row_type> Iterator;
+    typedef DenseIterator<DenseMatrix,row_type,row_reference> Iterator;
     //! typedef for stl compliant access
     typedef Iterator iterator;
     //! rename the iterators for easier access
@@ -209,7 +209,7 @@ namespace Dune
     }
 
     //! Iterator class for sequential access
-    typedef DenseIterator<const DenseMatrix,const row_type> ConstIterator;
+    typedef DenseIterator<const DenseMatrix,const row_type,const_row_reference> ConstIterator;
     //! typedef for stl compliant access
     typedef ConstIterator const_iterator;
     //! rename the iterators for easier access
@@ -508,10 +508,9 @@ namespace Dune
       if (size() == 0)
         return 0.0;
 
-      ConstIterator it = begin();
-      typename remove_const< typename FieldTraits<value_type>::real_type >::type max = it->one_norm();
-      for (it = it + 1; it != end(); ++it)
-        max = std::max(max, it->one_norm());
+      typename remove_const< typename FieldTraits<value_type>::real_type >::type max = (*this)[0].one_norm();
+      for (size_type i=1; i<rows(); ++i)
+        max = std::max(max, (*this)[i].one_norm());
 
       return max;
     }
@@ -522,10 +521,9 @@ namespace Dune
       if (size() == 0)
         return 0.0;
 
-      ConstIterator it = begin();
-      typename remove_const< typename FieldTraits<value_type>::real_type >::type max = it->one_norm_real();
-      for (it = it + 1; it != end(); ++it)
-        max = std::max(max, it->one_norm_real());
+      typename remove_const< typename FieldTraits<value_type>::real_type >::type max = (*this)[0].one_norm_real();
+      for (size_type i=1; i<rows(); ++i)
+        max = std::max(max, (*this)[i].one_norm_real());
 
       return max;
     }
@@ -553,7 +551,7 @@ namespace Dune
     MAT& leftmultiply (const DenseMatrix<M2>& M)
     {
       assert(M.rows() == M.cols() && M.rows() == rows());
-      MAT C(asImp());
+      typename DenseMatVecCopy<MAT>::type C(asImp());
 
       for (size_type i=0; i<rows(); i++)
         for (size_type j=0; j<cols(); j++) {
@@ -570,7 +568,7 @@ namespace Dune
     MAT& rightmultiply (const DenseMatrix<M2>& M)
     {
       assert(M.rows() == M.cols() && M.cols() == cols());
-      MAT C(asImp());
+      typename DenseMatVecCopy<MAT>::type C(asImp());
       
       for (size_type i=0; i<rows(); i++)
         for (size_type j=0; j<cols(); j++) {
@@ -696,8 +694,8 @@ namespace Dune
     };
 #endif // DOXYGEN
     
-    template<class Func>
-    void luDecomposition(DenseMatrix<MAT>& A, Func func) const;
+    template<class LU, class Func>
+    void luDecomposition(DenseMatrix<LU>& A, Func func) const;
   };
 
 #ifndef DOXYGEN
@@ -736,8 +734,8 @@ namespace Dune
     (*rhs_)[k] -= factor*(*rhs_)[i];
   }
   template<typename MAT>
-  template<typename Func>
-  inline void DenseMatrix<MAT>::luDecomposition(DenseMatrix<MAT>& A, Func func) const
+  template<typename LU, typename Func>
+  inline void DenseMatrix<MAT>::luDecomposition(DenseMatrix<LU>& A, Func func) const
   {
     typedef typename FieldTraits<value_type>::real_type
       real_type;
@@ -841,7 +839,7 @@ namespace Dune
       V& rhs = x; // use x to store rhs
       rhs = b; // copy data
       Elim<V> elim(rhs);
-      MAT A(asImp());
+      typename DenseMatVecCopy<MAT>::type A(asImp());
       
       luDecomposition(A, elim);
       
@@ -888,11 +886,11 @@ namespace Dune
     }
     else {
       
-      MAT A(asImp());
+      typename DenseMatVecCopy<MAT>::type A(asImp());
       std::vector<size_type> pivot(rows());
       luDecomposition(A, ElimPivot(pivot));
-      DenseMatrix<MAT>& L=A;
-      DenseMatrix<MAT>& U=A;
+      const typename DenseMatVecCopy<MAT>::type& L=A;
+      const typename DenseMatVecCopy<MAT>::type& U=A;
           
       // initialize inverse
       *this=field_type();
@@ -954,7 +952,7 @@ namespace Dune
 
     }
 
-    MAT A(asImp());
+    typename DenseMatVecCopy<MAT>::type A(asImp());
     field_type det;
     try
     {
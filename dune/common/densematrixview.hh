@@ -0,0 +1,194 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_DENSEMATRIXVIEW_HH
+#define DUNE_DENSEMATRIXVIEW_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include "densematrix.hh"
+#include "densevectorview.hh"
+#include "dynmatrix.hh"
+
+/*! \file
+ * \brief A dense matrix referring to entries stored elsewhere
+ */
+
+namespace Dune {
+
+  /** @addtogroup DenseMatVec
+      @{
+  */
+
+  template< class K > class DenseMatrixView;
+
+  template< class K >
+  struct DenseMatVecTraits< DenseMatrixView<K> >
+  {
+    typedef DenseMatrixView<K> derived_type;
+
+    typedef DenseVectorView<K> row_type;
+
+    // rows are views created on access
+    typedef row_type row_reference;
+    typedef const row_type const_row_reference;
+
+    typedef K value_type;
+    typedef std::size_t size_type;
+  };
+
+  template< class K >
+  struct FieldTraits< DenseMatrixView<K> >
+  {
+    typedef typename FieldTraits<K>::field_type field_type;
+    typedef typename FieldTraits<K>::real_type real_type;
+  };
+
+  //! Working copies of a matrix view are DynamicMatrices
+  template< class K >
+  struct DenseMatVecCopy< DenseMatrixView<K> >
+  {
+    typedef DynamicMatrix<K> type;
+  };
+
+  /** \brief Non-owning dense matrix over external memory
+
+      Entry (i,j) is stored at data[i*rowStride + j*colStride]. With
+      the default strides this is a row-major array, the strides also
+      describe column-major storage, sub-blocks and transposed
+      matrices. All DenseMatrix methods, e.g. mv(), solve() or
+      determinant(), work directly on the external memory:
+
+      \code
+      double a[4*4];
+      DenseMatrixView<double> A(a, 4, 4);
+      A.block(1, 1, 2, 2).invert();
+      A.transposed().mv(x, y);
+      \endcode
+
+      Rows are returned as DenseVectorView by value, also by the row
+      iterators, so use (*it)[j] instead of it->operator[](j). Copying a
+      view creates another view of the same entries. Assigning a matrix to
+      a view copies the entries, the sizes have to match. Algorithms
+      which need a working copy, like solve() or invert(), store it in
+      a DynamicMatrix.
+
+      \tparam K is the field type (use float, double, complex, etc)
+   */
+  template< class K >
+  class DenseMatrixView : public DenseMatrix< DenseMatrixView<K> >
+  {
+    typedef DenseMatrix< DenseMatrixView<K> > Base;
+  public:
+    typedef typename Base::size_type size_type;
+    typedef typename Base::value_type value_type;
+    typedef typename Base::row_type row_type;
+    //! The type used for the strides
+    typedef std::ptrdiff_t difference_type;
+
+    //===== constructors
+    //! \brief Constructor making an empty view
+    DenseMatrixView () :
+      _data(0), _rows(0), _cols(0), _rowStride(0), _colStride(1)
+    {}
+
+    //! \brief Constructor making a view of the row-major r x c array data
+    DenseMatrixView (K* data, size_type r, size_type c) :
+      _data(data), _rows(r), _cols(c), _rowStride(c), _colStride(1)
+    {}
+
+    //! \brief Constructor making a view of the entries data[i*rowStride + j*colStride]
+    DenseMatrixView (K* data, size_type r, size_type c,
+                     difference_type rowStride, difference_type colStride) :
+      _data(data), _rows(r), _cols(c), _rowStride(rowStride), _colStride(colStride)
+    {}
+
+    //===== assignment
+    //! \brief Copy the entries of other into the viewed memory
+    DenseMatrixView& operator= (const DenseMatrixView & other)
+    {
+      return assign(other);
+    }
+
+    //! \brief Copy the entries of other into the viewed memory
+    template< class M >
+    DenseMatrixView& operator= (const DenseMatrix<M> & other)
+    {
+      return assign(other);
+    }
+
+    //! \brief Set all entries to f
+    DenseMatrixView& operator= (const value_type & f)
+    {
+      Base::operator=(f);
+      return *this;
+    }
+
+    //===== views of parts of this matrix
+    //! \brief View of the r x c block starting at entry (i,j)
+    DenseMatrixView block (size_type i, size_type j, size_type r, size_type c) const
+    {
+      assert(i+r <= _rows && j+c <= _cols);
+      return DenseMatrixView(entry(i, j), r, c, _rowStride, _colStride);
+    }
+
+    //! \brief View of the transposed matrix
+    DenseMatrixView transposed () const
+    {
+      return DenseMatrixView(_data, _cols, _rows, _colStride, _rowStride);
+    }
+
+    //! \brief View of column j
+    row_type column (size_type j) const
+    {
+      assert(j < _cols);
+      return row_type(entry(0, j), _rows, _rowStride);
+    }
+
+    //! pointer to the entry (0,0)
+    K* data () const { return _data; }
+
+    //! distance between entries (i,j) and (i+1,j)
+    difference_type rowStride () const { return _rowStride; }
+
+    //! distance between entries (i,j) and (i,j+1)
+    difference_type colStride () const { return _colStride; }
+
+    // make this thing a matrix
+    size_type mat_rows() const { return _rows; }
+    size_type mat_cols() const { return _cols; }
+    row_type mat_access(size_type i)
+    {
+      return row_type(entry(i, 0), _cols, _colStride);
+    }
+    const row_type mat_access(size_type i) const
+    {
+      return row_type(entry(i, 0), _cols, _colStride);
+    }
+
+  private:
+    K* entry (size_type i, size_type j) const
+    {
+      return _data + difference_type(i)*_rowStride + difference_type(j)*_colStride;
+    }
+
+    template< class M >
+    DenseMatrixView& assign (const DenseMatrix<M> & other)
+    {
+      assert(other.rows() == _rows && (_rows == 0 || other.cols() == _cols));
+      for (size_type i=0; i<_rows; i++)
+        for (size_type j=0; j<_cols; j++)
+          (*this)[i][j] = other[i][j];
+      return *this;
+    }
+
+    K* _data;
+    size_type _rows, _cols;
+    difference_type _rowStride, _colStride;
+  };
+
+/** @} end documentation */
+
+} // end namespace
+
+#endif // DUNE_DENSEMATRIXVIEW_HH
@@ -10,6 +10,7 @@
 #include "matvectraits.hh"
 #include "promotiontraits.hh"
 #include "dotproduct.hh"
+#include "densevectorexpression.hh"
 
 namespace Dune {
 
@@ -112,16 +113,49 @@ namespace Dune {
 
   }
 
+  /*! \brief Reference type of the DenseIterator over T, if R is the
+      reference type of a related DenseIterator
+
+      Plain references stay references, proxies returned by value stay
+      values.
+   */
+  template<class T, class R>
+  struct DenseIteratorReference
+  {
+    typedef T type;
+  };
+
+  template<class T, class R>
+  struct DenseIteratorReference<T, R&>
+  {
+    typedef T& type;
+  };
+
   /*! \brief Generic iterator class for dense vector and matrix implementations
 
     provides sequential access to DenseVector, FieldVector and FieldMatrix
+
+    \tparam R is the type returned by dereferencing. Containers which
+    return their entries as proxies by value, e.g. the rows of a
+    DenseMatrixView, pass the proxy type here. The entries can then
+    only be accessed through operator* and operator[], not through
+    operator->.
    */
-  template<class C, class T>
+  template<class C, class T, class R = T&>
   class DenseIterator : 
-    public Dune::RandomAccessIteratorFacade<DenseIterator<C,T>,T, T&, std::ptrdiff_t>
+    public Dune::RandomAccessIteratorFacade<DenseIterator<C,T,R>,T, R, std::ptrdiff_t>
   {
-    friend class DenseIterator<typename remove_const<C>::type, typename remove_const<T>::type >;
-    friend class DenseIterator<const typename remove_const<C>::type, const typename remove_const<T>::type >;
+    typedef typename remove_const<C>::type MutableC;
+    typedef typename remove_const<T>::type MutableT;
+    typedef DenseIterator<MutableC, MutableT,
+                          typename DenseIteratorReference<MutableT, R>::type> MutableIterator;
+    typedef DenseIterator<const MutableC, const MutableT,
+                          typename DenseIteratorReference<const MutableT, R>::type> ConstIterator;
+
+    friend class DenseIterator<MutableC, MutableT,
+                               typename DenseIteratorReference<MutableT, R>::type>;
+    friend class DenseIterator<const MutableC, const MutableT,
+                               typename DenseIteratorReference<const MutableT, R>::type>;
     
   public:
     
@@ -144,23 +178,23 @@ namespace Dune {
       : container_(&cont), position_(pos)
     {}
     
-    DenseIterator(const DenseIterator<typename remove_const<C>::type, typename remove_const<T>::type >& other)
+    DenseIterator(const MutableIterator& other)
       : container_(other.container_), position_(other.position_)
     {}
     
     // Methods needed by the forward iterator
-    bool equals(const DenseIterator<typename remove_const<C>::type,typename remove_const<T>::type>& other) const
+    bool equals(const MutableIterator& other) const
     {
       return position_ == other.position_ && container_ == other.container_;
     }
     
     
-    bool equals(const DenseIterator<const typename remove_const<C>::type,const typename remove_const<T>::type>& other) const
+    bool equals(const ConstIterator& other) const
     {
       return position_ == other.position_ && container_ == other.container_;
     }
     
-    T& dereference() const{
+    R dereference() const{
       return container_->operator[](position_);
     }
     
@@ -174,7 +208,7 @@ namespace Dune {
     }
     
     // Additional function needed by RandomAccessIterator
-    T& elementAt(DifferenceType i)const{
+    R elementAt(DifferenceType i)const{
       return container_->operator[](position_+i);
     }
     
@@ -182,13 +216,13 @@ namespace Dune {
       position_=position_+n;
     }
     
-    DifferenceType distanceTo(DenseIterator<const typename remove_const<C>::type,const typename remove_const<T>::type> other)const
+    DifferenceType distanceTo(ConstIterator other)const
     {
       assert(other.container_==container_);
       return other.position_ - position_;
     }
     
-    DifferenceType distanceTo(DenseIterator<typename remove_const<C>::type, typename remove_const<T>::type> other)const
+    DifferenceType distanceTo(MutableIterator other)const
     {
       assert(other.container_==container_);
       return other.position_ - position_;
@@ -376,20 +410,57 @@ namespace Dune {
       return asImp();
     }
 
+    //! assign a lazily evaluated expression in a single loop
+    template <class E>
+    derived_type& operator= (const DenseVectorExpression<E>& e)
+    {
+      const E& x = e.asImp();
+      assert(x.size() == size());
+      for (size_type i=0; i<size(); i++)
+        (*this)[i] = x[i];
+      return asImp();
+    }
+
+    //! add a lazily evaluated expression in a single loop
+    template <class E>
+    derived_type& operator+= (const DenseVectorExpression<E>& e)
+    {
+      const E& x = e.asImp();
+      assert(x.size() == size());
+      for (size_type i=0; i<size(); i++)
+        (*this)[i] += x[i];
+      return asImp();
+    }
+
+    //! subtract a lazily evaluated expression in a single loop
+    template <class E>
+    derived_type& operator-= (const DenseVectorExpression<E>& e)
+    {
+      const E& x = e.asImp();
+      assert(x.size() == size());
+      for (size_type i=0; i<size(); i++)
+        (*this)[i] -= x[i];
+      return asImp();
+    }
+
     //! Binary vector addition
     template <class Other>
-    derived_type operator+ (const DenseVector<Other>& b) const
+    typename DenseMatVecCopy<derived_type>::type
+    operator+ (const DenseVector<Other>& b) const
     {
-      derived_type z = asImp();
-      return (z+=b);
+      typename DenseMatVecCopy<derived_type>::type z(asImp());
+      z += b;
+      return z;
     }
 
     //! Binary vector subtraction
     template <class Other>
-    derived_type operator- (const DenseVector<Other>& b) const
+    typename DenseMatVecCopy<derived_type>::type
+    operator- (const DenseVector<Other>& b) const
     {
-      derived_type z = asImp();
-      return (z-=b);
+      typename DenseMatVecCopy<derived_type>::type z(asImp());
+      z -= b;
+      return z;
     }
 
     //! vector space add scalar to all comps
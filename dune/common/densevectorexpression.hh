@@ -0,0 +1,236 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_DENSEVECTOREXPRESSION_HH
+#define DUNE_DENSEVECTOREXPRESSION_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include "ftraits.hh"
+#include "promotiontraits.hh"
+
+/*! \file
+ * \brief Lazy expression templates for DenseVector arithmetic
+ */
+
+namespace Dune {
+
+  /** @addtogroup DenseMatVec
+      @{
+  */
+
+  template<typename V> class DenseVector;
+
+  /** \brief Interface of lazily evaluated vector expressions
+   *
+   *  The binary operators of DenseVector return a new vector, so that
+   *  \c z=a+b-c creates two temporaries and traverses memory three
+   *  times. Wrapping one of the operands with lazy() instead builds an
+   *  expression object, which is evaluated entry by entry in a single
+   *  loop when it is assigned to a vector:
+   *
+   *  \code
+   *  z = lazy(a) + b - 2.0*lazy(c);
+   *  z += 0.5*(lazy(a) - b);
+   *  \endcode
+   *
+   *  The entries are computed with the same operations as the eager
+   *  operators, hence the result is identical. Expressions keep
+   *  references to their operands and must not outlive them.
+   *
+   *  \tparam E the implementation, providing size() and operator[]
+   */
+  template<class E>
+  class DenseVectorExpression
+  {
+  public:
+    //! the implementation
+    const E& asImp () const { return static_cast<const E&>(*this); }
+  };
+
+  /** \brief Leaf of a vector expression, refers to a DenseVector */
+  template<class V>
+  class DenseVectorReference
+    : public DenseVectorExpression< DenseVectorReference<V> >
+  {
+  public:
+    typedef typename DenseVector<V>::value_type value_type;
+    typedef typename DenseVector<V>::size_type size_type;
+
+    explicit DenseVectorReference (const DenseVector<V>& v) : v_(v) {}
+
+    size_type size () const { return v_.size(); }
+    const value_type& operator[] (size_type i) const { return v_[i]; }
+
+  private:
+    const DenseVector<V>& v_;
+  };
+
+  /** \brief Entrywise sum of two vector expressions */
+  template<class A, class B>
+  class DenseVectorSum
+    : public DenseVectorExpression< DenseVectorSum<A,B> >
+  {
+  public:
+    typedef typename PromotionTraits<typename A::value_type, typename B::value_type>::PromotedType value_type;
+    typedef typename A::size_type size_type;
+
+    DenseVectorSum (const A& a, const B& b) : a_(a), b_(b)
+    {
+      assert(a.size() == b.size());
+    }
+
+    size_type size () const { return a_.size(); }
+    value_type operator[] (size_type i) const { return a_[i] + b_[i]; }
+
+  private:
+    const A a_;
+    const B b_;
+  };
+
+  /** \brief Entrywise difference of two vector expressions */
+  template<class A, class B>
+  class DenseVectorDifference
+    : public DenseVectorExpression< DenseVectorDifference<A,B> >
+  {
+  public:
+    typedef typename PromotionTraits<typename A::value_type, typename B::value_type>::PromotedType value_type;
+    typedef typename A::size_type size_type;
+
+    DenseVectorDifference (const A& a, const B& b) : a_(a), b_(b)
+    {
+      assert(a.size() == b.size());
+    }
+
+    size_type size () const { return a_.size(); }
+    value_type operator[] (size_type i) const { return a_[i] - b_[i]; }
+
+  private:
+    const A a_;
+    const B b_;
+  };
+
+  /** \brief Vector expression scaled by a scalar */
+  template<class A>
+  class DenseVectorScaled
+    : public DenseVectorExpression< DenseVectorScaled<A> >
+  {
+  public:
+    typedef typename A::value_type value_type;
+    typedef typename A::size_type size_type;
+    typedef typename FieldTraits<value_type>::field_type field_type;
+
+    DenseVectorScaled (const field_type& s, const A& a) : s_(s), a_(a) {}
+
+    size_type size () const { return a_.size(); }
+    value_type operator[] (size_type i) const { return s_ * a_[i]; }
+
+  private:
+    const field_type s_;
+    const A a_;
+  };
+
+  /** \brief Entrywise negation of a vector expression */
+  template<class A>
+  class DenseVectorNegation
+    : public DenseVectorExpression< DenseVectorNegation<A> >
+  {
+  public:
+    typedef typename A::value_type value_type;
+    typedef typename A::size_type size_type;
+
+    explicit DenseVectorNegation (const A& a) : a_(a) {}
+
+    size_type size () const { return a_.size(); }
+    value_type operator[] (size_type i) const { return -a_[i]; }
+
+  private:
+    const A a_;
+  };
+
+  /** \brief Start a lazily evaluated expression with the vector v
+   *  \relates DenseVectorExpression
+   */
+  template<class V>
+  DenseVectorReference<V> lazy (const DenseVector<V>& v)
+  {
+    return DenseVectorReference<V>(v);
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A, class B>
+  DenseVectorSum<A,B>
+  operator+ (const DenseVectorExpression<A>& a, const DenseVectorExpression<B>& b)
+  {
+    return DenseVectorSum<A,B>(a.asImp(), b.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A, class V>
+  DenseVectorSum<A,DenseVectorReference<V> >
+  operator+ (const DenseVectorExpression<A>& a, const DenseVector<V>& b)
+  {
+    return DenseVectorSum<A,DenseVectorReference<V> >(a.asImp(), DenseVectorReference<V>(b));
+  }
+
+  //! \relates DenseVectorExpression
+  template<class V, class B>
+  DenseVectorSum<DenseVectorReference<V>,B>
+  operator+ (const DenseVector<V>& a, const DenseVectorExpression<B>& b)
+  {
+    return DenseVectorSum<DenseVectorReference<V>,B>(DenseVectorReference<V>(a), b.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A, class B>
+  DenseVectorDifference<A,B>
+  operator- (const DenseVectorExpression<A>& a, const DenseVectorExpression<B>& b)
+  {
+    return DenseVectorDifference<A,B>(a.asImp(), b.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A, class V>
+  DenseVectorDifference<A,DenseVectorReference<V> >
+  operator- (const DenseVectorExpression<A>& a, const DenseVector<V>& b)
+  {
+    return DenseVectorDifference<A,DenseVectorReference<V> >(a.asImp(), DenseVectorReference<V>(b));
+  }
+
+  //! \relates DenseVectorExpression
+  template<class V, class B>
+  DenseVectorDifference<DenseVectorReference<V>,B>
+  operator- (const DenseVector<V>& a, const DenseVectorExpression<B>& b)
+  {
+    return DenseVectorDifference<DenseVectorReference<V>,B>(DenseVectorReference<V>(a), b.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A>
+  DenseVectorScaled<A>
+  operator* (const typename DenseVectorScaled<A>::field_type& s, const DenseVectorExpression<A>& a)
+  {
+    return DenseVectorScaled<A>(s, a.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A>
+  DenseVectorScaled<A>
+  operator* (const DenseVectorExpression<A>& a, const typename DenseVectorScaled<A>::field_type& s)
+  {
+    return DenseVectorScaled<A>(s, a.asImp());
+  }
+
+  //! \relates DenseVectorExpression
+  template<class A>
+  DenseVectorNegation<A>
+  operator- (const DenseVectorExpression<A>& a)
+  {
+    return DenseVectorNegation<A>(a.asImp());
+  }
+
+  /** @} end documentation */
+
+} // end namespace
+
+#endif // DUNE_DENSEVECTOREXPRESSION_HH
@@ -0,0 +1,137 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_DENSEVECTORVIEW_HH
+#define DUNE_DENSEVECTORVIEW_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include "densevector.hh"
+#include "dynvector.hh"
+
+/*! \file
+ * \brief A dense vector referring to entries stored elsewhere
+ */
+
+namespace Dune {
+
+  /** @addtogroup DenseMatVec
+      @{
+  */
+
+  template< class K > class DenseVectorView;
+
+  template< class K >
+  struct DenseMatVecTraits< DenseVectorView<K> >
+  {
+    typedef DenseVectorView<K> derived_type;
+    typedef K value_type;
+    typedef std::size_t size_type;
+  };
+
+  template< class K >
+  struct FieldTraits< DenseVectorView<K> >
+  {
+    typedef typename FieldTraits<K>::field_type field_type;
+    typedef typename FieldTraits<K>::real_type real_type;
+  };
+
+  //! Working copies of a vector view are DynamicVectors
+  template< class K >
+  struct DenseMatVecCopy< DenseVectorView<K> >
+  {
+    typedef DynamicVector<K> type;
+  };
+
+  /** \brief Non-owning dense vector over external memory
+
+      Entry i is stored at data[i*stride]. The view does not allocate
+      or free memory, so a plain array, a row or column of a matrix or
+      a communication buffer can be used with all DenseVector methods
+      without copying:
+
+      \code
+      double buffer[6];
+      DenseVectorView<double> even(buffer, 3, 2);
+      even *= 2.0;
+      double norm = even.two_norm();
+      \endcode
+
+      Copying a view creates another view of the same entries.
+      Assigning a vector to a view copies the entries, the sizes have
+      to match. Results of the arithmetic operators, like a+b, are
+      DynamicVectors.
+
+      \tparam K is the field type (use float, double, complex, etc)
+   */
+  template< class K >
+  class DenseVectorView : public DenseVector< DenseVectorView<K> >
+  {
+    typedef DenseVector< DenseVectorView<K> > Base;
+  public:
+    typedef typename Base::size_type size_type;
+    typedef typename Base::value_type value_type;
+    //! The type used for the stride
+    typedef std::ptrdiff_t difference_type;
+
+    //! Constructor making an empty view
+    DenseVectorView () :
+      _data(0), _size(0), _stride(1)
+    {}
+
+    //! Constructor making a view of the entries data[i*stride], 0 <= i < n
+    DenseVectorView (K* data, size_type n, difference_type stride = 1) :
+      _data(data), _size(n), _stride(stride)
+    {}
+
+    //! Copy the entries of x into the viewed memory
+    DenseVectorView& operator= (const DenseVectorView& x)
+    {
+      assert(x.size() == this->size());
+      for (size_type i=0; i<this->size(); i++)
+        (*this)[i] = x[i];
+      return *this;
+    }
+
+    //! Copy the entries of x into the viewed memory
+    template< class V >
+    DenseVectorView& operator= (const DenseVector<V>& x)
+    {
+      assert(x.size() == this->size());
+      for (size_type i=0; i<this->size(); i++)
+        (*this)[i] = x[i];
+      return *this;
+    }
+
+    using Base::operator=;
+
+    //! Make this a view of the entries data[i*stride], 0 <= i < n
+    void reset (K* data, size_type n, difference_type stride = 1)
+    {
+      _data = data;
+      _size = n;
+      _stride = stride;
+    }
+
+    //! pointer to the first entry
+    K* data () const { return _data; }
+
+    //! distance between two consecutive entries
+    difference_type stride () const { return _stride; }
+
+    //==== make this thing a vector
+    size_type vec_size() const { return _size; }
+    K & vec_access(size_type i) { return _data[difference_type(i)*_stride]; }
+    const K & vec_access(size_type i) const { return _data[difference_type(i)*_stride]; }
+
+  private:
+    K* _data;
+    size_type _size;
+    difference_type _stride;
+  };
+
+  /** @} end documentation */
+
+} // end namespace
+
+#endif // DUNE_DENSEVECTORVIEW_HH
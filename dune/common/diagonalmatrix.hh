@@ -417,6 +417,18 @@ class DiagonalMatrix
             x[i] = b[i]/diag_[i];
     }
 
+    /** \brief Solve system A y = b - r in a single pass
+
+        This is the correction of the Jacobi method, if r is the product
+        of the off-diagonal part with the current iterate.
+    */
+    template<class X, class Y>
+    void solveResidual (Y& y, const X& b, const X& r) const
+    {
+        for (int i=0; i<n; i++)
+            y[i] = (b[i] - r[i])/diag_[i];
+    }
+
     //! Compute inverse
     void invert()
     {
@@ -569,6 +581,13 @@ class DiagonalMatrix<K, 1> : public FieldMatrix<K, 1, 1>
             DenseMatrixAssigner<Conversion<T,K>::exists>::assign(*this, t);
         }
 
+        //! Solve system A y = b - r, see DiagonalMatrix::solveResidual()
+        template<class X, class Y>
+        void solveResidual (Y& y, const X& b, const X& r) const
+        {
+            y[0] = (b[0] - r[0])/(*this)[0][0];
+        }
+
         //! Get const reference to diagonal entry
         const K& diagonal(size_type) const
         {
@@ -1068,6 +1087,103 @@ class ContainerWrapperIterator : public BidirectionalIteratorFacade<ContainerWra
 
 
 
+/**
+ * @brief Kernels for arrays of diagonal matrices and vectors
+ *
+ * A block diagonal matrix, e.g. the diagonal of a block matrix used
+ * in a Jacobi preconditioner, stores count DiagonalMatrix<K,n> one
+ * after the other. These kernels process all blocks in a single loop
+ * nest with a fixed inner trip count n, which the compiler unrolls and
+ * vectorizes. The results are identical to calling the corresponding
+ * DiagonalMatrix method for each block.
+ *
+ * \code
+ * std::vector<DiagonalMatrix<double,3> > D(count);
+ * std::vector<FieldVector<double,3> > x(count), y(count);
+ * DiagonalMatrixBatch<double,3>::umv(count, &D[0], &x[0], &y[0]);
+ * \endcode
+ *
+ * \tparam K Type used for scalars
+ * \tparam n Size of the blocks
+ */
+template<class K, int n>
+struct DiagonalMatrixBatch
+{
+    typedef std::size_t size_type;
+    typedef DiagonalMatrix<K,n> matrix_type;
+    typedef FieldVector<K,n> vector_type;
+
+    //! y_k = D_k x_k for 0 <= k < count
+    static void mv (size_type count, const matrix_type* D, const vector_type* x, vector_type* y)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                y[k][i] = D[k].diagonal(i) * x[k][i];
+    }
+
+    //! y_k += D_k x_k for 0 <= k < count
+    static void umv (size_type count, const matrix_type* D, const vector_type* x, vector_type* y)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                y[k][i] += D[k].diagonal(i) * x[k][i];
+    }
+
+    //! y_k -= D_k x_k for 0 <= k < count
+    static void mmv (size_type count, const matrix_type* D, const vector_type* x, vector_type* y)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                y[k][i] -= D[k].diagonal(i) * x[k][i];
+    }
+
+    //! y_k += alpha D_k x_k for 0 <= k < count
+    static void usmv (size_type count, const K& alpha, const matrix_type* D, const vector_type* x, vector_type* y)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                y[k][i] += alpha * D[k].diagonal(i) * x[k][i];
+    }
+
+    //! solve D_k x_k = b_k for 0 <= k < count
+    static void solve (size_type count, const matrix_type* D, vector_type* x, const vector_type* b)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                x[k][i] = b[k][i] / D[k].diagonal(i);
+    }
+
+    //! solve D_k y_k = b_k - r_k for 0 <= k < count, see DiagonalMatrix::solveResidual()
+    static void solveResidual (size_type count, const matrix_type* D, vector_type* y,
+                               const vector_type* b, const vector_type* r)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                y[k][i] = (b[k][i] - r[k][i]) / D[k].diagonal(i);
+    }
+
+    /** \brief damped Jacobi update x_k += omega D_k^{-1} (b_k - r_k) for 0 <= k < count
+
+        With r the product of the off-diagonal part with x this is one
+        Jacobi step, without storing the correction.
+    */
+    static void jacobi (size_type count, const K& omega, const matrix_type* D, vector_type* x,
+                        const vector_type* b, const vector_type* r)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                x[k][i] += omega * ((b[k][i] - r[k][i]) / D[k].diagonal(i));
+    }
+
+    //! invert D_k for 0 <= k < count
+    static void invert (size_type count, matrix_type* D)
+    {
+        for (size_type k=0; k<count; ++k)
+            for (int i=0; i<n; ++i)
+                D[k].diagonal(i) = 1/D[k].diagonal(i);
+    }
+};
+
 template<class M, class K, int n>
 void istl_assign_to_fmatrix(DenseMatrix<M>& fm, const DiagonalMatrix<K,n>& s)
 {
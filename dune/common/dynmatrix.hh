@@ -7,6 +7,8 @@
 #include <cmath>
 #include <cstddef>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include <dune/common/misc.hh>
 #include <dune/common/exceptions.hh>
@@ -73,15 +75,88 @@ namespace Dune
       _data(r, row_type(c, v) )
     {}
 
+    //! \brief Copy constructor
+    DynamicMatrix (const DynamicMatrix & other) :
+      _data(other._data)
+    {}
+
+    //! \brief Constructor copying the entries of any other dense matrix
+    template< class M >
+    explicit DynamicMatrix (const DenseMatrix<M> & other) :
+      _data(other.rows(), row_type(other.rows() ? other.cols() : 0))
+    {
+      for (size_type i=0; i<other.rows(); i++)
+        for (size_type j=0; j<other.cols(); j++)
+          _data[i][j] = other[i][j];
+    }
+
+#if HAVE_RVALUE_REFERENCES
+    //! \brief Move constructor, takes over the memory of other
+    DynamicMatrix (DynamicMatrix && other) throw() :
+      _data(std::move(other._data))
+    {}
+
+    //! \brief Constructor adopting the rows without copying
+    explicit DynamicMatrix (std::vector<row_type> && rows) :
+      _data(std::move(rows))
+    {
+      assert(checkRows());
+    }
+#endif
+
     //==== resize related methods
+    /** \brief Resize to r x c and set all entries to v
+
+        Rows that are kept reuse their memory, only additional rows
+        are allocated.
+    */
     void resize (size_type r, size_type c, value_type v = value_type() )
     {
-      _data.resize(0);
+      if (r < _data.size())
+        _data.resize(r);
+      for (size_type i=0; i<_data.size(); i++)
+      {
+        _data[i].resize(c);
+        _data[i] = v;
+      }
       _data.resize(r, row_type(c, v) );
     }
     
     //===== assignment
     using Base::operator=;
+
+    //! \brief Copy assignment, reuses the memory of this matrix if possible
+    DynamicMatrix& operator= (const DynamicMatrix & other)
+    {
+      _data = other._data;
+      return *this;
+    }
+
+#if HAVE_RVALUE_REFERENCES
+    //! \brief Move assignment, takes over the memory of other
+    DynamicMatrix& operator= (DynamicMatrix && other) throw()
+    {
+      _data = std::move(other._data);
+      return *this;
+    }
+#endif
+
+    //! \brief Exchange the entries with other without copying
+    void swap (DynamicMatrix & other)
+    {
+      _data.swap(other._data);
+    }
+
+    /** \brief Exchange the rows with a std::vector without copying
+
+        This allows to adopt externally filled rows and to hand the
+        rows back to the caller. All rows must have the same size.
+    */
+    void swap (std::vector<row_type> & rows)
+    {
+      _data.swap(rows);
+      assert(checkRows());
+    }
     
     // make this thing a matrix
     size_type mat_rows() const { return _data.size(); }
@@ -91,6 +166,16 @@ namespace Dune
     }
     row_type & mat_access(size_type i) { return _data[i]; }
     const row_type & mat_access(size_type i) const { return _data[i]; }
+
+  private:
+    //! whether all rows have the same size
+    bool checkRows () const
+    {
+      for (size_type i=1; i<_data.size(); i++)
+        if (_data[i].size() != _data[0].size())
+          return false;
+      return true;
+    }
   };
 
 /** @} end documentation */
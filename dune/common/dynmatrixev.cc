@@ -16,6 +16,12 @@
 // nonsymmetric matrices
 #define DGEEV_FORTRAN FC_FUNC (dgeev, DGEEV)
 
+// symmetric matrices, divide and conquer
+#define DSYEVD_FORTRAN FC_FUNC (dsyevd, DSYEVD)
+
+// symmetric matrices, relatively robust representations
+#define DSYEVR_FORTRAN FC_FUNC (dsyevr, DSYEVR)
+
 // dsyev declaration (in liblapack)
 extern "C" {
 
@@ -124,6 +130,95 @@ extern void DGEEV_FORTRAN(const char* jobvl, const char* jobvr, const long
     const long int* ldvl, double* vr, const long int* ldvr, double* work,
     const long int* lwork, const long int* info);
 
+/*
+    *
+    **  purpose
+    **  =======
+    **
+    **  xsyevd computes all eigenvalues and, optionally, eigenvectors of a
+    **  BASE DATA TYPE symmetric matrix a. If eigenvectors are desired, it
+    **  uses a divide and conquer algorithm.
+    **
+    **  arguments (see xsyev for jobz, uplo, n, a, lda, w and info)
+    **  =========
+    **
+    **  work    (workspace/output) BASE DATA TYPE array, dimension (max(1,lwork))
+    **          on exit, if info = 0, work(1) returns the optimal lwork.
+    **
+    **  lwork   (input) long int
+    **          the dimension of the array work. if lwork = -1, a workspace
+    **          query is assumed for work and iwork.
+    **
+    **  iwork   (workspace/output) long int array, dimension (max(1,liwork))
+    **          on exit, if info = 0, iwork(1) returns the optimal liwork.
+    **
+    **  liwork  (input) long int
+    **          the dimension of the array iwork. if liwork = -1, a
+    **          workspace query is assumed.
+    **
+**/
+extern void DSYEVD_FORTRAN(const char* jobz, const char* uplo, const long
+    int* n, double* a, const long int* lda, double* w,
+    double* work, const long int* lwork, long int* iwork,
+    const long int* liwork, long int* info);
+
+/*
+    *
+    **  purpose
+    **  =======
+    **
+    **  xsyevr computes selected eigenvalues and, optionally, eigenvectors
+    **  of a BASE DATA TYPE symmetric matrix a. Eigenvalues and eigenvectors
+    **  can be selected by specifying either a range of values or a range
+    **  of indices for the desired eigenvalues.
+    **
+    **  arguments (see xsyev for jobz, uplo, n, a, lda and info)
+    **  =========
+    **
+    **  range   (input) char
+    **          = 'a': all eigenvalues will be found.
+    **          = 'v': all eigenvalues in the half-open interval (vl,vu]
+    **                 will be found.
+    **          = 'i': the il-th through iu-th eigenvalues will be found.
+    **
+    **  vl, vu  (input) BASE DATA TYPE
+    **          bounds of the interval for range = 'v'.
+    **
+    **  il, iu  (input) long int
+    **          1-based indices of the smallest and largest eigenvalue
+    **          to be returned for range = 'i'.
+    **
+    **  abstol  (input) BASE DATA TYPE
+    **          absolute error tolerance, 0 selects a default.
+    **
+    **  m       (output) long int
+    **          the total number of eigenvalues found.
+    **
+    **  w       (output) BASE DATA TYPE array, dimension (n)
+    **          the first m elements contain the selected eigenvalues in
+    **          ascending order.
+    **
+    **  z       (output) BASE DATA TYPE array, dimension (ldz, max(1,m))
+    **          if jobz = 'v', the first m columns of z contain the
+    **          orthonormal eigenvectors.
+    **
+    **  ldz     (input) long int
+    **          the leading dimension of the array z.
+    **
+    **  isuppz  (output) long int array, dimension ( 2*max(1,m) )
+    **          the support of the eigenvectors in z.
+    **
+    **  work, lwork, iwork, liwork
+    **          as for xsyevd.
+    **
+**/
+extern void DSYEVR_FORTRAN(const char* jobz, const char* range, const char* uplo,
+    const long int* n, double* a, const long int* lda,
+    const double* vl, const double* vu, const long int* il, const long int* iu,
+    const double* abstol, long int* m, double* w, double* z, const long int* ldz,
+    long int* isuppz, double* work, const long int* lwork, long int* iwork,
+    const long int* liwork, long int* info);
+
 } // end extern C 
 #endif
 
@@ -146,7 +241,38 @@ void eigenValuesNonsymLapackCall(
 #endif
 }
 
-} // end namespace FMatrixHelp 
+void eigenValuesSymLapackCall(
+      const char* jobz, const char* uplo, const long
+      int* n, double* a, const long int* lda, double* w,
+      double* work, const long int* lwork, long int* iwork,
+      const long int* liwork, long int* info)
+{
+#if HAVE_LAPACK 
+  // call LAPACK dsyevd 
+  DSYEVD_FORTRAN(jobz, uplo, n, a, lda, w, work, lwork, iwork, liwork, info);
+#else 
+  DUNE_THROW(NotImplemented,"eigenValuesSymLapackCall: LAPACK not found!");
+#endif
+}
+
+void eigenValuesSymRangeLapackCall(
+      const char* jobz, const char* range, const char* uplo,
+      const long int* n, double* a, const long int* lda,
+      const double* vl, const double* vu, const long int* il, const long int* iu,
+      const double* abstol, long int* m, double* w, double* z, const long int* ldz,
+      long int* isuppz, double* work, const long int* lwork, long int* iwork,
+      const long int* liwork, long int* info)
+{
+#if HAVE_LAPACK 
+  // call LAPACK dsyevr 
+  DSYEVR_FORTRAN(jobz, range, uplo, n, a, lda, vl, vu, il, iu, abstol, m, w,
+                 z, ldz, isuppz, work, lwork, iwork, liwork, info);
+#else 
+  DUNE_THROW(NotImplemented,"eigenValuesSymRangeLapackCall: LAPACK not found!");
+#endif
+}
+
+} // end namespace DynamicMatrixHelp 
 
 } // end namespace Dune 
 #endif
@@ -1,6 +1,12 @@
 #ifndef DUNE_DYNMATRIXEIGENVALUES_HH
 #define DUNE_DYNMATRIXEIGENVALUES_HH
 
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
 #include "dynmatrix.hh"
 
 /*!
@@ -22,62 +28,340 @@ extern void eigenValuesNonsymLapackCall(
     const long int* ldvl, double* vr, const long int* ldvr, double* work,
     const long int* lwork, const long int* info);
 
-/** \brief calculates the eigenvalues of a symmetric field matrix 
-    \param[in]  matrix matrix eigenvalues are calculated for 
-    \param[out] eigenValues FieldVector that contains eigenvalues in 
-                ascending order 
+extern void eigenValuesSymLapackCall(
+    const char* jobz, const char* uplo, const long
+    int* n, double* a, const long int* lda, double* w,
+    double* work, const long int* lwork, long int* iwork,
+    const long int* liwork, long int* info);
+
+extern void eigenValuesSymRangeLapackCall(
+    const char* jobz, const char* range, const char* uplo,
+    const long int* n, double* a, const long int* lda,
+    const double* vl, const double* vu, const long int* il, const long int* iu,
+    const double* abstol, long int* m, double* w, double* z, const long int* ldz,
+    long int* isuppz, double* work, const long int* lwork, long int* iwork,
+    const long int* liwork, long int* info);
+
+} // end namespace DynamicMatrixHelp
+
+/** \brief Eigenvalue solver for dense matrices of dynamic size that
+    keeps its workspace between calls
 
-    \note LAPACK::dgeev is used to calculate the eigen values 
+    The LAPACK routines need a copy of the matrix and some working memory
+    whose optimal size is known only after a workspace query. The solver
+    allocates this memory on the heap, performs the workspace query
+    once for each problem size and reuses both for subsequent calls.
+    Solving many problems of the same size therefore allocates memory
+    only in the first call.
+
+    Symmetric problems are solved either by divide and conquer (dsyevd)
+    or by the method of relatively robust representations (dsyevr).
+    Computing only a subset of the eigenvalues, selected by index or by
+    value, always uses dsyevr.
+
+    The input can be any DenseMatrix, e.g. a DenseMatrixView of
+    external memory, it is only read while filling the workspace.
+
+    Eigenvectors are returned as the rows of a matrix, row i belongs to
+    eigenvalue i.
+
+    \note All computations are done in double precision.
 */
-template <typename K, class C>
-static void eigenValuesNonSym(const DynamicMatrix<K>& matrix,
-                              DynamicVector<C>& eigenValues)
+template <class K>
+class DynamicEigenSolver
 {
+public:
+  //! \brief Algorithm used for symmetric matrices
+  enum Method {
+    //! \brief divide and conquer (dsyevd)
+    divideAndConquer,
+    //! \brief relatively robust representations (dsyevr)
+    relativelyRobust
+  };
+
+  typedef std::size_t size_type;
+
+  //! \brief Constructor, no memory is allocated before the first solve
+  explicit DynamicEigenSolver (Method method = relativelyRobust) :
+    method_(method), queryRoutine_(0), queryJob_(0), queryN_(-1),
+    lwork_(0), liwork_(0)
+  {}
+
+  /** \brief calculates the eigenvalues of a symmetric matrix
+      \param[in]  matrix matrix eigenvalues are calculated for
+      \param[out] eigenvalues eigenvalues in ascending order
+  */
+  template <class M>
+  void eigenValues (const DenseMatrix<M>& matrix,
+                    DynamicVector<K>& eigenvalues)
+  {
+    symmetric(matrix, 'n', 'a', 0.0, 0.0, 0, 0, eigenvalues, 0);
+  }
+
+  /** \brief calculates eigenvalues and eigenvectors of a symmetric matrix
+      \param[in]  matrix matrix eigenvalues are calculated for
+      \param[out] eigenvalues eigenvalues in ascending order
+      \param[out] eigenvectors row i is the normalized eigenvector for
+                  eigenvalues[i]
+  */
+  template <class M>
+  void eigenValuesVectors (const DenseMatrix<M>& matrix,
+                           DynamicVector<K>& eigenvalues,
+                           DynamicMatrix<K>& eigenvectors)
+  {
+    symmetric(matrix, 'v', 'a', 0.0, 0.0, 0, 0, eigenvalues, &eigenvectors);
+  }
+
+  /** \brief calculates a range of eigenvalues of a symmetric matrix
+      selected by index
+
+      If all eigenvalues are sorted ascendingly, those with index in
+      [first,last) are computed.
+
+      \param[in]  matrix matrix eigenvalues are calculated for
+      \param[in]  first index of the smallest wanted eigenvalue
+      \param[in]  last one past the index of the largest wanted eigenvalue
+      \param[out] eigenvalues the last-first eigenvalues in ascending order
+      \param[out] eigenvectors if not null, row i is set to the
+                  eigenvector for eigenvalues[i]
+  */
+  template <class M>
+  void eigenValuesRange (const DenseMatrix<M>& matrix,
+                         size_type first, size_type last,
+                         DynamicVector<K>& eigenvalues,
+                         DynamicMatrix<K>* eigenvectors = 0)
+  {
+    if (first >= last || last > matrix.rows())
+      DUNE_THROW(RangeError, "eigenValuesRange: invalid index range ["
+                 << first << "," << last << ") for " << matrix.rows() << " eigenvalues");
+    symmetric(matrix, eigenvectors ? 'v' : 'n', 'i', 0.0, 0.0,
+              first + 1, last, eigenvalues, eigenvectors);
+  }
+
+  /** \brief calculates the eigenvalues of a symmetric matrix inside the
+      interval (lower,upper]
+
+      \param[in]  matrix matrix eigenvalues are calculated for
+      \param[in]  lower lower bound of the interval, not included
+      \param[in]  upper upper bound of the interval
+      \param[out] eigenvalues the eigenvalues found, in ascending order
+      \param[out] eigenvectors if not null, row i is set to the
+                  eigenvector for eigenvalues[i]
+  */
+  template <class M>
+  void eigenValuesInterval (const DenseMatrix<M>& matrix,
+                            const K& lower, const K& upper,
+                            DynamicVector<K>& eigenvalues,
+                            DynamicMatrix<K>* eigenvectors = 0)
   {
-    const long int N = matrix.rows();
+    if (!(lower < upper))
+      DUNE_THROW(RangeError, "eigenValuesInterval: empty interval ("
+                 << lower << "," << upper << "]");
+    symmetric(matrix, eigenvectors ? 'v' : 'n', 'v', lower, upper, 0, 0,
+              eigenvalues, eigenvectors);
+  }
+
+  /** \brief calculates the eigenvalues of a nonsymmetric matrix
+      \param[in]  matrix matrix eigenvalues are calculated for
+      \param[out] eigenValues the (complex) eigenvalues, in no particular
+                  order
+
+      \note LAPACK::dgeev is used to calculate the eigen values
+  */
+  template <class M, class C>
+  void eigenValuesNonSym (const DenseMatrix<M>& matrix,
+                          DynamicVector<C>& eigenValues)
+  {
+    const long int N = copyMatrix(matrix);
     const char jobvl = 'n';
     const char jobvr = 'n';
+    long int info = 0;
+
+    if (w_.size() < size_type(2 * N))
+      w_.resize(2 * N);
+    double* eigenR = &w_[0];
+    double* eigenI = &w_[0] + N;
+
+    if (needsQuery('g', jobvr, N))
+    {
+      double optimal = 0;
+      const long int query = -1;
+      DynamicMatrixHelp::eigenValuesNonsymLapackCall(&jobvl, &jobvr, &N, &a_[0], &N,
+                                                     eigenR, eigenI, 0, &N, 0, &N,
+                                                     &optimal, &query, &info);
+      lwork_ = std::max(long(optimal), 3 * N);
+      liwork_ = 0;
+    }
+    reserveWork();
+
+    DynamicMatrixHelp::eigenValuesNonsymLapackCall(&jobvl, &jobvr, &N, &a_[0], &N,
+                                                   eigenR, eigenI, 0, &N, 0, &N,
+                                                   &work_[0], &lwork_, &info);
+    if (info != 0)
+      DUNE_THROW(InvalidStateException,
+                 "eigenValuesNonSym: Eigenvalue calculation failed (info = " << info << ")!");
+
+    if (eigenValues.size() != size_type(N))
+      eigenValues.resize(N);
+    for (long int i=0; i<N; ++i)
+      eigenValues[i] = std::complex<double>(eigenR[i], eigenI[i]);
+  }
+
+  //! \brief number of bytes currently allocated for the workspace
+  size_type workspaceSize () const
+  {
+    return (a_.capacity() + w_.capacity() + z_.capacity() + work_.capacity()) * sizeof(double)
+           + (iwork_.capacity() + isuppz_.capacity()) * sizeof(long int);
+  }
 
+private:
+  //! copy the matrix into the column major LAPACK array, returns the size
+  template <class M>
+  long int copyMatrix (const DenseMatrix<M>& matrix)
+  {
+    assert(matrix.rows() == matrix.cols());
+    const size_type n = matrix.rows();
+    if (a_.size() < n * n)
+      a_.resize(n * n);
+    // the matrix is symmetric or the eigenvalues of its transpose are
+    // computed, so the row major copy can be used as it is
+    for (size_type i=0; i<n; ++i)
+      for (size_type j=0; j<n; ++j)
+        a_[i * n + j] = matrix[i][j];
+    return n;
+  }
 
-    // matrix to put into dgeev 
-    double matrixVector[N * N]; 
+  //! whether the optimal workspace for this routine, job and size is unknown
+  bool needsQuery (char routine, char job, long int n)
+  {
+    if (routine == queryRoutine_ && job == queryJob_ && n == queryN_)
+      return false;
+    queryRoutine_ = routine;
+    queryJob_ = job;
+    queryN_ = n;
+    return true;
+  }
 
-    // copy matrix  
-    int row = 0;
-    for(int i=0; i<N; ++i) 
+  void reserveWork ()
+  {
+    if (work_.size() < size_type(std::max(lwork_, 1L)))
+      work_.resize(std::max(lwork_, 1L));
+    if (iwork_.size() < size_type(std::max(liwork_, 1L)))
+      iwork_.resize(std::max(liwork_, 1L));
+  }
+
+  template <class M>
+  void symmetric (const DenseMatrix<M>& matrix, char jobz, char range,
+                  double vl, double vu, long int il, long int iu,
+                  DynamicVector<K>& eigenvalues, DynamicMatrix<K>* eigenvectors)
+  {
+    const long int N = copyMatrix(matrix);
+    const char uplo = 'u';
+    const bool useDsyevd = (method_ == divideAndConquer && range == 'a');
+    long int info = 0;
+    long int m = N;
+
+    if (w_.size() < size_type(N))
+      w_.resize(N);
+    if (jobz == 'v' && z_.size() < size_type(N * N))
+      z_.resize(N * N);
+    if (!useDsyevd && isuppz_.size() < size_type(2 * N))
+      isuppz_.resize(2 * N);
+    double* z = (jobz == 'v') ? &z_[0] : &w_[0];
+
+    if (needsQuery(useDsyevd ? 'd' : 'r', jobz, N))
     {
-      for(int j=0; j<N; ++j, ++row) 
+      double optimal = 0;
+      // LAPACK may store a 32 bit integer only, clear the upper half
+      long int ioptimal = 0;
+      const long int query = -1;
+      if (useDsyevd)
+        DynamicMatrixHelp::eigenValuesSymLapackCall(&jobz, &uplo, &N, &a_[0], &N, &w_[0],
+                                                    &optimal, &query, &ioptimal, &query, &info);
+      else
       {
-        matrixVector[ row ] = matrix[ i ][ j ];
+        const double abstol = 0.0;
+        DynamicMatrixHelp::eigenValuesSymRangeLapackCall(&jobz, &range, &uplo, &N, &a_[0], &N,
+                                                         &vl, &vu, &il, &iu, &abstol, &m, &w_[0],
+                                                         z, &N, &isuppz_[0], &optimal, &query,
+                                                         &ioptimal, &query, &info);
       }
+      lwork_ = long(optimal);
+      liwork_ = ioptimal;
     }
+    reserveWork();
 
-    // working memory 
-    double eigenR[N]; 
-    double eigenI[N];
-    double work[3*N];
-
-    // return value information 
-    long int info = 0;
-    long int lwork = 3*N;
+    if (useDsyevd)
+    {
+      DynamicMatrixHelp::eigenValuesSymLapackCall(&jobz, &uplo, &N, &a_[0], &N, &w_[0],
+                                                  &work_[0], &lwork_, &iwork_[0], &liwork_, &info);
+      // dsyevd overwrites the matrix with the eigenvectors
+      z = &a_[0];
+    }
+    else
+    {
+      const double abstol = 0.0;
+      m = 0;
+      DynamicMatrixHelp::eigenValuesSymRangeLapackCall(&jobz, &range, &uplo, &N, &a_[0], &N,
+                                                       &vl, &vu, &il, &iu, &abstol, &m, &w_[0],
+                                                       z, &N, &isuppz_[0], &work_[0], &lwork_,
+                                                       &iwork_[0], &liwork_, &info);
+    }
+    if (info != 0)
+      DUNE_THROW(InvalidStateException,
+                 "eigenValues: Eigenvalue calculation failed (info = " << info << ")!");
 
-    // call LAPACK routine (see fmatrixev_ext.cc)
-    eigenValuesNonsymLapackCall(&jobvl, &jobvr, &N, &matrixVector[0], &N, 
-                                &eigenR[0], &eigenI[0], 0, &N, 0, &N, &work[0],
-                                &lwork, &info);
+    if (eigenvalues.size() != size_type(m))
+      eigenvalues.resize(m);
+    std::copy(w_.begin(), w_.begin() + m, eigenvalues.begin());
 
-    if( info != 0 ) 
+    if (eigenvectors)
     {
-      std::cerr << "For matrix " << matrix << " eigenvalue calculation failed! " << std::endl;
-      DUNE_THROW(InvalidStateException,"eigenValues: Eigenvalue calculation failed!");
+      if (eigenvectors->rows() != size_type(m) || (m > 0 && eigenvectors->cols() != size_type(N)))
+        eigenvectors->resize(m, N);
+      // column j of the column major result is eigenvector j
+      for (long int j=0; j<m; ++j)
+        std::copy(z + j * N, z + (j + 1) * N, (*eigenvectors)[j].begin());
     }
-    for (int i=0;i<N;++i)
-      eigenValues[i] = std::complex<double>(eigenR[i], eigenI[i]);
   }
-}
 
-}
+  Method method_;
+
+  // routine, job and size of the last workspace query
+  char queryRoutine_;
+  char queryJob_;
+  long int queryN_;
+  long int lwork_;
+  long int liwork_;
+
+  std::vector<double> a_;
+  std::vector<double> w_;
+  std::vector<double> z_;
+  std::vector<double> work_;
+  std::vector<long int> iwork_;
+  std::vector<long int> isuppz_;
+};
+
+namespace DynamicMatrixHelp {
 
+/** \brief calculates the eigenvalues of a nonsymmetric matrix
+    \param[in]  matrix matrix eigenvalues are calculated for 
+    \param[out] eigenValues the (complex) eigenvalues
+
+    \note LAPACK::dgeev is used to calculate the eigen values. The
+    working memory is allocated on the heap for each call, use
+    DynamicEigenSolver to reuse it for several problems.
+*/
+template <typename K, class C>
+static void eigenValuesNonSym(const DynamicMatrix<K>& matrix,
+                              DynamicVector<C>& eigenValues)
+{
+  DynamicEigenSolver<K> solver;
+  solver.eigenValuesNonSym(matrix, eigenValues);
 }
+
+} // end namespace DynamicMatrixHelp
+
+} // end namespace Dune
 /** @} */
 #endif
@@ -12,6 +12,7 @@
 #include "exceptions.hh"
 #include "genericiterator.hh"
 
+#include <utility>
 #include <vector>
 #include "densevector.hh"
 
@@ -69,7 +70,76 @@ namespace Dune {
       _data(x._data)
 	{}
 
+#if HAVE_RVALUE_REFERENCES
+	//! Move constructor, takes over the memory of x
+	DynamicVector (DynamicVector && x) throw() :
+      _data(std::move(x._data))
+	{}
+
+	//! Constructor adopting the memory of x without copying
+	explicit DynamicVector (std::vector<K> && x) :
+      _data(std::move(x))
+	{}
+#endif
+
+	//! Constructor copying the entries of any other dense vector
+	template< class V >
+	explicit DynamicVector (const DenseVector<V> & x) :
+      _data(x.size())
+	{
+      for (size_type i=0; i<x.size(); i++)
+        _data[i] = x[i];
+	}
+
+	//! Constructor evaluating a vector expression
+	template< class E >
+	DynamicVector (const DenseVectorExpression<E> & e) :
+      _data(e.asImp().size())
+	{
+      Base::operator=(e);
+	}
+
     using Base::operator=;
+
+    //! Copy assignment, reuses the memory of this vector if possible
+    DynamicVector& operator= (const DynamicVector & x)
+    {
+      _data = x._data;
+      return *this;
+    }
+
+#if HAVE_RVALUE_REFERENCES
+    //! Move assignment, takes over the memory of x
+    DynamicVector& operator= (DynamicVector && x) throw()
+    {
+      _data = std::move(x._data);
+      return *this;
+    }
+#endif
+
+    //! Exchange the entries with x without copying
+    void swap (DynamicVector & x)
+    {
+      _data.swap(x._data);
+    }
+
+    /** \brief Exchange the entries with a std::vector without copying
+
+        This allows to adopt an externally filled buffer and to hand
+        the entries back to the caller.
+    */
+    void swap (std::vector<K> & x)
+    {
+      _data.swap(x);
+    }
+
+    //! Assign a vector expression, resizing this vector if necessary
+    template< class E >
+    DynamicVector& operator= (const DenseVectorExpression<E> & e)
+    {
+      _data.resize(e.asImp().size());
+      return Base::operator=(e);
+    }
     
     //==== forward some methods of std::vector
     /** \brief Number of elements for which memory has been allocated.
@@ -4,6 +4,8 @@
 #include <limits>
 #include <algorithm>
 #include <cstdlib>
+#include <cmath>
+#include <dune/common/densevector.hh>
 #include <dune/common/fvector.hh>
 
 namespace Dune {
@@ -29,7 +31,7 @@ namespace Dune {
     template<class T, typename A>
     struct EpsilonType<std::vector<T, A> > {
       //! The epsilon type corresponding to value type std::vector<T, A>
-      typedef EpsilonType<T> Type;
+      typedef typename EpsilonType<T>::Type Type;
     };
     //! Specialization of EpsilonType for Dune::FieldVector
     /**
@@ -40,7 +42,7 @@ namespace Dune {
     template<class T, int n>
     struct EpsilonType<FieldVector<T, n> > {
       //! The epsilon type corresponding to value type Dune::FieldVector<T, n>
-      typedef EpsilonType<T> Type;
+      typedef typename EpsilonType<T>::Type Type;
     };
 
     // default epsilon
@@ -61,41 +63,126 @@ namespace Dune {
     };
 
     namespace Detail {
-      // basic comparison
-      template<class T, CmpStyle style = defaultCmpStyle>
-      struct eq_t;
+      // basic comparison of scalars
+      template<class T, CmpStyle style>
+      struct scalar_eq_t;
       template<class T>
-      struct eq_t<T, relativeWeak> {
+      struct scalar_eq_t<T, relativeWeak> {
         static bool eq(const T &first,
                        const T &second,
                        typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T>::value())
         { return std::abs(first - second) <= epsilon*std::max(std::abs(first), std::abs(second)); }
       };
       template<class T>
-      struct eq_t<T, relativeStrong> {
+      struct scalar_eq_t<T, relativeStrong> {
         static bool eq(const T &first,
                        const T &second,
                        typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T>::value())
         { return std::abs(first - second) <= epsilon*std::min(std::abs(first), std::abs(second)); }
       };
       template<class T>
-      struct eq_t<T, absolute> {
+      struct scalar_eq_t<T, absolute> {
         static bool eq(const T &first,
                        const T &second,
                        typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T>::value())
         { return std::abs(first-second) <= epsilon; }
       };
-      template<class T, CmpStyle cstyle>
-      struct eq_t<std::vector<T>, cstyle> {
-        static bool eq(const std::vector<T> &first,
-                       const std::vector<T> &second,
+      // basic comparison, specialized for containers below
+      template<class T, CmpStyle style = defaultCmpStyle>
+      struct eq_t : scalar_eq_t<T, style> {};
+      // the value epsilon is scaled with for entries of magnitude a and b
+      template<CmpStyle style>
+      struct cmp_scale;
+      template<>
+      struct cmp_scale<relativeWeak> {
+        template<class R>
+        static R scale(R a, R b) { return a > b ? a : b; }
+      };
+      template<>
+      struct cmp_scale<relativeStrong> {
+        template<class R>
+        static R scale(R a, R b) { return a < b ? a : b; }
+      };
+      template<>
+      struct cmp_scale<absolute> {
+        template<class R>
+        static R scale(R, R) { return R(1); }
+      };
+
+      // Compares the entries [begin,end) of a and b, which only need an
+      // operator[], and adds them to result.  The loop has no early exit
+      // and only branch free operations, so it is vectorized for float and
+      // double entries.  Positions are only searched for in blocks which
+      // contain the first mismatch or a new maximal deviation.
+      template<CmpStyle style, class A, class B, class R>
+      void compare_block(const A &a, const B &b, std::size_t begin, std::size_t end,
+                         R epsilon, RangeCmpResult<R> &result)
+      {
+        std::size_t mismatches = 0;
+        R deviation = 0;
+        for(std::size_t i = begin; i < end; ++i) {
+          R d = std::abs(a[i] - b[i]);
+          R s = cmp_scale<style>::scale(R(std::abs(a[i])), R(std::abs(b[i])));
+          mismatches += !(d <= epsilon*s);
+          deviation = d > deviation ? d : deviation;
+        }
+        if(mismatches > 0 && result.mismatches == 0)
+          for(std::size_t i = begin; i < end; ++i) {
+            R d = std::abs(a[i] - b[i]);
+            if(!(d <= epsilon*cmp_scale<style>::scale(R(std::abs(a[i])), R(std::abs(b[i]))))) {
+              result.firstMismatch = i;
+              break;
+            }
+          }
+        result.mismatches += mismatches;
+        if(deviation > result.maxDeviation) {
+          result.maxDeviation = deviation;
+          for(std::size_t i = begin; i < end; ++i)
+            if(std::abs(a[i] - b[i]) == deviation) {
+              result.maxDeviationIndex = i;
+              break;
+            }
+        }
+      }
+
+      // compares the first size entries of a and b in blocks, stopping
+      // after the first block with a mismatch if requested
+      template<CmpStyle style, class A, class B, class R>
+      RangeCmpResult<R> compare_range(const A &a, const B &b, std::size_t size,
+                                      R epsilon, bool stopAtMismatch = false)
+      {
+        RangeCmpResult<R> result;
+        result.size = size;
+        result.mismatches = 0;
+        result.firstMismatch = size;
+        result.maxDeviation = 0;
+        result.maxDeviationIndex = 0;
+        const std::size_t blockSize = 1024;
+        for(std::size_t begin = 0; begin < size; begin += blockSize) {
+          compare_block<style>(a, b, begin, std::min(size, begin + blockSize), epsilon, result);
+          if(stopAtMismatch && result.mismatches > 0)
+            break;
+        }
+        return result;
+      }
+
+      // counts the entries beyond the end of the shorter range as mismatches
+      template<class R>
+      void add_size_mismatch(RangeCmpResult<R> &result, std::size_t size1, std::size_t size2)
+      {
+        std::size_t size = std::max(size1, size2);
+        result.mismatches += size - result.size;
+        result.size = size;
+      }
+
+      template<class T, class A, CmpStyle cstyle>
+      struct eq_t<std::vector<T, A>, cstyle> {
+        static bool eq(const std::vector<T, A> &first,
+                       const std::vector<T, A> &second,
                        typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T>::value()) {
-          unsigned int size = first.size();
-          if(size != second.size()) return false;
-          for(unsigned int i = 0; i < size; ++i)
-            if(!eq_t<T, cstyle>(first[i], second[i], epsilon))
-              return false;
-          return true;
+          if(first.size() != second.size()) return false;
+          if(first.empty()) return true;
+          return compare_range<cstyle>(&first[0], &second[0], first.size(), epsilon, true).equal();
         }
       };
       template<class T, int n, CmpStyle cstyle>
@@ -103,10 +190,7 @@ namespace Dune {
         static bool eq(const Dune::FieldVector<T, n> &first,
                        const Dune::FieldVector<T, n> &second,
                        typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T>::value()) {
-          for(int i = 0; i < n; ++i)
-            if(!eq_t<T, cstyle>(first[i], second[i], epsilon))
-              return false;
-          return true;
+          return compare_range<cstyle>(first, second, n, epsilon, true).equal();
         }
       };
     } // namespace Detail
@@ -175,6 +259,59 @@ namespace Dune {
             typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T, defaultCmpStyle>::value())
     { return le<T, defaultCmpStyle>(first, second, epsilon); }
 
+    // comparison of ranges
+    template <CmpStyle style, class It1, class It2>
+    RangeCmpResult<typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type>
+    compareRanges(It1 first1, It1 last1, It2 first2,
+                  typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type epsilon)
+    { return Detail::compare_range<style>(first1, first2, std::distance(first1, last1), epsilon); }
+    template <CmpStyle style, class V1, class V2>
+    RangeCmpResult<typename EpsilonType<typename DenseVector<V1>::value_type>::Type>
+    compare(const DenseVector<V1> &first,
+            const DenseVector<V2> &second,
+            typename EpsilonType<typename DenseVector<V1>::value_type>::Type epsilon)
+    {
+      RangeCmpResult<typename EpsilonType<typename DenseVector<V1>::value_type>::Type> result
+        = Detail::compare_range<style>(first, second, std::min(first.size(), second.size()), epsilon);
+      Detail::add_size_mismatch(result, first.size(), second.size());
+      return result;
+    }
+    template <CmpStyle style, class T, class A>
+    RangeCmpResult<typename EpsilonType<T>::Type>
+    compare(const std::vector<T, A> &first,
+            const std::vector<T, A> &second,
+            typename EpsilonType<T>::Type epsilon)
+    {
+      std::size_t size = std::min(first.size(), second.size());
+      const T *data1 = first.empty() ? 0 : &first[0];
+      const T *data2 = second.empty() ? 0 : &second[0];
+      RangeCmpResult<typename EpsilonType<T>::Type> result
+        = Detail::compare_range<style>(data1, data2, size, epsilon);
+      Detail::add_size_mismatch(result, first.size(), second.size());
+      return result;
+    }
+
+    // default template arguments
+    template <class It1, class It2>
+    RangeCmpResult<typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type>
+    compareRanges(It1 first1, It1 last1, It2 first2,
+                  typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type epsilon
+                  = DefaultEpsilon<typename std::iterator_traits<It1>::value_type, defaultCmpStyle>::value())
+    { return compareRanges<defaultCmpStyle>(first1, last1, first2, epsilon); }
+    template <class V1, class V2>
+    RangeCmpResult<typename EpsilonType<typename DenseVector<V1>::value_type>::Type>
+    compare(const DenseVector<V1> &first,
+            const DenseVector<V2> &second,
+            typename EpsilonType<typename DenseVector<V1>::value_type>::Type epsilon
+            = DefaultEpsilon<typename DenseVector<V1>::value_type, defaultCmpStyle>::value())
+    { return compare<defaultCmpStyle>(first, second, epsilon); }
+    template <class T, class A>
+    RangeCmpResult<typename EpsilonType<T>::Type>
+    compare(const std::vector<T, A> &first,
+            const std::vector<T, A> &second,
+            typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T, defaultCmpStyle>::value())
+    { return compare<defaultCmpStyle>(first, second, epsilon); }
+
     // rounding operations
     namespace Detail {
       template<class I, class T, CmpStyle cstyle = defaultCmpStyle, RoundingStyle rstyle = defaultRoundingStyle>
@@ -417,4 +554,18 @@ namespace Dune {
   trunc(const ValueType &val) const
   { return Dune::FloatCmp::trunc<I, ValueType, cstyle, rstyle_>(val, epsilon_); }
 
+  template<class T, FloatCmp::CmpStyle cstyle_, FloatCmp::RoundingStyle rstyle_>
+  template<class It1, class It2>
+  FloatCmp::RangeCmpResult<typename FloatCmpOps<T, cstyle_, rstyle_>::EpsilonType>
+  FloatCmpOps<T, cstyle_, rstyle_>::
+  compareRanges(It1 first1, It1 last1, It2 first2) const
+  { return Dune::FloatCmp::compareRanges<cstyle>(first1, last1, first2, epsilon_); }
+
+  template<class T, FloatCmp::CmpStyle cstyle_, FloatCmp::RoundingStyle rstyle_>
+  template<class V1, class V2>
+  FloatCmp::RangeCmpResult<typename FloatCmpOps<T, cstyle_, rstyle_>::EpsilonType>
+  FloatCmpOps<T, cstyle_, rstyle_>::
+  compare(const DenseVector<V1> &first, const DenseVector<V2> &second) const
+  { return Dune::FloatCmp::compare<cstyle>(first, second, epsilon_); }
+
 } //namespace Dune
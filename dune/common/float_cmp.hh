@@ -88,10 +88,34 @@
   defaults from the previous paragraph apply).  This may be more convenient if
   you write your own class utilizing floating point comparisons, and you want
   the user of you class to specify epsilon and compare style.
+
+  @section Ranges Comparing ranges
+
+  To compare whole vectors, e.g. a computed solution with a reference
+  solution, use @link Dune::FloatCmp::compare compare()@endlink for
+  DenseVectors and std::vectors, or @link Dune::FloatCmp::compareRanges
+  compareRanges()@endlink for iterator ranges and raw arrays.  They compare
+  entrywise in the given style and return a Dune::FloatCmp::RangeCmpResult
+  with the number of mismatching entries, the index of the first one and
+  the largest absolute deviation.  The entries are processed in blocks
+  without branches depending on the values, so the compiler can vectorize
+  the comparison of float and double entries.
+  @code
+    Dune::FloatCmp::RangeCmpResult<double> cmp = Dune::FloatCmp::compare(x, reference, 1e-10);
+    if(!cmp.equal())
+      std::cerr << cmp.mismatches << " entries differ, the first one at "
+                << cmp.firstMismatch << std::endl;
+  @endcode
  */
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 //! Dune namespace
 namespace Dune {
+  template<class V> class DenseVector;
+
   //! FloatCmp namespace
   //! @ingroup FloatCmp
   namespace FloatCmp {
@@ -267,6 +291,82 @@ namespace Dune {
     template<class I, class T, CmpStyle cstyle /*= defaultCmpStyle*/, RoundingStyle rstyle /*= defaultRoundingStyle*/>
     I trunc(const T &val, typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T, cstyle>::value());
 
+    // comparison of ranges
+
+    //! Result of an entrywise comparison of two ranges
+    /**
+     * @ingroup FloatCmp
+     * @tparam R The epsilon type of the entries
+     */
+    template<class R>
+    struct RangeCmpResult {
+      //! number of compared entries, the size of the longer range
+      std::size_t size;
+      //! number of entries that do not compare equal
+      std::size_t mismatches;
+      //! index of the first entry that does not compare equal, size if there is none
+      std::size_t firstMismatch;
+      //! largest absolute deviation |first[i]-second[i]|, ignoring NaNs
+      R maxDeviation;
+      //! index of the first entry with the largest absolute deviation
+      std::size_t maxDeviationIndex;
+
+      //! whether all entries compare equal
+      bool equal() const { return mismatches == 0; }
+    };
+
+    //! compare two ranges entrywise using epsilon
+    /**
+     * @tparam style How to compare, there is an overload using defaultCmpStyle.
+     * @tparam It1   Random access iterator or pointer type of the first range
+     * @tparam It2   Random access iterator or pointer type of the second range
+     * @param first1  begin of the first range
+     * @param last1   end of the first range
+     * @param first2  begin of the second range, of the same length
+     * @param epsilon The epsilon to use for every pair of entries
+     *
+     * Entry i compares equal if eq<T, style>(first1[i], first2[i], epsilon)
+     * is true.
+     */
+    template <CmpStyle style, class It1, class It2>
+    RangeCmpResult<typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type>
+    compareRanges(It1 first1, It1 last1, It2 first2,
+                  typename EpsilonType<typename std::iterator_traits<It1>::value_type>::Type epsilon
+                  = DefaultEpsilon<typename std::iterator_traits<It1>::value_type, style>::value());
+
+    //! compare two dense vectors entrywise using epsilon
+    /**
+     * @tparam style How to compare, there is an overload using defaultCmpStyle.
+     * @param first   left operand
+     * @param second  right operand
+     * @param epsilon The epsilon to use for every pair of entries
+     *
+     * If the sizes differ, the entries beyond the end of the shorter vector
+     * are counted as mismatches.
+     */
+    template <CmpStyle style, class V1, class V2>
+    RangeCmpResult<typename EpsilonType<typename DenseVector<V1>::value_type>::Type>
+    compare(const DenseVector<V1> &first,
+            const DenseVector<V2> &second,
+            typename EpsilonType<typename DenseVector<V1>::value_type>::Type epsilon
+            = DefaultEpsilon<typename DenseVector<V1>::value_type, style>::value());
+
+    //! compare two std::vectors entrywise using epsilon
+    /**
+     * @tparam style How to compare, there is an overload using defaultCmpStyle.
+     * @param first   left operand
+     * @param second  right operand
+     * @param epsilon The epsilon to use for every pair of entries
+     *
+     * If the sizes differ, the entries beyond the end of the shorter vector
+     * are counted as mismatches.
+     */
+    template <CmpStyle style, class T, class A>
+    RangeCmpResult<typename EpsilonType<T>::Type>
+    compare(const std::vector<T, A> &first,
+            const std::vector<T, A> &second,
+            typename EpsilonType<T>::Type epsilon = DefaultEpsilon<T, style>::value());
+
     //! @}
     // group FloatCmp
   } //namespace FloatCmp
@@ -374,6 +474,15 @@ namespace Dune {
      */
     template<class I>
     I trunc(const ValueType &val) const;
+
+    //! compare two ranges entrywise, see FloatCmp::compareRanges()
+    template<class It1, class It2>
+    FloatCmp::RangeCmpResult<EpsilonType> compareRanges(It1 first1, It1 last1, It2 first2) const;
+
+    //! compare two dense vectors entrywise, see FloatCmp::compare()
+    template<class V1, class V2>
+    FloatCmp::RangeCmpResult<EpsilonType> compare(const DenseVector<V1> &first,
+                                                  const DenseVector<V2> &second) const;
  
   };
 
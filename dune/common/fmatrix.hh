@@ -14,6 +14,7 @@
 #include <dune/common/densematrix.hh>
 #include <dune/common/precision.hh>
 #include <dune/common/static_assert.hh>
+#include <dune/common/unrolledkernels.hh>
 
 namespace Dune
 {
@@ -104,24 +105,6 @@ namespace Dune
     //===== assignment
     using Base::operator=;
 
-    // To be removed!
-#if 0
-    //! Multiplies M from the left to this matrix
-    FieldMatrix& leftmultiply (const FieldMatrix<K,rows,rows>& M)
-    {
-      FieldMatrix<K,rows,cols> C(*this);
-      
-      for (size_type i=0; i<rows; i++)
-        for (size_type j=0; j<cols; j++) {
-          (*this)[i][j] = 0;
-          for (size_type k=0; k<rows; k++)
-            (*this)[i][j] += M[i][k]*C[k][j];
-        }
-      
-      return *this;
-    }
-#endif
- 
     //! Multiplies M from the left to this matrix, this matrix is not modified
     template<int l>
     FieldMatrix<K,l,cols> leftmultiplyany (const FieldMatrix<K,l,rows>& M) const
@@ -138,17 +121,19 @@ namespace Dune
       return C;
     }
 
+    //! Multiplies M from the left to this matrix
+    FieldMatrix& leftmultiply (const FieldMatrix<K,rows,rows>& M)
+    {
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::leftmultiply(*this, M);
+      return *this;
+    }
+
+    using Base::leftmultiply;
+
     //! Multiplies M from the right to this matrix
     FieldMatrix& rightmultiply (const FieldMatrix<K,cols,cols>& M)
     {
-      FieldMatrix<K,rows,cols> C(*this);
-      
-      for (size_type i=0; i<rows; i++)
-        for (size_type j=0; j<cols; j++) {
-          (*this)[i][j] = 0;
-          for (size_type k=0; k<cols; k++)
-            (*this)[i][j] += C[i][k]*M[k][j];
-        }
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::rightmultiply(*this, M);
       return *this;
     }
 
@@ -168,6 +153,91 @@ namespace Dune
       return C;
     }
     
+    //===== linear maps, unrolled for small sizes
+
+    //! y = A x
+    template<class X, class Y>
+    void mv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mv(*this, x, y);
+    }
+
+    //! y = A^T x
+    template<class X, class Y>
+    void mtv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mtv(*this, x, y);
+    }
+
+    //! y += A x
+    template<class X, class Y>
+    void umv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::umv(*this, x, y);
+    }
+
+    //! y += A^T x
+    template<class X, class Y>
+    void umtv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::umtv(*this, x, y);
+    }
+
+    //! y -= A x
+    template<class X, class Y>
+    void mmv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mmv(*this, x, y);
+    }
+
+    //! y += alpha A x
+    template<class X, class Y>
+    void usmv (const K& alpha, const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::usmv(*this, alpha, x, y);
+    }
+
+    //! calculates the determinant of this matrix
+    K determinant () const
+    {
+      if (ROWS!=COLS)
+        DUNE_THROW(FMatrixError, "There is no determinant for a " << ROWS << "x" << COLS << " matrix!");
+      return UnrolledKernels::Determinant<ROWS,COLS>::apply(*this);
+    }
+
+    //! Compute inverse
+    void invert ()
+    {
+      if (ROWS!=COLS)
+        DUNE_THROW(FMatrixError, "Can't invert a " << ROWS << "x" << COLS << " matrix!");
+      if (!UnrolledKernels::Inverse<ROWS,COLS>::apply(*this))
+        DUNE_THROW(FMatrixError,"matrix is singular");
+    }
+
     // make this thing a matrix
     size_type mat_rows() const { return ROWS; }
     size_type mat_cols() const { return COLS; }
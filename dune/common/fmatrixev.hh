@@ -8,6 +8,14 @@
 #include <iostream>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if HAVE_STD_THREAD
+#include <thread>
+#endif
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
@@ -76,24 +84,25 @@ static void eigenValues(const FieldMatrix<K, 2, 2>& matrix,
   eigenvalues[1] = p + q;
 }
 
-/** \brief calculates the eigenvalues of a symmetric field matrix 
-    \param[in]  matrix matrix eigenvalues are calculated for 
-    \param[out] eigenvalues FieldVector that contains eigenvalues in 
-                ascending order 
+/** \brief calculates the eigenvalues of a symmetric field matrix
+    \param[in]  matrix matrix eigenvalues are calculated for
+    \param[out] eigenvalues FieldVector that contains eigenvalues in
+                ascending order
 
-    \note LAPACK::dsyev is used to calculate the eigenvalues 
-*/                
-template <int dim, typename K> 
-static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
-                        FieldVector<K, dim>& eigenvalues)  
+    \note LAPACK::dsyev is used to calculate the eigenvalues
+*/
+template <int dim, typename K>
+static void eigenValuesLapack(const FieldMatrix<K, dim, dim>& matrix,
+                              FieldVector<K, dim>& eigenvalues)
 {
   {
     const long int N = dim ;
     const char jobz = 'n'; // only calculate eigenvalues  
     const char uplo = 'u'; // use upper triangular matrix 
 
-    // length of matrix vector 
-    const long int w = N * N ;
+    // length of working memory, dsyev needs at least 3*N-1
+    enum { workSize = (dim * dim > 3 * dim) ? dim * dim : 3 * dim };
+    const long int w = workSize ;
 
     // matrix to put into dsyev 
     double matrixVector[dim * dim]; 
@@ -109,7 +118,7 @@ static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
     }
 
     // working memory 
-    double workSpace[dim * dim]; 
+    double workSpace[workSize]; 
 
     // return value information 
     long int info = 0;
@@ -125,6 +134,502 @@ static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
     }
   }
 }
+
+/** \brief calculates eigenvalues and eigenvectors of a symmetric field
+    matrix with the cyclic Jacobi method
+
+    The matrix is diagonalized by a sequence of plane rotations. The
+    method is very accurate and needs no external library, but its cost
+    grows like dim^3 per sweep, so it is meant for small matrices.
+
+    \param[in]  matrix matrix eigenvalues are calculated for
+    \param[out] eigenvalues FieldVector that contains eigenvalues in
+                ascending order
+    \param[out] eigenvectors if not null, row i is set to the normalized
+                eigenvector for eigenvalues[i]
+*/
+template <int dim, typename K>
+static void eigenValuesJacobi(const FieldMatrix<K, dim, dim>& matrix,
+                              FieldVector<K, dim>& eigenvalues,
+                              FieldMatrix<K, dim, dim>* eigenvectors = 0)
+{
+  FieldMatrix<K, dim, dim> a(matrix);
+  // columns of v are the eigenvectors
+  FieldMatrix<K, dim, dim> v(0.0);
+  for (int i=0; i<dim; ++i)
+    v[i][i] = 1.0;
+
+  // stop once the off-diagonal part is negligible relative to the
+  // matrix; the convergence is quadratic, so the cap is never reached
+  // for reasonable input
+  const int maxSweeps = 50;
+  const K eps = std::numeric_limits<K>::epsilon();
+  const K tolerance = eps * eps * a.frobenius_norm2();
+
+  for (int sweep=0; sweep<maxSweeps; ++sweep)
+  {
+    K off = 0.0;
+    for (int p=0; p<dim; ++p)
+      for (int q=p+1; q<dim; ++q)
+        off += a[p][q] * a[p][q];
+    if (!(off > tolerance))
+      break;
+
+    for (int p=0; p<dim; ++p)
+    {
+      for (int q=p+1; q<dim; ++q)
+      {
+        const K apq = a[p][q];
+        const K g = 100.0 * std::abs(apq);
+        // drop entries that are negligible compared to the diagonal
+        if (sweep > 3
+            && std::abs(a[p][p]) + g == std::abs(a[p][p])
+            && std::abs(a[q][q]) + g == std::abs(a[q][q]))
+        {
+          a[p][q] = a[q][p] = 0.0;
+          continue;
+        }
+        if (apq == 0.0)
+          continue;
+
+        // compute the rotation annihilating a[p][q]
+        const K h = a[q][q] - a[p][p];
+        K t;
+        if (std::abs(h) + g == std::abs(h))
+          t = apq / h;
+        else
+        {
+          const K theta = 0.5 * h / apq;
+          t = 1.0 / (std::abs(theta) + std::sqrt(1.0 + theta * theta));
+          if (theta < 0.0)
+            t = -t;
+        }
+        const K c = 1.0 / std::sqrt(1.0 + t * t);
+        const K s = t * c;
+        const K tau = s / (1.0 + c);
+
+        a[p][p] -= t * apq;
+        a[q][q] += t * apq;
+        a[p][q] = a[q][p] = 0.0;
+        for (int r=0; r<dim; ++r)
+        {
+          if (r == p || r == q)
+            continue;
+          const K arp = a[r][p];
+          const K arq = a[r][q];
+          a[r][p] = a[p][r] = arp - s * (arq + arp * tau);
+          a[r][q] = a[q][r] = arq + s * (arp - arq * tau);
+        }
+        if (eigenvectors)
+          for (int r=0; r<dim; ++r)
+          {
+            const K vrp = v[r][p];
+            const K vrq = v[r][q];
+            v[r][p] = vrp - s * (vrq + vrp * tau);
+            v[r][q] = vrq + s * (vrp - vrq * tau);
+          }
+      }
+    }
+  }
+
+  for (int i=0; i<dim; ++i)
+    eigenvalues[i] = a[i][i];
+
+  // sort in ascending order
+  for (int i=0; i<dim-1; ++i)
+  {
+    int k = i;
+    for (int j=i+1; j<dim; ++j)
+      if (eigenvalues[j] < eigenvalues[k])
+        k = j;
+    if (k != i)
+    {
+      std::swap(eigenvalues[i], eigenvalues[k]);
+      if (eigenvectors)
+        for (int r=0; r<dim; ++r)
+          std::swap(v[r][i], v[r][k]);
+    }
+  }
+
+  if (eigenvectors)
+    for (int i=0; i<dim; ++i)
+      for (int r=0; r<dim; ++r)
+        (*eigenvectors)[i][r] = v[r][i];
+}
+
+/** \brief calculates eigenvalues and eigenvectors of a symmetric 3x3
+    field matrix in closed form
+
+    The eigenvalues are the roots of the characteristic polynomial, which
+    are computed with the trigonometric method. Each eigenvector is
+    obtained as the largest cross product of two rows of the matrix
+    shifted by the eigenvalue. If two eigenvalues (almost) coincide, both
+    steps become inaccurate and the Jacobi method is used instead.
+
+    \param[in]  matrix matrix eigenvalues are calculated for
+    \param[out] eigenvalues FieldVector that contains eigenvalues in
+                ascending order
+    \param[out] eigenvectors if not null, row i is set to the normalized
+                eigenvector for eigenvalues[i]
+*/
+template <typename K>
+static void eigenValuesClosedForm(const FieldMatrix<K, 3, 3>& matrix,
+                                  FieldVector<K, 3>& eigenvalues,
+                                  FieldMatrix<K, 3, 3>* eigenvectors = 0)
+{
+  const K a01 = matrix[0][1], a02 = matrix[0][2], a12 = matrix[1][2];
+  const K q = (matrix[0][0] + matrix[1][1] + matrix[2][2]) / 3.0;
+  // shift by the mean eigenvalue to reduce cancellation
+  const K b00 = matrix[0][0] - q, b11 = matrix[1][1] - q, b22 = matrix[2][2] - q;
+  const K p1 = a01 * a01 + a02 * a02 + a12 * a12;
+  const K p2 = b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * p1;
+
+  if (p2 == 0.0)
+  {
+    // multiple of the identity
+    eigenvalues = q;
+    if (eigenvectors)
+    {
+      *eigenvectors = 0.0;
+      for (int i=0; i<3; ++i)
+        (*eigenvectors)[i][i] = 1.0;
+    }
+    return;
+  }
+
+  const K p = std::sqrt(p2 / 6.0);
+  // half the determinant of (A - qI)/p, lies in [-1,1]
+  const K r = (b00 * (b11 * b22 - a12 * a12)
+               - a01 * (a01 * b22 - a12 * a02)
+               + a02 * (a01 * a12 - b11 * a02)) / (2.0 * p * p * p);
+
+  // |r| = 1 means a double eigenvalue, where acos is ill conditioned
+  const K tolerance = std::sqrt(std::numeric_limits<K>::epsilon());
+  if (std::abs(r) > 1.0 - tolerance)
+  {
+    eigenValuesJacobi(matrix, eigenvalues, eigenvectors);
+    return;
+  }
+
+  const K pi = 3.14159265358979323846;
+  const K phi = std::acos(r) / 3.0;
+  eigenvalues[2] = q + 2.0 * p * std::cos(phi);
+  eigenvalues[0] = q + 2.0 * p * std::cos(phi + 2.0 * pi / 3.0);
+  eigenvalues[1] = 3.0 * q - eigenvalues[0] - eigenvalues[2];
+
+  if (!eigenvectors)
+    return;
+
+  // eigenvectors of the smallest and largest eigenvalue
+  for (int k=0; k<3; k+=2)
+  {
+    FieldVector<K, 3> rows[3];
+    for (int i=0; i<3; ++i)
+    {
+      for (int j=0; j<3; ++j)
+        rows[i][j] = matrix[i][j];
+      rows[i][i] -= eigenvalues[k];
+    }
+
+    FieldVector<K, 3> best(0.0);
+    K bestNorm = 0.0;
+    for (int i=0; i<3; ++i)
+    {
+      const FieldVector<K, 3>& x = rows[i];
+      const FieldVector<K, 3>& y = rows[(i+1)%3];
+      FieldVector<K, 3> c;
+      c[0] = x[1] * y[2] - x[2] * y[1];
+      c[1] = x[2] * y[0] - x[0] * y[2];
+      c[2] = x[0] * y[1] - x[1] * y[0];
+      const K norm = c.two_norm2();
+      if (norm > bestNorm)
+      {
+        best = c;
+        bestNorm = norm;
+      }
+    }
+
+    if (!(bestNorm > tolerance * p2 * p2))
+    {
+      eigenValuesJacobi(matrix, eigenvalues, eigenvectors);
+      return;
+    }
+    best /= std::sqrt(bestNorm);
+    (*eigenvectors)[k] = best;
+  }
+
+  // the middle eigenvector completes the orthonormal basis
+  const FieldVector<K, 3>& x = (*eigenvectors)[2];
+  const FieldVector<K, 3>& y = (*eigenvectors)[0];
+  FieldVector<K, 3>& z = (*eigenvectors)[1];
+  z[0] = x[1] * y[2] - x[2] * y[1];
+  z[1] = x[2] * y[0] - x[0] * y[2];
+  z[2] = x[0] * y[1] - x[1] * y[0];
+  z /= z.two_norm();
+}
+
+// selects the solver for symmetric matrices by the dimension; for the
+// eigenvalues alone dsyev is faster than Jacobi from dim=6 on (GCC -O3)
+template <int dim, bool small = (dim <= 5)>
+struct SymmetricEigenSolver
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, dim, dim>& matrix,
+                    FieldVector<K, dim>& eigenvalues,
+                    FieldMatrix<K, dim, dim>* eigenvectors)
+  {
+    eigenValuesJacobi(matrix, eigenvalues, eigenvectors);
+  }
+};
+
+template <>
+struct SymmetricEigenSolver<3, true>
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, 3, 3>& matrix,
+                    FieldVector<K, 3>& eigenvalues,
+                    FieldMatrix<K, 3, 3>* eigenvectors)
+  {
+    eigenValuesClosedForm(matrix, eigenvalues, eigenvectors);
+  }
+};
+
+template <int dim>
+struct SymmetricEigenSolver<dim, false>
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, dim, dim>& matrix,
+                    FieldVector<K, dim>& eigenvalues,
+                    FieldMatrix<K, dim, dim>* eigenvectors)
+  {
+#if HAVE_LAPACK
+    if (!eigenvectors)
+    {
+      eigenValuesLapack(matrix, eigenvalues);
+      return;
+    }
+#endif
+    eigenValuesJacobi(matrix, eigenvalues, eigenvectors);
+  }
+};
+
+/** \brief calculates the eigenvalues of a symmetric field matrix 
+    \param[in]  matrix matrix eigenvalues are calculated for 
+    \param[out] eigenvalues FieldVector that contains eigenvalues in 
+                ascending order 
+
+    \note For dim=3 the eigenvalues are computed in closed form, for
+    other dim <= 5 the Jacobi method is used. For larger matrices
+    LAPACK::dsyev is called, or the Jacobi method if LAPACK is not
+    available.
+*/                
+template <int dim, typename K> 
+static void eigenValues(const FieldMatrix<K, dim, dim>& matrix,
+                        FieldVector<K, dim>& eigenvalues)  
+{
+  SymmetricEigenSolver<dim>::apply(matrix, eigenvalues, (FieldMatrix<K, dim, dim>*) 0);
+}
+
+/** \brief calculates the eigenvalues and eigenvectors of a symmetric
+    field matrix
+    \param[in]  matrix matrix eigenvalues are calculated for
+    \param[out] eigenvalues FieldVector that contains eigenvalues in
+                ascending order
+    \param[out] eigenvectors row i is set to the normalized eigenvector
+                for eigenvalues[i]
+
+    \note For dim=3 a closed form solution is used, otherwise the Jacobi
+    method.
+*/
+template <int dim, typename K>
+static void eigenValuesVectors(const FieldMatrix<K, dim, dim>& matrix,
+                               FieldVector<K, dim>& eigenvalues,
+                               FieldMatrix<K, dim, dim>& eigenvectors)
+{
+  SymmetricEigenSolver<dim>::apply(matrix, eigenvalues, &eigenvectors);
+}
+
+// solves a contiguous range of symmetric eigenvalue problems
+template <int dim>
+struct BatchedSymmetricEigenSolver
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, dim, dim>* matrices, std::size_t n,
+                    FieldVector<K, dim>* eigenvalues,
+                    FieldMatrix<K, dim, dim>* eigenvectors)
+  {
+    for (std::size_t i=0; i<n; ++i)
+      SymmetricEigenSolver<dim>::apply(matrices[i], eigenvalues[i],
+                                       eigenvectors ? eigenvectors+i : 0);
+  }
+};
+
+// number of matrices that are processed together in the batched kernels
+enum { eigenValuesBatchLanes = 8 };
+
+// For the eigenvalues of 2x2 and 3x3 matrices, the entries of
+// eigenValuesBatchLanes matrices are transposed into one array per entry,
+// so that the closed form formulas vectorize across matrices.
+template <>
+struct BatchedSymmetricEigenSolver<2>
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, 2, 2>* matrices, std::size_t n,
+                    FieldVector<K, 2>* eigenvalues,
+                    FieldMatrix<K, 2, 2>* eigenvectors)
+  {
+    if (eigenvectors)
+    {
+      for (std::size_t i=0; i<n; ++i)
+        SymmetricEigenSolver<2>::apply(matrices[i], eigenvalues[i], eigenvectors+i);
+      return;
+    }
+
+    enum { lanes = eigenValuesBatchLanes };
+    std::size_t i = 0;
+    for (; i+lanes<=n; i+=lanes)
+    {
+      K mean[lanes], radius[lanes];
+      for (int l=0; l<lanes; ++l)
+      {
+        const FieldMatrix<K, 2, 2>& m = matrices[i+l];
+        const K h = 0.5 * (m[0][0] - m[1][1]);
+        mean[l] = 0.5 * (m[0][0] + m[1][1]);
+        radius[l] = std::sqrt(h * h + m[0][1] * m[0][1]);
+      }
+      for (int l=0; l<lanes; ++l)
+      {
+        eigenvalues[i+l][0] = mean[l] - radius[l];
+        eigenvalues[i+l][1] = mean[l] + radius[l];
+      }
+    }
+    for (; i<n; ++i)
+      SymmetricEigenSolver<2>::apply(matrices[i], eigenvalues[i],
+                                     (FieldMatrix<K, 2, 2>*) 0);
+  }
+};
+
+template <>
+struct BatchedSymmetricEigenSolver<3>
+{
+  template <typename K>
+  static void apply(const FieldMatrix<K, 3, 3>* matrices, std::size_t n,
+                    FieldVector<K, 3>* eigenvalues,
+                    FieldMatrix<K, 3, 3>* eigenvectors)
+  {
+    if (eigenvectors)
+    {
+      for (std::size_t i=0; i<n; ++i)
+        eigenValuesClosedForm(matrices[i], eigenvalues[i], eigenvectors+i);
+      return;
+    }
+
+    enum { lanes = eigenValuesBatchLanes };
+    const K pi = 3.14159265358979323846;
+    const K tolerance = std::sqrt(std::numeric_limits<K>::epsilon());
+    std::size_t i = 0;
+    for (; i+lanes<=n; i+=lanes)
+    {
+      K a01[lanes], a02[lanes], a12[lanes];
+      K b00[lanes], b11[lanes], b22[lanes];
+      K q[lanes], p[lanes], r[lanes];
+      for (int l=0; l<lanes; ++l)
+      {
+        const FieldMatrix<K, 3, 3>& m = matrices[i+l];
+        a01[l] = m[0][1];
+        a02[l] = m[0][2];
+        a12[l] = m[1][2];
+        q[l] = (m[0][0] + m[1][1] + m[2][2]) / 3.0;
+        b00[l] = m[0][0] - q[l];
+        b11[l] = m[1][1] - q[l];
+        b22[l] = m[2][2] - q[l];
+      }
+      for (int l=0; l<lanes; ++l)
+      {
+        const K p1 = a01[l] * a01[l] + a02[l] * a02[l] + a12[l] * a12[l];
+        const K p2 = b00[l] * b00[l] + b11[l] * b11[l] + b22[l] * b22[l] + 2.0 * p1;
+        p[l] = std::sqrt(p2 / 6.0);
+        const K det = b00[l] * (b11[l] * b22[l] - a12[l] * a12[l])
+                      - a01[l] * (a01[l] * b22[l] - a12[l] * a02[l])
+                      + a02[l] * (a01[l] * a12[l] - b11[l] * a02[l]);
+        // multiples of the identity have p = 0 and get r = 0
+        r[l] = (p2 > 0.0) ? det / (2.0 * p[l] * p[l] * p[l]) : 0.0;
+        r[l] = std::min(std::max(r[l], K(-1.0)), K(1.0));
+      }
+      for (int l=0; l<lanes; ++l)
+      {
+        const K phi = std::acos(r[l]) / 3.0;
+        const K largest = q[l] + 2.0 * p[l] * std::cos(phi);
+        const K smallest = q[l] + 2.0 * p[l] * std::cos(phi + 2.0 * pi / 3.0);
+        eigenvalues[i+l][0] = smallest;
+        eigenvalues[i+l][1] = 3.0 * q[l] - smallest - largest;
+        eigenvalues[i+l][2] = largest;
+      }
+      // recompute (nearly) multiple eigenvalues with the robust scalar code
+      for (int l=0; l<lanes; ++l)
+        if (p[l] > 0.0 && std::abs(r[l]) > 1.0 - tolerance)
+          eigenValuesClosedForm(matrices[i+l], eigenvalues[i+l]);
+    }
+    for (; i<n; ++i)
+      eigenValuesClosedForm(matrices[i], eigenvalues[i]);
+  }
+};
+
+/** \brief calculates the eigenvalues, and optionally the eigenvectors,
+    of an array of symmetric field matrices
+
+    The result is the same as calling eigenValues() or
+    eigenValuesVectors() for each matrix. For many small matrices the
+    batched version avoids the per call overhead: the eigenvalues of 2x2
+    and 3x3 matrices are computed for several matrices at once in a form
+    the compiler can vectorize, and the batch may be split over several
+    threads.
+
+    \param[in]  matrices array of n matrices
+    \param[in]  n number of matrices
+    \param[out] eigenvalues array of n vectors, eigenvalues[i] is set to
+                the eigenvalues of matrices[i] in ascending order
+    \param[out] eigenvectors if not null, an array of n matrices whose
+                row j is set to the eigenvector for eigenvalues[i][j]
+    \param[in]  threads number of threads used for large batches
+
+    \note Using more than one thread requires HAVE_STD_THREAD, otherwise
+    the batch is processed by the calling thread. Each thread handles at
+    least 1024 matrices.
+*/
+template <int dim, typename K>
+static void eigenValuesBatched(const FieldMatrix<K, dim, dim>* matrices,
+                               std::size_t n,
+                               FieldVector<K, dim>* eigenvalues,
+                               FieldMatrix<K, dim, dim>* eigenvectors = 0,
+                               unsigned int threads = 1)
+{
+#if HAVE_STD_THREAD
+  const std::size_t minChunk = 1024;
+  threads = std::max(1u, std::min<unsigned int>(threads, n / minChunk));
+  if (threads > 1)
+  {
+    const std::size_t chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    // the calling thread processes the first chunk itself
+    for (std::size_t begin = chunk; begin < n; begin += chunk)
+    {
+      const std::size_t size = std::min(chunk, n - begin);
+      workers.push_back(std::thread(&BatchedSymmetricEigenSolver<dim>::template apply<K>,
+                                    matrices + begin, size, eigenvalues + begin,
+                                    eigenvectors ? eigenvectors + begin : 0));
+    }
+    BatchedSymmetricEigenSolver<dim>::apply(matrices, std::min(chunk, n),
+                                            eigenvalues, eigenvectors);
+    for (std::size_t t=0; t<workers.size(); ++t)
+      workers[t].join();
+    return;
+  }
+#endif
+  BatchedSymmetricEigenSolver<dim>::apply(matrices, n, eigenvalues, eigenvectors);
+}
+
 /** \brief calculates the eigenvalues of a symmetric field matrix 
     \param[in]  matrix matrix eigenvalues are calculated for 
     \param[out] eigenValues FieldVector that contains eigenvalues in 
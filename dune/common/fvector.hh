@@ -12,9 +12,11 @@
 
 #include "typetraits.hh"
 #include "exceptions.hh"
+#include "hash.hh"
 #include "array.hh"
 #include "densevector.hh"
 #include "static_assert.hh"
+#include "unrolledkernels.hh"
 
 namespace Dune {
 
@@ -138,8 +140,68 @@ representing a field and a compile-time given size.
       for (size_type i = 0; i<SIZE; i++)
         _data[i] = x[i];
     }
+
+    //! Constructor evaluating a vector expression
+    template<class E>
+    FieldVector (const DenseVectorExpression<E> & e)
+    {
+      Base::operator=(e);
+    }
+
     using Base::operator=;
-    
+
+    //===== dot products and norms, unrolled for small sizes
+
+    //! indefinite vector dot product, see DenseVector::operator*()
+    template<class Other>
+    typename PromotionTraits<K,typename DenseVector<Other>::field_type>::PromotedType operator* (const DenseVector<Other>& y) const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::product(*this, y);
+    }
+
+    //! vector dot product, see DenseVector::dot()
+    template<class Other>
+    typename PromotionTraits<K,typename DenseVector<Other>::field_type>::PromotedType dot (const DenseVector<Other>& y) const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::dot(*this, y);
+    }
+
+    //! one norm (sum over absolute values of entries)
+    typename FieldTraits<K>::real_type one_norm () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::one_norm(*this);
+    }
+
+    //! simplified one norm (uses Manhattan norm for complex values)
+    typename FieldTraits<K>::real_type one_norm_real () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::one_norm_real(*this);
+    }
+
+    //! two norm sqrt(sum over squared values of entries)
+    typename FieldTraits<K>::real_type two_norm () const
+    {
+      return fvmeta::sqrt(UnrolledKernels::VectorKernels<SIZE>::two_norm2(*this));
+    }
+
+    //! square of two norm (sum over squared values of entries)
+    typename FieldTraits<K>::real_type two_norm2 () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::two_norm2(*this);
+    }
+
+    //! infinity norm (maximum of absolute values of entries)
+    typename FieldTraits<K>::real_type infinity_norm () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::infinity_norm(*this);
+    }
+
+    //! simplified infinity norm (uses Manhattan norm for complex values)
+    typename FieldTraits<K>::real_type infinity_norm_real () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::infinity_norm_real(*this);
+    }
+
     // make this thing a vector
     size_type vec_size() const { return SIZE; }
     K & vec_access(size_type i) { return _data[i]; }
@@ -218,12 +280,26 @@ representing a field and a compile-time given size.
       _data = x[0];
     }
 
+    //! Constructor evaluating a vector expression
+    template<class E>
+    FieldVector (const DenseVectorExpression<E> & e)
+    {
+      Base::operator=(e);
+    }
+
     //! Assignment operator for scalar
     inline FieldVector& operator= (const K& k)
     {
       _data = k;
       return *this;
     }
+
+    //! Assignment of a vector expression
+    template<class E>
+    FieldVector& operator= (const DenseVectorExpression<E> & e)
+    {
+      return Base::operator=(e);
+    }
     
     //===== forward methods to container
     size_type vec_size() const { return 1; }
@@ -395,8 +471,20 @@ representing a field and a compile-time given size.
   }
 #endif
 
+#if HAVE_DUNE_HASH
+  //! Hashes the entries of a FieldVector, see hash_contiguous_range()
+  template<class K, int SIZE>
+  inline std::size_t hash_value (const FieldVector<K,SIZE>& v)
+  {
+    const K* first = SIZE>0 ? &v[0] : 0;
+    return hash_contiguous_range(first, first+SIZE);
+  }
+#endif // HAVE_DUNE_HASH
+
   /** @} end documentation */
 
 } // end namespace
 
+DUNE_DEFINE_HASH(DUNE_HASH_TEMPLATE_ARGS(class K, int SIZE),DUNE_HASH_TYPE(Dune::FieldVector<K,SIZE>))
+
 #endif
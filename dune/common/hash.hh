@@ -3,6 +3,10 @@
 #ifndef DUNE_COMMON_HASH_HH
 #define DUNE_COMMON_HASH_HH
 
+#include <cstddef>
+#include <cstring>
+#include <stdint.h> // for uint64_t
+
 #if HAVE_STD_HASH
 #include <functional>
 #endif
@@ -392,6 +396,81 @@ namespace Dune {
       }
   }
 
+  //! Mixes the bits of x such that every bit of x affects every bit of the result.
+  /**
+   * This is the multiply-xorshift finalizer of the SplitMix64 generator. It
+   * spreads keys that only differ in a few low bits, like consecutive global
+   * indices, over the whole range of hash values.
+   *
+   * \note This function is only available if the macro `HAVE_DUNE_HASH` is defined.
+   */
+  inline std::size_t hash_mix(uint64_t x)
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<std::size_t>(x);
+  }
+
+#ifndef DOXYGEN
+  namespace HashImpl {
+
+    // the word representing one entry in hash_contiguous_range()
+    template<typename T>
+    inline uint64_t word(const T& t)
+    {
+      Dune::hash<T> hasher;
+      return hasher(t);
+    }
+
+    // floating point numbers are represented by their bits, with -0 and 0
+    // mapped to the same word because they compare equal
+    inline uint64_t word(double t)
+    {
+      if (t == 0)
+        t = 0;
+      uint64_t w;
+      std::memcpy(&w, &t, sizeof(w));
+      return w;
+    }
+
+    inline uint64_t word(float t)
+    {
+      return word(static_cast<double>(t));
+    }
+
+  } // end namespace HashImpl
+#endif // DOXYGEN
+
+  //! Hashes the contiguous range [first,last) and returns the hash.
+  /**
+   * Instead of combining the full hash of every element like hash_range(),
+   * each element is folded into a 64 bit state with one multiplication and
+   * one xorshift, and the state is mixed with hash_mix() at the end. This is
+   * much cheaper for arrays of integers or floating point numbers, like the
+   * limbs of a bigunsignedint or the entries of a FieldVector. Floating point
+   * entries are hashed by value, other types with Dune::hash.
+   *
+   * \note This function is only available if the macro `HAVE_DUNE_HASH` is defined.
+   *
+   * \param first  Pointer to the first object to hash.
+   * \param last   Pointer one past the last object to hash.
+   */
+  template<typename T>
+  inline std::size_t hash_contiguous_range(const T* first, const T* last)
+  {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ static_cast<uint64_t>(last - first);
+    for (; first != last; ++first)
+      {
+        h ^= HashImpl::word(*first);
+        h *= 0x9fb21c651e98df25ULL;
+        h ^= h >> 32;
+      }
+    return hash_mix(h);
+  }
+
 } // end namespace Dune
 
 #endif // HAVE_DUNE_HASH || defined(DOXYGEN)
@@ -0,0 +1,683 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=8 sw=4 sts=4:
+#ifndef DUNE_COMMON_LRUCACHE_HH
+#define DUNE_COMMON_LRUCACHE_HH
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hash.hh>
+#include <dune/common/iteratorfacades.hh>
+#include <dune/common/typetraits.hh>
+
+/** @file
+    @brief LRU cache with constant time operations and automatic eviction
+*/
+
+namespace Dune {
+
+/**
+   @brief Default eviction handler of LRUCache, does nothing.
+ */
+template <typename _Key, typename _Tp>
+struct LRUCacheNoEviction
+{
+    void operator() (const _Key &, _Tp &) const
+    {}
+};
+
+/**
+   @brief Iterator over the entries of an LRUCache
+
+   Iterates from the most recently used to the least recently used
+   entry.
+ */
+template <typename _Cache, typename _Value>
+class LRUCacheIterator :
+        public ForwardIteratorFacade<LRUCacheIterator<_Cache,_Value>, _Value, _Value&, std::ptrdiff_t>
+{
+    friend class LRUCacheIterator<typename remove_const<_Cache>::type,
+                                  typename remove_const<_Value>::type>;
+    friend class LRUCacheIterator<const typename remove_const<_Cache>::type,
+                                  const typename remove_const<_Value>::type>;
+
+    typedef typename remove_const<_Cache>::type::index_type index_type;
+
+public:
+    LRUCacheIterator () :
+        _cache(0), _pos(index_type(-1))
+    {}
+
+    LRUCacheIterator (_Cache & cache, index_type pos) :
+        _cache(&cache), _pos(pos)
+    {}
+
+    LRUCacheIterator (const LRUCacheIterator<typename remove_const<_Cache>::type,
+                                             typename remove_const<_Value>::type> & other) :
+        _cache(other._cache), _pos(other._pos)
+    {}
+
+    bool equals (const LRUCacheIterator<typename remove_const<_Cache>::type,
+                                        typename remove_const<_Value>::type> & other) const
+    {
+        return _pos == other._pos;
+    }
+
+    bool equals (const LRUCacheIterator<const typename remove_const<_Cache>::type,
+                                        const typename remove_const<_Value>::type> & other) const
+    {
+        return _pos == other._pos;
+    }
+
+    _Value & dereference () const
+    {
+        return _cache->_nodes[_pos].data;
+    }
+
+    void increment ()
+    {
+        _pos = _cache->_nodes[_pos].next;
+    }
+
+private:
+    _Cache * _cache;
+    index_type _pos;
+};
+
+/**
+    @brief LRU cache with hashed index and capacity based eviction
+
+    In contrast to Dune::lru this container keeps all entries in a
+    contiguous node pool that is linked into an intrusive recency
+    list, and finds them through an open addressing hash table with
+    linear probing. Thus find(), touch(), insert() and erase() take
+    constant expected time and no allocation is done once the pool
+    has reached its working size.
+
+    The cache can be limited by the number of entries and by a byte
+    budget, where the byte cost of each entry is given on insertion.
+    If inserting an entry exceeds one of the limits, the least
+    recently used entries are evicted and passed to the eviction
+    handler before they are dropped.
+
+    Lookups through find() and get() are counted as hits and misses.
+
+    @note The default hash functor requires Dune::hash, i.e. the
+    macro HAVE_DUNE_HASH has to be set.
+
+    @tparam _Key   The key type, has to be hashable by _Hash.
+    @tparam _Tp    The data type, has to be default constructible
+                   and assignable.
+    @tparam _Evict Functor called as evict(key, data) for every entry
+                   that is evicted automatically.
+    @tparam _Hash  Hash functor for the keys.
+    @tparam _Equal Equality comparison for the keys.
+
+    @warning References to the data are invalidated whenever the node
+    pool has to grow. Use reserve() or setCapacity() to avoid this.
+ */
+template <typename _Key, typename _Tp,
+          typename _Evict = LRUCacheNoEviction<_Key, _Tp>,
+          typename _Hash = Dune::hash<_Key>,
+          typename _Equal = std::equal_to<_Key> >
+class LRUCache
+{
+    template <typename, typename> friend class LRUCacheIterator;
+
+    typedef std::size_t index_type;
+
+    /** @brief marks empty hash slots and the end of the recency list */
+    static const index_type npos = index_type(-1);
+
+    struct Node
+    {
+        std::pair<_Key, _Tp> data;
+        std::size_t hash;
+        std::size_t bytes;
+        index_type prev;
+        index_type next;
+    };
+
+public:
+    typedef _Key                 key_type;
+    typedef _Tp                  value_type;
+    typedef _Tp *                pointer;
+    typedef const _Tp *          const_pointer;
+    typedef _Tp &                reference;
+    typedef const _Tp &          const_reference;
+    typedef std::size_t          size_type;
+    typedef _Evict               eviction_handler;
+    typedef LRUCacheIterator<LRUCache, std::pair<_Key, _Tp> > iterator;
+    typedef LRUCacheIterator<const LRUCache, const std::pair<_Key, _Tp> > const_iterator;
+
+    /**
+     * @brief Construct an empty cache
+     *
+     * @param capacity   maximal number of entries, 0 means unlimited
+     * @param byteBudget maximal sum of the entry costs, 0 means unlimited
+     * @param evict      handler called for automatically evicted entries
+     */
+    explicit LRUCache (size_type capacity = 0, std::size_t byteBudget = 0,
+                       const eviction_handler & evict = eviction_handler(),
+                       const _Hash & hash = _Hash(), const _Equal & equal = _Equal()) :
+        _head(npos), _tail(npos), _free(npos), _size(0),
+        _capacity(capacity), _byteBudget(byteBudget), _bytes(0),
+        _hits(0), _misses(0), _evictions(0),
+        _evict(evict), _hash(hash), _equal(equal)
+    {
+        if (_capacity > 0)
+            reserve(_capacity);
+    }
+
+    /**
+     *  Returns a read/write reference to the data of the most
+     *  recently used entry.
+     */
+    reference front ()
+    {
+        assert(_head != npos);
+        return _nodes[_head].data.second;
+    }
+
+    /**
+     *  Returns a read-only (constant) reference to the data of the
+     *  most recently used entry.
+     */
+    const_reference front () const
+    {
+        assert(_head != npos);
+        return _nodes[_head].data.second;
+    }
+
+    /**
+     *  Returns a read/write reference to the data of the least
+     *  recently used entry.
+     */
+    reference back ()
+    {
+        assert(_tail != npos);
+        return _nodes[_tail].data.second;
+    }
+
+    /**
+     *  Returns a read-only (constant) reference to the data of the
+     *  least recently used entry.
+     */
+    const_reference back () const
+    {
+        assert(_tail != npos);
+        return _nodes[_tail].data.second;
+    }
+
+    /**
+     * @brief Removes the most recently used element.
+     *
+     * The eviction handler is not called.
+     */
+    void pop_front ()
+    {
+        assert(_head != npos);
+        remove(_head);
+    }
+
+    /**
+     * @brief Removes the least recently used element.
+     *
+     * The eviction handler is not called.
+     */
+    void pop_back ()
+    {
+        assert(_tail != npos);
+        remove(_tail);
+    }
+
+    /**
+     * @brief Finds the element whose key is k.
+     *
+     * The recency order is not changed, but the lookup is counted as
+     * hit or miss.
+     *
+     * @return iterator
+     */
+    iterator find (const key_type & key)
+    {
+        index_type slot = findSlot(key, _hash(key));
+        count(slot != npos);
+        return iterator(*this, slot == npos ? npos : _slots[slot]);
+    }
+
+    /**
+     * @brief Finds the element whose key is k.
+     *
+     * The recency order is not changed and the statistics are not
+     * updated.
+     *
+     * @return const_iterator
+     */
+    const_iterator find (const key_type & key) const
+    {
+        index_type slot = findSlot(key, _hash(key));
+        return const_iterator(*this, slot == npos ? npos : _slots[slot]);
+    }
+
+    /**
+     * @brief Look up the data for key and mark it as most recent.
+     *
+     * The lookup is counted as hit or miss.
+     *
+     * @return pointer to the data or 0 if key is not cached
+     */
+    pointer get (const key_type & key)
+    {
+        index_type slot = findSlot(key, _hash(key));
+        count(slot != npos);
+        if (slot == npos)
+            return 0;
+        index_type n = _slots[slot];
+        moveToFront(n);
+        return &_nodes[n].data.second;
+    }
+
+    /**
+     * @brief Insert a value into the container
+     *
+     * Stores value under key and marks it as most recent. If the key
+     * is already present its data is replaced. Afterwards least
+     * recently used entries are evicted until the capacity and the
+     * byte budget are met again. The new entry itself is never
+     * evicted.
+     *
+     * @param key   associated with data
+     * @param data  to store
+     * @param bytes the cost of the entry charged against the byte budget
+     *
+     * @return reference of stored data
+     */
+    reference insert (const key_type & key, const_reference data, std::size_t bytes = 0)
+    {
+        std::size_t h = _hash(key);
+        index_type slot = findSlot(key, h);
+        index_type n;
+        if (slot != npos)
+        {
+            n = _slots[slot];
+            _bytes -= _nodes[n].bytes;
+            _nodes[n].data.second = data;
+            moveToFront(n);
+        }
+        else
+        {
+            // grow before linking n, rehash() indexes the linked nodes
+            if (2 * (_size + 1) > _slots.size())
+                rehash(_slots.empty() ? 16 : 2 * _slots.size());
+            n = allocateNode(key, data, h);
+            linkFront(n);
+            insertSlot(n);
+            ++_size;
+        }
+        _nodes[n].bytes = bytes;
+        _bytes += bytes;
+        evict();
+        return _nodes[n].data.second;
+    }
+
+    /**
+     * @copydoc touch
+     */
+    reference insert (const key_type & key)
+    {
+        return touch (key);
+    }
+
+    /**
+     * @brief mark data associated with key as most recent
+     *
+     * @pre key has to be present in the cache
+     *
+     * @return reference of stored data
+     */
+    reference touch (const key_type & key)
+    {
+        index_type slot = findSlot(key, _hash(key));
+        assert(slot != npos);
+        index_type n = _slots[slot];
+        moveToFront(n);
+        return _nodes[n].data.second;
+    }
+
+    /**
+     * @brief Remove the element with the given key
+     *
+     * The eviction handler is not called.
+     *
+     * @return true if an element was removed
+     */
+    bool erase (const key_type & key)
+    {
+        index_type slot = findSlot(key, _hash(key));
+        if (slot == npos)
+            return false;
+        remove(_slots[slot]);
+        return true;
+    }
+
+    /** @brief iterator to the most recently used entry */
+    iterator begin ()
+    {
+        return iterator(*this, _head);
+    }
+
+    /** @brief iterator past the least recently used entry */
+    iterator end ()
+    {
+        return iterator(*this, npos);
+    }
+
+    /** @brief iterator to the most recently used entry */
+    const_iterator begin () const
+    {
+        return const_iterator(*this, _head);
+    }
+
+    /** @brief iterator past the least recently used entry */
+    const_iterator end () const
+    {
+        return const_iterator(*this, npos);
+    }
+
+    /**
+     * @brief the number of cached entries
+     */
+    size_type size () const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief true if no entries are cached
+     */
+    bool empty () const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Remove least recently used entries until new_size is reached
+     *
+     * The eviction handler is not called.
+     */
+    void resize (size_type new_size)
+    {
+        assert(new_size <= size());
+
+        while (new_size < size())
+            pop_back();
+    }
+
+    /**
+     * @brief Preallocate the node pool and hash index for n entries
+     */
+    void reserve (size_type n)
+    {
+        _nodes.reserve(n);
+        std::size_t slots = 16;
+        while (slots < 2 * n)
+            slots *= 2;
+        if (slots > _slots.size())
+            rehash(slots);
+    }
+
+    /**
+     * @brief Remove all entries
+     *
+     * The node pool is kept for reuse. The eviction handler is not
+     * called and the statistics are not reset.
+     */
+    void clear ()
+    {
+        while (_head != npos)
+            remove(_head);
+    }
+
+    /** @brief maximal number of entries, 0 means unlimited */
+    size_type capacity () const
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief Set the maximal number of entries
+     *
+     * Evicts least recently used entries if necessary.
+     * @param capacity the new capacity, 0 means unlimited
+     */
+    void setCapacity (size_type capacity)
+    {
+        _capacity = capacity;
+        if (_capacity > 0)
+            reserve(_capacity);
+        evict();
+    }
+
+    /** @brief maximal sum of the entry costs, 0 means unlimited */
+    std::size_t byteBudget () const
+    {
+        return _byteBudget;
+    }
+
+    /**
+     * @brief Set the maximal sum of the entry costs
+     *
+     * Evicts least recently used entries if necessary.
+     * @param byteBudget the new budget, 0 means unlimited
+     */
+    void setByteBudget (std::size_t byteBudget)
+    {
+        _byteBudget = byteBudget;
+        evict();
+    }
+
+    /** @brief the sum of the costs of all cached entries */
+    std::size_t bytes () const
+    {
+        return _bytes;
+    }
+
+    /** @brief number of successful lookups */
+    std::size_t hits () const
+    {
+        return _hits;
+    }
+
+    /** @brief number of failed lookups */
+    std::size_t misses () const
+    {
+        return _misses;
+    }
+
+    /** @brief number of automatically evicted entries */
+    std::size_t evictions () const
+    {
+        return _evictions;
+    }
+
+    /** @brief reset the hit, miss and eviction counters */
+    void resetStatistics ()
+    {
+        _hits = _misses = _evictions = 0;
+    }
+
+    /** @brief access the eviction handler */
+    eviction_handler & evictionHandler ()
+    {
+        return _evict;
+    }
+
+private:
+
+    void count (bool hit)
+    {
+        if (hit)
+            ++_hits;
+        else
+            ++_misses;
+    }
+
+    /** @brief position in the hash table of the node with key, or npos */
+    index_type findSlot (const key_type & key, std::size_t h) const
+    {
+        if (_slots.empty())
+            return npos;
+        const std::size_t mask = _slots.size() - 1;
+        for (std::size_t i = h & mask; ; i = (i + 1) & mask)
+        {
+            index_type n = _slots[i];
+            if (n == npos)
+                return npos;
+            if (_nodes[n].hash == h && _equal(_nodes[n].data.first, key))
+                return i;
+        }
+    }
+
+    void insertSlot (index_type n)
+    {
+        const std::size_t mask = _slots.size() - 1;
+        std::size_t i = _nodes[n].hash & mask;
+        while (_slots[i] != npos)
+            i = (i + 1) & mask;
+        _slots[i] = n;
+    }
+
+    /** @brief remove slot i using backward shift deletion */
+    void eraseSlot (std::size_t i)
+    {
+        const std::size_t mask = _slots.size() - 1;
+        _slots[i] = npos;
+        for (std::size_t j = (i + 1) & mask; _slots[j] != npos; j = (j + 1) & mask)
+        {
+            std::size_t ideal = _nodes[_slots[j]].hash & mask;
+            // move the entry back unless its ideal slot lies cyclically in (i,j]
+            bool keep = (i <= j) ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (!keep)
+            {
+                _slots[i] = _slots[j];
+                _slots[j] = npos;
+                i = j;
+            }
+        }
+    }
+
+    void rehash (std::size_t slots)
+    {
+        _slots.assign(slots, npos);
+        for (index_type n = _head; n != npos; n = _nodes[n].next)
+            insertSlot(n);
+    }
+
+    index_type allocateNode (const key_type & key, const_reference data, std::size_t h)
+    {
+        index_type n;
+        if (_free != npos)
+        {
+            n = _free;
+            _free = _nodes[n].next;
+            _nodes[n].data.first = key;
+            _nodes[n].data.second = data;
+        }
+        else
+        {
+            n = _nodes.size();
+            Node node;
+            node.data = std::make_pair(key, data);
+            _nodes.push_back(node);
+        }
+        _nodes[n].hash = h;
+        return n;
+    }
+
+    void linkFront (index_type n)
+    {
+        _nodes[n].prev = npos;
+        _nodes[n].next = _head;
+        if (_head != npos)
+            _nodes[_head].prev = n;
+        _head = n;
+        if (_tail == npos)
+            _tail = n;
+    }
+
+    void unlink (index_type n)
+    {
+        Node & node = _nodes[n];
+        if (node.prev != npos)
+            _nodes[node.prev].next = node.next;
+        else
+            _head = node.next;
+        if (node.next != npos)
+            _nodes[node.next].prev = node.prev;
+        else
+            _tail = node.prev;
+    }
+
+    void moveToFront (index_type n)
+    {
+        if (n == _head)
+            return;
+        unlink(n);
+        linkFront(n);
+    }
+
+    /** @brief unlink node n from list and index and put it on the free list */
+    void remove (index_type n)
+    {
+        eraseSlot(findSlot(_nodes[n].data.first, _nodes[n].hash));
+        unlink(n);
+        _bytes -= _nodes[n].bytes;
+        // release resources held by the data
+        _nodes[n].data.second = _Tp();
+        _nodes[n].next = _free;
+        _free = n;
+        --_size;
+    }
+
+    /** @brief evict least recently used entries until the limits are met */
+    void evict ()
+    {
+        while (_tail != _head &&
+               ((_capacity > 0 && _size > _capacity) ||
+                (_byteBudget > 0 && _bytes > _byteBudget)))
+        {
+            index_type n = _tail;
+            _evict(_nodes[n].data.first, _nodes[n].data.second);
+            ++_evictions;
+            remove(n);
+        }
+    }
+
+    std::vector<Node> _nodes;
+    std::vector<index_type> _slots;
+    index_type _head;
+    index_type _tail;
+    index_type _free;
+    size_type _size;
+    size_type _capacity;
+    std::size_t _byteBudget;
+    std::size_t _bytes;
+    std::size_t _hits;
+    std::size_t _misses;
+    std::size_t _evictions;
+    eviction_handler _evict;
+    _Hash _hash;
+    _Equal _equal;
+};
+
+template <typename _Key, typename _Tp, typename _Evict, typename _Hash, typename _Equal>
+const typename LRUCache<_Key, _Tp, _Evict, _Hash, _Equal>::index_type
+LRUCache<_Key, _Tp, _Evict, _Hash, _Equal>::npos;
+
+} // namespace Dune
+
+#endif // DUNE_COMMON_LRUCACHE_HH
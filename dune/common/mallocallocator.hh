@@ -3,8 +3,11 @@
 
 #include <exception>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 
+#include "alignment.hh"
+
 /**
  * @file 
  * @brief Allocators that use malloc/free.
@@ -91,6 +94,122 @@ namespace Dune
             p->~T();
         }
     };
+
+    /**
+       @ingroup Allocators
+       @brief Allocator calling malloc/free which aligns the memory to
+       Alignment bytes
+
+       malloc only guarantees the alignment of the fundamental types.
+       Types with an extended alignment, e.g. SIMD friendly vectors
+       declared with DUNE_ALIGNED, need this allocator in containers.
+
+       @tparam T the allocated type
+       @tparam Alignment the alignment in bytes, a power of two
+    */
+    template <class T, std::size_t Alignment = AlignmentOf<T>::value>
+    class AlignedMallocAllocator {
+    public:
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T value_type;
+        template <class U> struct rebind {
+            typedef AlignedMallocAllocator<U, (Alignment < std::size_t(AlignmentOf<U>::value)
+                                               ? std::size_t(AlignmentOf<U>::value) : Alignment)> other;
+        };
+
+        //! the alignment of the allocated memory
+        enum { alignment = Alignment };
+
+        //! create a new AlignedMallocAllocator
+        AlignedMallocAllocator() throw() {}
+        //! copy construct from an other AlignedMallocAllocator, possibly for a different result type
+        template <class U, std::size_t A>
+        AlignedMallocAllocator(const AlignedMallocAllocator<U,A>&) throw() {}
+        //! cleanup this allocator
+        ~AlignedMallocAllocator() throw() {}
+
+        pointer address(reference x) const
+        {
+            return &x;
+        }
+        const_pointer address(const_reference x) const
+        {
+            return &x;
+        }
+
+        //! allocate n objects of type T
+        pointer allocate(size_type n,
+            const void* hint = 0)
+        {
+            if (n > this->max_size())
+                throw std::bad_alloc();
+
+            // the pointer returned by malloc is stored in front of the
+            // aligned block
+            char* raw = static_cast<char*>(std::malloc(n * sizeof(T) + Alignment + sizeof(void*)));
+            if (!raw)
+                throw std::bad_alloc();
+            std::size_t offset = reinterpret_cast<std::size_t>(raw + sizeof(void*)) % Alignment;
+            char* ret = raw + sizeof(void*) + (offset ? Alignment - offset : 0);
+            std::memcpy(ret - sizeof(void*), &raw, sizeof(void*));
+            return reinterpret_cast<pointer>(ret);
+        }
+
+        //! deallocate n objects of type T at address p
+        void deallocate(pointer p, size_type n)
+        {
+            if (!p)
+                return;
+            void* raw;
+            std::memcpy(&raw, reinterpret_cast<char*>(p) - sizeof(void*), sizeof(void*));
+            std::free(raw);
+        }
+
+        //! max size for allocate
+        size_type max_size() const throw()
+        {
+            return (size_type(-1) - Alignment - sizeof(void*)) / sizeof(T);
+        }
+
+        //! copy-construct an object of type T (i.e. make a placement new on p)
+        void construct(pointer p, const T& val)
+        {
+            ::new((void*)p) T(val);
+        }
+#if HAVE_VARIADIC_TEMPLATES || DOXYGEN
+        //! construct an object of type T from variadic parameters
+        //! \note works only with newer C++ compilers
+        template<typename... _Args>
+        void construct(pointer p, _Args&&... __args)
+        {
+            ::new((void *)p) T(std::forward<_Args>(__args)...);
+        }
+#endif
+        //! destroy an object of type T (i.e. call the destructor)
+        void destroy(pointer p)
+        {
+            p->~T();
+        }
+    };
+
+    //! all AlignedMallocAllocators are interchangeable
+    template <class T, std::size_t A, class U, std::size_t B>
+    bool operator== (const AlignedMallocAllocator<T,A>&, const AlignedMallocAllocator<U,B>&)
+    {
+        return true;
+    }
+
+    //! all AlignedMallocAllocators are interchangeable
+    template <class T, std::size_t A, class U, std::size_t B>
+    bool operator!= (const AlignedMallocAllocator<T,A>&, const AlignedMallocAllocator<U,B>&)
+    {
+        return false;
+    }
 }
 
 #endif // DUNE_MALLOC_ALLOCATOR_HH
@@ -27,6 +27,27 @@ namespace Dune {
 template<class T>
 struct DenseMatVecTraits {};
 
+/**
+   @addtogroup DenseMatVec
+   \brief Owning type used for working copies of a Dune::DenseVector or Dune::DenseMatrix implementation
+
+   Algorithms like DenseMatrix::solve() or DenseVector::operator+() copy
+   the implementation T to work on or to return a result. This is T
+   itself by default. Implementations that do not own their entries,
+   like DenseVectorView and DenseMatrixView, specialize this class to
+   export a type that does.
+
+   \code
+   //! export the owning type, constructible from a const T&
+   typedef ... type;
+   \endcode
+*/
+template<class T>
+struct DenseMatVecCopy
+{
+  typedef T type;
+};
+
 } // end namespace Dune
 
 #endif // DUNE_FTRAITS_HH
@@ -0,0 +1,258 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_MIXEDPRECISIONSOLVER_HH
+#define DUNE_MIXEDPRECISIONSOLVER_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/densematrix.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/ftraits.hh>
+
+/*! \file
+ *  \brief Solver for dense linear systems with mixed precision
+ *  iterative refinement
+ */
+
+namespace Dune
+{
+
+/**
+    @addtogroup DenseMatVec
+    @{
+*/
+
+  /** \brief Solve dense linear systems by a low precision LU
+   *  factorization and iterative refinement
+   *
+   *  DenseMatrix::solve() factors the matrix in its own field type. This
+   *  solver instead factors it in the (cheaper) type F and recovers the
+   *  accuracy of K by iterative refinement: the residual r = b - A x is
+   *  computed in the type R, the correction A d = r is solved with the
+   *  low precision factorization and x is updated in K.
+   *
+   *  For matrices whose condition number is too large for F, refinement
+   *  does not converge. Once a correction is not at most half as large as
+   *  the previous one, the solver factors the matrix again in K and goes
+   *  on refining with this factorization. In that case usedFallback()
+   *  returns true.
+   *
+   *  For ill-conditioned matrices, choosing a high precision residual type
+   *  like GMPField<precision> from gmpfield.hh makes the computed solution
+   *  accurate up to the precision of K, even if the matrix entries are
+   *  stored in K only.
+   *
+   *  \code
+   *  Dune::MixedPrecisionSolver<double> solver;
+   *  int iterations = solver.solve(A, x, b);
+   *  \endcode
+   *
+   *  \tparam K the field type of matrix, solution and right hand side
+   *  \tparam F the field type used for the LU factorization
+   *  \tparam R the field type used to compute the residual
+   */
+  template< class K, class F = float, class R = K >
+  class MixedPrecisionSolver
+  {
+  public:
+    //! \brief field type of matrix and vectors
+    typedef K field_type;
+    //! \brief field type of the LU factorization
+    typedef F factorization_type;
+    //! \brief field type used for the residual computation
+    typedef R residual_type;
+    typedef std::size_t size_type;
+
+    /** \brief Constructor
+     *
+     *  \param maxIterations maximal number of refinement steps, counted
+     *                       separately for both factorizations
+     */
+    explicit MixedPrecisionSolver (int maxIterations = 30)
+      : maxIterations_(maxIterations), iterations_(0), fallback_(false)
+    {}
+
+    /** \brief Solve system A x = b
+     *
+     *  \return the total number of refinement steps
+     *  \exception FMatrixError if the matrix is singular in precision K
+     */
+    template< class MAT, class V >
+    int solve (const DenseMatrix<MAT>& A, V& x, const V& b)
+    {
+      if (A.rows() != A.cols())
+        DUNE_THROW(FMatrixError, "Can't solve for a " << A.rows() << "x" << A.cols() << " matrix!");
+
+      const size_type n = A.rows();
+      iterations_ = 0;
+      fallback_ = false;
+      r_.resize(n);
+      for (size_type i=0; i<n; ++i)
+        x[i] = 0;
+
+      if (low_.factor(A) && refine(A, x, b, low_, false))
+        return iterations_;
+
+      // refinement stalled or F cannot represent the factorization,
+      // restart as the last low precision correction may be useless
+      fallback_ = true;
+      if (!full_.factor(A))
+        DUNE_THROW(FMatrixError, "matrix is singular");
+      for (size_type i=0; i<n; ++i)
+        x[i] = 0;
+      refine(A, x, b, full_, true);
+      return iterations_;
+    }
+
+    //! \brief number of refinement steps of the last solve
+    int iterations () const
+    {
+      return iterations_;
+    }
+
+    //! \brief whether the last solve had to factor the matrix in precision K
+    bool usedFallback () const
+    {
+      return fallback_;
+    }
+
+  private:
+    typedef typename FieldTraits<K>::real_type real_type;
+
+    //! LU factorization with partial pivoting in precision T
+    template< class T >
+    class Factorization
+    {
+    public:
+      //! factor A, returns false if A is singular or not representable in T
+      template< class MAT >
+      bool factor (const DenseMatrix<MAT>& A)
+      {
+        n_ = A.rows();
+        lu_.resize(n_*n_);
+        pivot_.resize(n_);
+        for (size_type i=0; i<n_; ++i)
+          for (size_type j=0; j<n_; ++j)
+            lu_[i*n_+j] = T(A[i][j]);
+
+        for (size_type k=0; k<n_; ++k)
+        {
+          size_type p = k;
+          T pivmax = std::abs(lu_[k*n_+k]);
+          for (size_type i=k+1; i<n_; ++i)
+            if (std::abs(lu_[i*n_+k]) > pivmax)
+            {
+              pivmax = std::abs(lu_[i*n_+k]);
+              p = i;
+            }
+          // also catches infinite and NaN entries
+          if (!(pivmax > T(0) && pivmax <= std::numeric_limits<T>::max()))
+            return false;
+
+          pivot_[k] = p;
+          if (p != k)
+            for (size_type j=0; j<n_; ++j)
+              std::swap(lu_[k*n_+j], lu_[p*n_+j]);
+
+          const T* rowk = &lu_[k*n_];
+          for (size_type i=k+1; i<n_; ++i)
+          {
+            T* rowi = &lu_[i*n_];
+            const T factor = rowi[k] / rowk[k];
+            rowi[k] = factor;
+            for (size_type j=k+1; j<n_; ++j)
+              rowi[j] -= factor * rowk[j];
+          }
+        }
+        return true;
+      }
+
+      //! overwrite y by the solution of A d = y
+      void solve (std::vector<T>& y) const
+      {
+        for (size_type k=0; k<n_; ++k)
+          std::swap(y[k], y[pivot_[k]]);
+        for (size_type i=1; i<n_; ++i)
+          for (size_type j=0; j<i; ++j)
+            y[i] -= lu_[i*n_+j] * y[j];
+        for (size_type i=n_; i-- > 0; )
+        {
+          for (size_type j=i+1; j<n_; ++j)
+            y[i] -= lu_[i*n_+j] * y[j];
+          y[i] /= lu_[i*n_+i];
+        }
+      }
+
+    private:
+      size_type n_;
+      std::vector<T> lu_;
+      std::vector<size_type> pivot_;
+    };
+
+    //! iterative refinement, returns false if it stalls before convergence
+    template< class MAT, class V, class T >
+    bool refine (const DenseMatrix<MAT>& A, V& x, const V& b,
+                 const Factorization<T>& lu, bool fullPrecision)
+    {
+      const size_type n = A.rows();
+      const real_type eps = std::numeric_limits<real_type>::epsilon();
+      std::vector<T> d(n);
+      real_type lastCorrection = std::numeric_limits<real_type>::max();
+
+      for (int it=0; it<maxIterations_; ++it)
+      {
+        // residual in precision R, scaled to avoid underflow in T
+        real_type scale = 0;
+        for (size_type i=0; i<n; ++i)
+        {
+          R sum = R(b[i]);
+          for (size_type j=0; j<n; ++j)
+            sum = sum - R(A[i][j]) * R(x[j]);
+          r_[i] = static_cast<K>(sum);
+          scale = std::max(scale, real_type(std::abs(r_[i])));
+        }
+        if (scale == real_type(0))
+          return true;
+        if (!(scale <= std::numeric_limits<real_type>::max()))
+          return fullPrecision;
+
+        for (size_type i=0; i<n; ++i)
+          d[i] = T(r_[i] / scale);
+        lu.solve(d);
+
+        real_type correction = 0, solution = 0;
+        for (size_type i=0; i<n; ++i)
+        {
+          x[i] += scale * K(d[i]);
+          correction = std::max(correction, real_type(std::abs(scale * K(d[i]))));
+          solution = std::max(solution, real_type(std::abs(x[i])));
+        }
+        ++iterations_;
+
+        if (correction <= eps * solution)
+          return true;
+        // no contraction: refinement has reached its limit
+        if (!(correction <= 0.5 * lastCorrection))
+          return fullPrecision;
+        lastCorrection = correction;
+      }
+      return fullPrecision;
+    }
+
+    int maxIterations_;
+    int iterations_;
+    bool fallback_;
+    Factorization<F> low_;
+    Factorization<K> full_;
+    std::vector<K> r_;
+  };
+
+/** @} end documentation */
+
+} // end namespace Dune
+
+#endif
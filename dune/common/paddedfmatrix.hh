@@ -0,0 +1,216 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_PADDEDFMATRIX_HH
+#define DUNE_PADDEDFMATRIX_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/densematrix.hh>
+#include <dune/common/paddedfvector.hh>
+#include <dune/common/unrolledkernels.hh>
+
+namespace Dune
+{
+
+/**
+    @addtogroup DenseMatVec
+    @{
+*/
+
+/*! \file
+
+\brief  A FieldMatrix variant whose rows are padded and aligned for SIMD loads
+*/
+
+  template< class K, int ROWS, int COLS > class PaddedFieldMatrix;
+
+  template< class K, int ROWS, int COLS >
+  struct DenseMatVecTraits< PaddedFieldMatrix<K,ROWS,COLS> >
+  {
+    typedef PaddedFieldMatrix<K,ROWS,COLS> derived_type;
+
+    // each row is implemented by a padded field vector
+    typedef PaddedFieldVector<K,COLS> row_type;
+
+    typedef row_type &row_reference;
+    typedef const row_type &const_row_reference;
+
+    typedef Dune::array<row_type,ROWS> container_type;
+    typedef K value_type;
+    typedef typename container_type::size_type size_type;
+  };
+
+  template< class K, int ROWS, int COLS >
+  struct FieldTraits< PaddedFieldMatrix<K,ROWS,COLS> >
+  {
+    typedef typename FieldTraits<K>::field_type field_type;
+    typedef typename FieldTraits<K>::real_type real_type;
+  };
+
+  /**
+      @brief A dense n x m matrix with padded and aligned rows.
+
+      Every row is a PaddedFieldVector, e.g. the rows of a
+      PaddedFieldMatrix<double,3,3> start at 32 byte boundaries and
+      hold 4 doubles. The linear maps, determinant() and invert() use
+      the same kernels as FieldMatrix and give the same results.
+
+      \note Use AlignedMallocAllocator for containers of PaddedFieldMatrix.
+  */
+  template<class K, int ROWS, int COLS>
+  class PaddedFieldMatrix : public DenseMatrix< PaddedFieldMatrix<K,ROWS,COLS> >
+  {
+    Dune::array< PaddedFieldVector<K,COLS>, ROWS > _data;
+    typedef DenseMatrix< PaddedFieldMatrix<K,ROWS,COLS> > Base;
+  public:
+
+    //! export size
+    enum {
+      //! The number of rows.
+      rows = ROWS,
+      //! The number of columns.
+      cols = COLS
+    };
+
+    typedef typename Base::size_type size_type;
+    typedef typename Base::row_type row_type;
+
+    typedef typename Base::row_reference row_reference;
+    typedef typename Base::const_row_reference const_row_reference;
+
+    //===== constructors
+    /** \brief Default constructor, the entries are uninitialized
+     */
+    PaddedFieldMatrix () {}
+
+    /** \brief Constructor initializing the whole matrix with a scalar
+     */
+    explicit PaddedFieldMatrix (const K& k)
+    {
+      for (size_type i=0; i<rows; i++) _data[i] = k;
+    }
+
+    /** \brief Constructor copying the entries of another dense matrix
+     */
+    template<class M>
+    explicit PaddedFieldMatrix (const DenseMatrix<M>& other)
+    {
+      assert(other.rows() == ROWS && other.cols() == COLS);
+      for (size_type i=0; i<rows; i++)
+        for (size_type j=0; j<cols; j++)
+          _data[i][j] = other[i][j];
+    }
+
+    //===== assignment
+    using Base::operator=;
+
+    //===== linear maps, unrolled for small sizes
+
+    //! y = A x
+    template<class X, class Y>
+    void mv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mv(*this, x, y);
+    }
+
+    //! y = A^T x
+    template<class X, class Y>
+    void mtv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mtv(*this, x, y);
+    }
+
+    //! y += A x
+    template<class X, class Y>
+    void umv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::umv(*this, x, y);
+    }
+
+    //! y += A^T x
+    template<class X, class Y>
+    void umtv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::umtv(*this, x, y);
+    }
+
+    //! y -= A x
+    template<class X, class Y>
+    void mmv (const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::mmv(*this, x, y);
+    }
+
+    //! y += alpha A x
+    template<class X, class Y>
+    void usmv (const K& alpha, const X& x, Y& y) const
+    {
+#ifdef DUNE_FMatrix_WITH_CHECKING
+      if (x.N()!=COLS) DUNE_THROW(FMatrixError,"Index out of range");
+      if (y.N()!=ROWS) DUNE_THROW(FMatrixError,"Index out of range");
+#endif
+      UnrolledKernels::MatrixKernels<ROWS,COLS>::usmv(*this, alpha, x, y);
+    }
+
+    //! calculates the determinant of this matrix
+    K determinant () const
+    {
+      if (ROWS!=COLS)
+        DUNE_THROW(FMatrixError, "There is no determinant for a " << ROWS << "x" << COLS << " matrix!");
+      return UnrolledKernels::Determinant<ROWS,COLS>::apply(*this);
+    }
+
+    //! Compute inverse
+    void invert ()
+    {
+      if (ROWS!=COLS)
+        DUNE_THROW(FMatrixError, "Can't invert a " << ROWS << "x" << COLS << " matrix!");
+      if (!UnrolledKernels::Inverse<ROWS,COLS>::apply(*this))
+        DUNE_THROW(FMatrixError,"matrix is singular");
+    }
+
+    // make this thing a matrix
+    size_type mat_rows() const { return ROWS; }
+    size_type mat_cols() const { return COLS; }
+
+    row_reference mat_access ( size_type i )
+    {
+      assert(i < ROWS);
+      return _data[i];
+    }
+
+    const_row_reference mat_access ( size_type i ) const
+    {
+      assert(i < ROWS);
+      return _data[i];
+    }
+  };
+
+/** @} end documentation */
+
+} // end namespace
+
+#endif
@@ -0,0 +1,242 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PADDEDFVECTOR_HH
+#define DUNE_PADDEDFVECTOR_HH
+
+#include <cassert>
+#include <cstddef>
+
+#include "alignment.hh"
+#include "densevector.hh"
+#include "fvector.hh"
+#include "unrolledkernels.hh"
+
+namespace Dune {
+
+/** @addtogroup DenseMatVec
+    @{
+*/
+
+/*! \file
+ * \brief A FieldVector variant with storage padded and aligned for SIMD loads
+ */
+
+  template< class K, int SIZE > class PaddedFieldVector;
+  template< class K, int SIZE >
+  struct DenseMatVecTraits< PaddedFieldVector<K,SIZE> >
+  {
+    typedef PaddedFieldVector<K,SIZE> derived_type;
+    typedef AlignedArray<K,SIZE> container_type;
+    typedef K value_type;
+    typedef std::size_t size_type;
+  };
+
+  template< class K, int SIZE >
+  struct FieldTraits< PaddedFieldVector<K,SIZE> >
+  {
+    typedef typename FieldTraits<K>::field_type field_type;
+    typedef typename FieldTraits<K>::real_type real_type;
+  };
+
+  template<typename T, int SIZE>
+  struct IsFieldVectorSizeCorrect<PaddedFieldVector<T,SIZE>,SIZE>
+  {
+    enum{value = true};
+  };
+
+  template<typename T, int SIZE, int SIZE1>
+  struct IsFieldVectorSizeCorrect<PaddedFieldVector<T,SIZE1>,SIZE>
+  {
+    enum{value = false};
+  };
+
+  /** \brief Vector of SIZE entries stored padded and aligned to DUNE_SIMD_ALIGNMENT bytes
+   *
+   * The entries are stored in an AlignedArray, e.g. a
+   * PaddedFieldVector<double,3> occupies 4 doubles and is aligned to
+   * 32 bytes. Arrays of such vectors therefore do not straddle cache
+   * lines and every vector can be processed with full width aligned
+   * loads. The padding entries are zero and stay zero under the
+   * elementwise operations with finite scalars, which therefore run
+   * over the padded length without a remainder loop.
+   *
+   * FieldVector keeps its natural layout. Both are DenseVectors and
+   * can be converted into each other. MPITraits<PaddedFieldVector>
+   * only transfers the SIZE entries, so a PaddedFieldVector can be
+   * received as a FieldVector and vice versa.
+   *
+   * \note Use AlignedMallocAllocator for containers of PaddedFieldVector.
+   *
+   * \tparam K    the field type (use float, double, complex, etc)
+   * \tparam SIZE number of components.
+   */
+  template< class K, int SIZE >
+  class PaddedFieldVector :
+    public DenseVector< PaddedFieldVector<K,SIZE> >
+  {
+    typedef AlignedArray<K,SIZE> Storage;
+    Storage _data;
+    typedef DenseVector< PaddedFieldVector<K,SIZE> > Base;
+  public:
+	//! export size
+	enum {
+	  //! The size of this vector.
+      dimension = SIZE,
+      //! The number of stored entries, including the padding.
+      paddedSize = Storage::paddedSize,
+      //! The alignment of the entries in bytes.
+      alignment = Storage::alignment
+	};
+
+    typedef typename Base::size_type size_type;
+    typedef typename Base::value_type value_type;
+
+	//! Constructor making uninitialized vector, only the padding is set to zero
+	PaddedFieldVector()
+    {
+      clearPadding();
+    }
+
+	//! Constructor making vector with identical coordinates
+	explicit PaddedFieldVector (const K& t)
+	{
+      fill(t);
+	}
+
+	//! Constructor copying the entries of another vector
+    template<class C>
+    PaddedFieldVector (const DenseVector<C> & x, typename Dune::enable_if<IsFieldVectorSizeCorrect<C,SIZE>::value>::type* dummy=0 )
+	{
+      assert(x.size() == SIZE);
+      for (size_type i = 0; i<SIZE; i++)
+        _data[i] = x[i];
+      clearPadding();
+    }
+
+    //! Constructor evaluating a vector expression
+    template<class E>
+    PaddedFieldVector (const DenseVectorExpression<E> & e)
+    {
+      clearPadding();
+      Base::operator=(e);
+    }
+
+    using Base::operator=;
+
+    //===== elementwise operations over the padded length
+
+    //! vector space addition
+    PaddedFieldVector& operator+= (const PaddedFieldVector& y)
+    {
+      for (int i=0; i<paddedSize; i++)
+        _data[i] += y._data[i];
+      return *this;
+    }
+
+    //! vector space subtraction
+    PaddedFieldVector& operator-= (const PaddedFieldVector& y)
+    {
+      for (int i=0; i<paddedSize; i++)
+        _data[i] -= y._data[i];
+      return *this;
+    }
+
+    using Base::operator+=;
+    using Base::operator-=;
+
+    //! vector space multiplication with scalar
+    PaddedFieldVector& operator*= (const K& k)
+    {
+      for (int i=0; i<paddedSize; i++)
+        _data[i] *= k;
+      return *this;
+    }
+
+    //! vector space division by scalar
+    PaddedFieldVector& operator/= (const K& k)
+    {
+      for (int i=0; i<SIZE; i++)
+        _data[i] /= k;
+      return *this;
+    }
+
+    //! vector space axpy operation ( *this += a y )
+    PaddedFieldVector& axpy (const K& a, const PaddedFieldVector& y)
+    {
+      for (int i=0; i<paddedSize; i++)
+        _data[i] += a*y._data[i];
+      return *this;
+    }
+
+    using Base::axpy;
+
+    //===== dot products and norms, unrolled for small sizes
+
+    //! indefinite vector dot product, see DenseVector::operator*()
+    template<class Other>
+    typename PromotionTraits<K,typename DenseVector<Other>::field_type>::PromotedType operator* (const DenseVector<Other>& y) const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::product(*this, y);
+    }
+
+    //! vector dot product, see DenseVector::dot()
+    template<class Other>
+    typename PromotionTraits<K,typename DenseVector<Other>::field_type>::PromotedType dot (const DenseVector<Other>& y) const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::dot(*this, y);
+    }
+
+    //! one norm (sum over absolute values of entries)
+    typename FieldTraits<K>::real_type one_norm () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::one_norm(*this);
+    }
+
+    //! two norm sqrt(sum over squared values of entries)
+    typename FieldTraits<K>::real_type two_norm () const
+    {
+      return fvmeta::sqrt(UnrolledKernels::VectorKernels<SIZE>::two_norm2(*this));
+    }
+
+    //! square of two norm (sum over squared values of entries)
+    typename FieldTraits<K>::real_type two_norm2 () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::two_norm2(*this);
+    }
+
+    //! infinity norm (maximum of absolute values of entries)
+    typename FieldTraits<K>::real_type infinity_norm () const
+    {
+      return UnrolledKernels::VectorKernels<SIZE>::infinity_norm(*this);
+    }
+
+    //! pointer to the aligned entries, followed by the zero padding
+    K* data () { return _data.data; }
+    //! pointer to the aligned entries, followed by the zero padding
+    const K* data () const { return _data.data; }
+
+    //==== make this thing a vector
+    size_type vec_size() const { return SIZE; }
+    K & vec_access(size_type i) { return _data[i]; }
+    const K & vec_access(size_type i) const { return _data[i]; }
+
+  private:
+    void fill(const K& t)
+    {
+      for (int i=0; i<SIZE; i++)
+        _data[i] = t;
+      clearPadding();
+    }
+
+    void clearPadding()
+    {
+      for (int i=SIZE; i<paddedSize; i++)
+        _data[i] = K(0);
+    }
+  };
+
+/** @} end documentation */
+
+} // end namespace
+
+#endif
@@ -0,0 +1,436 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_COMMUNICATIONSTATISTICS_HH
+#define DUNE_COMMUNICATIONSTATISTICS_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/timer.hh>
+
+/**
+ * @file
+ * @brief Counters for the messages, bytes and times of the
+ * exchanges of a communicator.
+ */
+
+namespace Dune
+{
+  /** @addtogroup Common_Parallel
+   *
+   * @{
+   */
+
+  /**
+   * @brief The counters of one or of several exchanges.
+   */
+  struct ExchangeStatistics
+  {
+    ExchangeStatistics()
+    {
+      clear();
+    }
+
+    /** @brief Set all counters to zero. */
+    void clear()
+    {
+      exchanges = messagesSent = messagesReceived = 0;
+      bytesSent = bytesReceived = 0;
+      packTime = waitTime = unpackTime = totalTime = 0.0;
+    }
+
+    /** @brief Add the counters of other exchanges. */
+    ExchangeStatistics& operator+=(const ExchangeStatistics& other)
+    {
+      exchanges += other.exchanges;
+      messagesSent += other.messagesSent;
+      messagesReceived += other.messagesReceived;
+      bytesSent += other.bytesSent;
+      bytesReceived += other.bytesReceived;
+      packTime += other.packTime;
+      waitTime += other.waitTime;
+      unpackTime += other.unpackTime;
+      totalTime += other.totalTime;
+      return *this;
+    }
+
+    /** @brief The number of exchanges. */
+    unsigned long exchanges;
+    /** @brief The number of messages sent. */
+    unsigned long messagesSent;
+    /** @brief The number of messages received. */
+    unsigned long messagesReceived;
+    /** @brief The number of bytes sent. */
+    unsigned long long bytesSent;
+    /** @brief The number of bytes received. */
+    unsigned long long bytesReceived;
+    /** @brief Seconds spent copying data into send buffers. */
+    double packTime;
+    /** @brief Seconds spent posting and waiting for messages. */
+    double waitTime;
+    /** @brief Seconds spent copying data out of receive buffers. */
+    double unpackTime;
+    /** @brief Wall time of the exchanges in seconds. */
+    double totalTime;
+  };
+
+  /**
+   * @brief The counters of the messages exchanged with one process.
+   */
+  struct NeighbourStatistics
+  {
+    explicit NeighbourStatistics(int rank_=-1)
+      : rank(rank_), messagesSent(0), messagesReceived(0),
+        bytesSent(0), bytesReceived(0), arrivalTime(0.0)
+    {}
+
+    /** @brief The rank of the neighbour. */
+    int rank;
+    /** @brief The number of messages sent to the neighbour. */
+    unsigned long messagesSent;
+    /** @brief The number of messages received from the neighbour. */
+    unsigned long messagesReceived;
+    /** @brief The number of bytes sent to the neighbour. */
+    unsigned long long bytesSent;
+    /** @brief The number of bytes received from the neighbour. */
+    unsigned long long bytesReceived;
+    /**
+     * @brief Sum of the seconds from the start of an exchange until the
+     * message of the neighbour was received.
+     *
+     * Neighbours with a high arrival time are late or send large messages.
+     */
+    double arrivalTime;
+  };
+
+  /**
+   * @brief Instrumentation of the exchanges of a communicator.
+   *
+   * BufferedCommunicator, DatatypeCommunicator, RemoteIndices and
+   * IndicesSyncer own an object of this class, which is disabled by
+   * default. Once enabled, each exchange (a forward or backward
+   * communication, a rebuild of the remote indices or a sync) records
+   * the messages and bytes sent to and received from every neighbour,
+   * and splits its wall time into packing, waiting and unpacking.
+   * The counters of the last exchange and the sums over all exchanges
+   * since the last reset() are kept.
+   *
+   * A disabled object only costs one test per recording call.
+   *
+   * @code
+   * BufferedCommunicator comm;
+   * comm.statistics().setName("halo");
+   * comm.statistics().enable();
+   * comm.build<Vector>(interface);
+   * ...
+   * comm.statistics().writeJSON(file, rank);
+   * @endcode
+   */
+  class CommunicationStatistics
+  {
+    typedef TimerClocks::WallTime Clock;
+
+  public:
+    /** @brief The phases the time of an exchange is split into. */
+    enum Phase {
+      /** @brief Copying data into send buffers. */
+      pack,
+      /** @brief Posting and waiting for messages. */
+      wait,
+      /** @brief Copying data out of receive buffers. */
+      unpack
+    };
+
+    /**
+     * @brief Constructor.
+     * @param name The name used in the output.
+     */
+    explicit CommunicationStatistics(const std::string& name="")
+      : name_(name), enabled_(false), recording_(false)
+    {}
+
+    /** @brief The name used in the output. */
+    const std::string& name() const
+    {
+      return name_;
+    }
+
+    /** @brief Set the name used in the output. */
+    void setName(const std::string& name)
+    {
+      name_ = name;
+    }
+
+    /** @brief Switch recording of the following exchanges on or off. */
+    void enable(bool on=true)
+    {
+      enabled_ = on;
+    }
+
+    /** @brief True if the following exchanges are recorded. */
+    bool enabled() const
+    {
+      return enabled_;
+    }
+
+    /** @brief Clear all counters. */
+    void reset()
+    {
+      total_.clear();
+      last_.clear();
+      neighbours_.clear();
+    }
+
+    /** @brief The sums over all recorded exchanges. */
+    const ExchangeStatistics& total() const
+    {
+      return total_;
+    }
+
+    /** @brief The counters of the last recorded exchange. */
+    const ExchangeStatistics& last() const
+    {
+      return last_;
+    }
+
+    /** @brief The counters of all neighbours, sorted by rank. */
+    const std::vector<NeighbourStatistics>& neighbours() const
+    {
+      return neighbours_;
+    }
+
+    /**
+     * @brief The imbalance of the bytes exchanged with the neighbours.
+     *
+     * @return The maximum over the neighbours of the bytes sent and
+     * received divided by their average, minus one.
+     */
+    double imbalance() const
+    {
+      if(neighbours_.empty())
+        return 0.0;
+      double sum=0, max=0;
+      for(std::size_t i=0; i<neighbours_.size(); ++i){
+        double bytes = neighbours_[i].bytesSent + neighbours_[i].bytesReceived;
+        sum += bytes;
+        max = std::max(max, bytes);
+      }
+      return sum>0 ? max*neighbours_.size()/sum - 1.0 : 0.0;
+    }
+
+    /**
+     * @brief Write the counters as a JSON object.
+     * @param os The stream to write to.
+     * @param rank The rank of this process.
+     */
+    void writeJSON(std::ostream& os, int rank) const;
+
+    /**
+     * @brief Write the counters as CSV.
+     *
+     * Writes a line with the totals, with "all" as neighbour, and a line
+     * with the message counters for every neighbour.
+     * @param os The stream to write to.
+     * @param rank The rank of this process.
+     * @param header Whether to write the line with the column names.
+     */
+    void writeCSV(std::ostream& os, int rank, bool header=true) const;
+
+    /** @name Recording
+     *
+     * Called by the communicators during an exchange.
+     * @{
+     */
+
+    /** @brief Start recording an exchange, if enabled. */
+    void beginExchange()
+    {
+      recording_ = enabled_;
+      if(!recording_)
+        return;
+      last_.clear();
+      last_.exchanges = 1;
+      start_ = lap_ = Clock::now();
+    }
+
+    /** @brief True while an exchange is recorded. */
+    bool recording() const
+    {
+      return recording_;
+    }
+
+    /** @brief Add the time since the last call to the phase. */
+    void lap(Phase phase)
+    {
+      if(!recording_)
+        return;
+      Clock::time_point now = Clock::now();
+      double seconds = Clock::seconds(lap_, now);
+      lap_ = now;
+      switch(phase){
+      case pack :   last_.packTime += seconds; break;
+      case wait :   last_.waitTime += seconds; break;
+      case unpack : last_.unpackTime += seconds; break;
+      }
+    }
+
+    /** @brief Record a message sent to process rank. */
+    void sent(int rank, std::size_t bytes)
+    {
+      if(!recording_)
+        return;
+      ++last_.messagesSent;
+      last_.bytesSent += bytes;
+      NeighbourStatistics& n = neighbour(rank);
+      ++n.messagesSent;
+      n.bytesSent += bytes;
+    }
+
+    /** @brief Record a message received from process rank. */
+    void received(int rank, std::size_t bytes)
+    {
+      if(!recording_)
+        return;
+      ++last_.messagesReceived;
+      last_.bytesReceived += bytes;
+      NeighbourStatistics& n = neighbour(rank);
+      ++n.messagesReceived;
+      n.bytesReceived += bytes;
+      n.arrivalTime += Clock::seconds(start_, Clock::now());
+    }
+
+    /** @brief Finish recording the exchange. */
+    void endExchange()
+    {
+      if(!recording_)
+        return;
+      last_.totalTime = Clock::seconds(start_, Clock::now());
+      total_ += last_;
+      recording_ = false;
+    }
+
+    /** @} */
+
+  private:
+    NeighbourStatistics& neighbour(int rank)
+    {
+      std::vector<NeighbourStatistics>::iterator n = neighbours_.begin();
+      while(n != neighbours_.end() && n->rank < rank)
+        ++n;
+      if(n == neighbours_.end() || n->rank != rank)
+        n = neighbours_.insert(n, NeighbourStatistics(rank));
+      return *n;
+    }
+
+    static void writeJSONString(std::ostream& os, const std::string& s);
+
+    static void writeJSONCounters(std::ostream& os, const ExchangeStatistics& s);
+
+    std::string name_;
+    bool enabled_;
+    bool recording_;
+    ExchangeStatistics total_;
+    ExchangeStatistics last_;
+    std::vector<NeighbourStatistics> neighbours_;
+    Clock::time_point start_;
+    Clock::time_point lap_;
+  };
+
+  /** @} */
+
+#ifndef DOXYGEN
+
+  inline void CommunicationStatistics::writeJSONString(std::ostream& os, const std::string& s)
+  {
+    static const char hex[] = "0123456789abcdef";
+    os<<'"';
+    for(std::size_t i=0; i<s.size(); ++i){
+      unsigned char c = s[i];
+      if(c=='"' || c=='\\')
+        os<<'\\'<<s[i];
+      else if(c<0x20)
+        os<<"\\u00"<<hex[c>>4]<<hex[c&15];
+      else
+        os<<s[i];
+    }
+    os<<'"';
+  }
+
+  inline void CommunicationStatistics::writeJSONCounters(std::ostream& os, const ExchangeStatistics& s)
+  {
+    os<<"\"exchanges\": "<<s.exchanges
+      <<", \"messagesSent\": "<<s.messagesSent
+      <<", \"bytesSent\": "<<s.bytesSent
+      <<", \"messagesReceived\": "<<s.messagesReceived
+      <<", \"bytesReceived\": "<<s.bytesReceived
+      <<", \"packTime\": "<<s.packTime
+      <<", \"waitTime\": "<<s.waitTime
+      <<", \"unpackTime\": "<<s.unpackTime
+      <<", \"totalTime\": "<<s.totalTime;
+  }
+
+  inline void CommunicationStatistics::writeJSON(std::ostream& os, int rank) const
+  {
+    std::streamsize precision = os.precision(9);
+    os<<"{\"rank\": "<<rank<<", \"name\": ";
+    writeJSONString(os, name_);
+    os<<", ";
+    writeJSONCounters(os, total_);
+    os<<", \"imbalance\": "<<imbalance();
+    os<<",\n \"last\": {";
+    writeJSONCounters(os, last_);
+    os<<"},\n \"neighbours\": [";
+    for(std::size_t i=0; i<neighbours_.size(); ++i){
+      const NeighbourStatistics& n = neighbours_[i];
+      os<<(i>0 ? ",\n  " : "\n  ")
+        <<"{\"rank\": "<<n.rank
+        <<", \"messagesSent\": "<<n.messagesSent
+        <<", \"bytesSent\": "<<n.bytesSent
+        <<", \"messagesReceived\": "<<n.messagesReceived
+        <<", \"bytesReceived\": "<<n.bytesReceived
+        <<", \"arrivalTime\": "<<n.arrivalTime<<"}";
+    }
+    os<<"]}\n";
+    os.precision(precision);
+  }
+
+  inline void CommunicationStatistics::writeCSV(std::ostream& os, int rank, bool header) const
+  {
+    std::streamsize precision = os.precision(9);
+    if(header)
+      os<<"rank,name,neighbour,exchanges,messagesSent,bytesSent,messagesReceived,bytesReceived,"
+        <<"packTime,waitTime,unpackTime,totalTime,arrivalTime\n";
+    // names containing separators are quoted
+    std::string name = name_;
+    if(name.find_first_of(",\"\n") != std::string::npos){
+      std::string quoted("\"");
+      for(std::size_t i=0; i<name.size(); ++i){
+        if(name[i]=='"')
+          quoted += '"';
+        quoted += name[i];
+      }
+      name = quoted + '"';
+    }
+    os<<rank<<','<<name<<",all,"<<total_.exchanges<<','
+      <<total_.messagesSent<<','<<total_.bytesSent<<','
+      <<total_.messagesReceived<<','<<total_.bytesReceived<<','
+      <<total_.packTime<<','<<total_.waitTime<<','
+      <<total_.unpackTime<<','<<total_.totalTime<<",\n";
+    for(std::size_t i=0; i<neighbours_.size(); ++i){
+      const NeighbourStatistics& n = neighbours_[i];
+      os<<rank<<','<<name<<','<<n.rank<<",,"
+        <<n.messagesSent<<','<<n.bytesSent<<','
+        <<n.messagesReceived<<','<<n.bytesReceived<<",,,,,"
+        <<n.arrivalTime<<'\n';
+    }
+    os.precision(precision);
+  }
+
+#endif // DOXYGEN
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "remoteindices.hh"
 #include "interface.hh"
+#include "communicationstatistics.hh"
 #include <dune/common/exceptions.hh>
 #include <dune/common/typetraits.hh>
 #include <dune/common/stdstreams.hh>
@@ -289,6 +290,25 @@ namespace Dune
      * @brief Deallocates the MPI requests and data types.
      */
     void free();        
+
+    /**
+     * @brief The instrumentation of forward() and backward().
+     *
+     * The messages are waited for together, so the arrival times of
+     * the neighbours are those of the last message.
+     */
+    CommunicationStatistics& statistics()
+    {
+      return statistics_;
+    }
+
+    /**
+     * @brief The instrumentation of forward() and backward().
+     */
+    const CommunicationStatistics& statistics() const
+    {
+      return statistics_;
+    }
   private:
     enum { 
       /**
@@ -321,6 +341,11 @@ namespace Dune
      * @brief True if the request and data types were created.
      */
     bool created_;
+
+    /**
+     * @brief The instrumentation of the communication.
+     */
+    CommunicationStatistics statistics_;
     
     /**
      * @brief Creates the MPI_Requests for the forward communication.
@@ -337,7 +362,12 @@ namespace Dune
     /**
      * @brief Initiates the sending and receive.
      */
-    void sendRecv(MPI_Request* req);
+    void sendRecv(MPI_Request* req, bool forward);
+
+    /**
+     * @brief Records the size of the messages in the statistics.
+     */
+    void recordMessages(bool forward);
     
     /**
      * @brief Information used for setting up the MPI Datatypes.
@@ -594,6 +624,22 @@ namespace Dune
      * @brief Free the allocated memory (i.e. buffers and message information.
      */
     void free();
+
+    /**
+     * @brief The instrumentation of the forward and backward communication.
+     */
+    CommunicationStatistics& statistics()
+    {
+      return statistics_;
+    }
+
+    /**
+     * @brief The instrumentation of the forward and backward communication.
+     */
+    const CommunicationStatistics& statistics() const
+    {
+      return statistics_;
+    }
     
     /**
      * @brief Destructor.
@@ -877,6 +923,11 @@ namespace Dune
 
     MPI_Comm communicator_;
 
+    /**
+     * @brief The instrumentation of the communication.
+     */
+    CommunicationStatistics statistics_;
+
     /**
      * @brief Send and receive Data.
      */
@@ -1051,18 +1102,34 @@ namespace Dune
   template<typename T>
   void DatatypeCommunicator<T>::forward()
   {
-    sendRecv(requests_[1]);
+    sendRecv(requests_[1], true);
   }
   
   template<typename T>
   void DatatypeCommunicator<T>::backward()
   {
-    sendRecv(requests_[0]);
+    sendRecv(requests_[0], false);
+  }
+
+  template<typename T>
+  void DatatypeCommunicator<T>::recordMessages(bool forward)
+  {
+    typedef MessageTypeMap::const_iterator const_iterator;
+    const const_iterator end=messageTypes.end();
+    
+    for(const_iterator process = messageTypes.begin(); process != end; ++process){
+      int sendSize, recvSize;
+      MPI_Type_size(forward ? process->second.first : process->second.second, &sendSize);
+      MPI_Type_size(forward ? process->second.second : process->second.first, &recvSize);
+      statistics_.sent(process->first, sendSize);
+      statistics_.received(process->first, recvSize);
+    }
   }
 
   template<typename T>
-  void DatatypeCommunicator<T>::sendRecv(MPI_Request* requests)
+  void DatatypeCommunicator<T>::sendRecv(MPI_Request* requests, bool forward)
   {
+    statistics_.beginExchange();
     int noMessages = messageTypes.size();
     // Start the receive calls first
     MPI_Startall(noMessages, requests);
@@ -1076,6 +1143,9 @@ namespace Dune
     
     int send = MPI_Waitall(noMessages, requests+noMessages, status+noMessages);
     int receive = MPI_Waitall(noMessages, requests, status);
+    if(statistics_.recording())
+      recordMessages(forward);
+    statistics_.lap(CommunicationStatistics::wait);
     
     // Error checks
     int success=1, globalSuccess=0;
@@ -1118,6 +1188,7 @@ namespace Dune
     MPI_Allreduce(&success, &globalSuccess, 1, MPI_INT, MPI_MIN, this->remoteIndices_->communicator());
     
     delete[] status;
+    statistics_.endExchange();
 
     if(!globalSuccess)
       DUNE_THROW(CommunicationError, "A communication error occurred!");
@@ -1407,7 +1478,9 @@ namespace Dune
     }
     typedef typename CommPolicy<Data>::IndexedTypeFlag Flag;
 
+    statistics_.beginExchange();
     MessageGatherer<Data,GatherScatter,FORWARD,Flag>()(interfaces_, source, sendBuffer, sendBufferSize);
+    statistics_.lap(CommunicationStatistics::pack);
     
     MPI_Request* sendRequests = new MPI_Request[messageInformation_.size()];
     MPI_Request* recvRequests = new MPI_Request[messageInformation_.size()];
@@ -1446,12 +1519,14 @@ namespace Dune
 	MPI_Issend(sendBuffer+info->second.first.start_, info->second.first.size_,
 		   MPI_BYTE, info->first, commTag_, communicator_,
 		   sendRequests+i);
+        statistics_.sent(info->first, info->second.first.size_);
       }else{
 	assert(info->second.second.start_*sizeof(typename CommPolicy<Data>::IndexedType)+info->second.second.size_ <= sendBufferSize );
         Dune::dvverb<<rank<<": sending "<<info->second.second.size_<<" to "<<info->first<<std::endl;
 	MPI_Issend(sendBuffer+info->second.second.start_, info->second.second.size_,
 		   MPI_BYTE, info->first, commTag_, communicator_,
 		   sendRequests+i);
+        statistics_.sent(info->first, info->second.second.size_);
       }
     
     // Wait for completion of receive and immediately start scatter
@@ -1473,8 +1548,11 @@ namespace Dune
 
 	MessageInformation info = (FORWARD)? infoIter->second.second : infoIter->second.first;
 	assert(info.start_+info.size_ <= recvBufferSize);
+        statistics_.received(proc, info.size_);
+        statistics_.lap(CommunicationStatistics::wait);
 
 	MessageScatterer<Data,GatherScatter,FORWARD,Flag>()(interfaces_, dest, recvBuffer+info.start_, proc);
+        statistics_.lap(CommunicationStatistics::unpack);
       }else{
 	std::cerr<<rank<<": MPI_Error occurred while receiving message from "<<processMap[finished]<<std::endl;
 	//success=0;
@@ -1489,6 +1567,8 @@ namespace Dune
 	std::cerr<<rank<<": MPI_Error occurred while sending message to "<<processMap[finished]<<std::endl;
 	//success=0;
       }
+    statistics_.lap(CommunicationStatistics::wait);
+    statistics_.endExchange();
     /*
     int globalSuccess;
     MPI_Allreduce(&success, &globalSuccess, 1, MPI_INT, MPI_MIN, interface_->communicator());
@@ -0,0 +1,749 @@
+// $Id$
+#ifndef DUNE_COMPACTINDEXSET_HH
+#define DUNE_COMPACTINDEXSET_HH
+
+#include<algorithm>
+#include<cassert>
+#include<cstddef>
+#include<iostream>
+#include<vector>
+
+#include<dune/common/exceptions.hh>
+#include<dune/common/iteratorfacades.hh>
+#include<dune/common/typetraits.hh>
+
+#include"indexset.hh"
+#include"plocalindex.hh"
+
+namespace Dune
+{
+  /** @addtogroup Common_Parallel
+   *
+   * @{
+   */
+  /**
+   * @file
+   * @brief Provides an index set storing global indices, local indices
+   * and attributes in separate contiguous arrays.
+   */
+
+  template<class TG, class TA>
+  class CompactParallelIndexSet;
+
+  /**
+   * @brief Proxy giving IndexPair-like access to one entry of a
+   * CompactParallelIndexSet.
+   *
+   * Reading the local index yields a ParallelLocalIndex by value that
+   * is assembled from the separate arrays. Modifications have to be
+   * done through the set methods of this proxy.
+   * @tparam S The type of the index set (const qualified for read
+   * only access).
+   */
+  template<class S>
+  class CompactIndexPairReference
+  {
+    template<class> friend class CompactIndexSetIterator;
+    friend class CompactParallelIndexSet<typename S::GlobalIndex, typename S::Attribute>;
+
+  public:
+    /** @brief The type of the global index. */
+    typedef typename S::GlobalIndex GlobalIndex;
+
+    /** @brief The type of the attribute. */
+    typedef typename S::Attribute Attribute;
+
+    /** @brief The type of the local index. */
+    typedef typename S::LocalIndex LocalIndex;
+
+    /** @brief The type of the index pair this proxy represents. */
+    typedef typename S::IndexPair IndexPair;
+
+    /** @brief Get the global index. */
+    const GlobalIndex& global() const
+    {
+      return set_->globals_[position_];
+    }
+
+    /** @brief Get the local index together with attribute and flags. */
+    LocalIndex local() const
+    {
+      LocalIndex index(set_->locals_[position_], Attribute(set_->attributes_[position_]),
+                       set_->flags_[position_] & S::publicFlag);
+      if(set_->flags_[position_] & S::deletedFlag)
+        index.setState(DELETED);
+      return index;
+    }
+
+    /** @brief Get the local index number. */
+    std::size_t localIndex() const
+    {
+      return set_->locals_[position_];
+    }
+
+    /** @brief Get the attribute of the index. */
+    Attribute attribute() const
+    {
+      return Attribute(set_->attributes_[position_]);
+    }
+
+    /** @brief Check whether the index might also be known to other processes. */
+    bool isPublic() const
+    {
+      return set_->flags_[position_] & S::publicFlag;
+    }
+
+    /** @brief Get the state of the local index. */
+    LocalIndexState state() const
+    {
+      return (set_->flags_[position_] & S::deletedFlag) ? DELETED : VALID;
+    }
+
+    /** @brief Set the local index number. */
+    void setLocal(std::size_t index) const
+    {
+      set_->locals_[position_] = index;
+    }
+
+    /** @brief Set the attribute of the index. */
+    void setAttribute(const Attribute& attribute) const
+    {
+      set_->attributes_[position_] = static_cast<char>(attribute);
+    }
+
+    /** @brief Convert to a real index pair. */
+    operator IndexPair() const
+    {
+      return IndexPair(global(), local());
+    }
+
+  private:
+    CompactIndexPairReference()
+      : set_(0), position_(0)
+    {}
+
+    CompactIndexPairReference(S& set, std::size_t position)
+      : set_(&set), position_(position)
+    {}
+
+    /** @brief The index set we refer into. */
+    S* set_;
+    /** @brief The position of the entry in the arrays. */
+    std::size_t position_;
+  };
+
+  /**
+   * @brief Print an entry of a compact index set.
+   * @param os The outputstream to print to.
+   * @param pair The entry to print.
+   */
+  template<class S>
+  inline std::ostream& operator<<(std::ostream& os, const CompactIndexPairReference<S>& pair)
+  {
+    os<<"{global="<<pair.global()<<", local="<<pair.local()<<"}";
+    return os;
+  }
+
+  /**
+   * @brief Iterator over the entries of a CompactParallelIndexSet.
+   *
+   * Dereferencing yields a CompactIndexPairReference, so code written
+   * against the IndexPair interface (global(), local()) works unchanged.
+   */
+  template<class S>
+  class CompactIndexSetIterator
+    : public BidirectionalIteratorFacade<CompactIndexSetIterator<S>,
+                                         const CompactIndexPairReference<S>,
+                                         const CompactIndexPairReference<S>&,
+                                         std::ptrdiff_t>
+  {
+    friend class CompactIndexSetIterator<typename remove_const<S>::type>;
+    friend class CompactIndexSetIterator<const typename remove_const<S>::type>;
+    friend class CompactParallelIndexSet<typename S::GlobalIndex, typename S::Attribute>;
+
+  public:
+    CompactIndexSetIterator()
+    {}
+
+    CompactIndexSetIterator(S& set, std::size_t position)
+      : reference_(set, position)
+    {}
+
+    CompactIndexSetIterator(const CompactIndexSetIterator<typename remove_const<S>::type>& other)
+    {
+      reference_.set_ = other.reference_.set_;
+      reference_.position_ = other.reference_.position_;
+    }
+
+    bool equals(const CompactIndexSetIterator<typename remove_const<S>::type>& other) const
+    {
+      return reference_.position_ == other.reference_.position_;
+    }
+
+    bool equals(const CompactIndexSetIterator<const typename remove_const<S>::type>& other) const
+    {
+      return reference_.position_ == other.reference_.position_;
+    }
+
+    const CompactIndexPairReference<S>& dereference() const
+    {
+      return reference_;
+    }
+
+    void increment()
+    {
+      ++reference_.position_;
+    }
+
+    void decrement()
+    {
+      --reference_.position_;
+    }
+
+    /** @brief Get the position of the entry in the underlying arrays. */
+    std::size_t position() const
+    {
+      return reference_.position_;
+    }
+
+  private:
+    CompactIndexPairReference<S> reference_;
+  };
+
+  /**
+   * @brief Index set for ParallelLocalIndex with a structure of arrays layout.
+   *
+   * In ParallelIndexSet every IndexPair stores the global index, the
+   * local index, the attribute, the public flag and the state
+   * together, padded to 24 or 32 bytes. This class keeps the global
+   * indices, the local indices, and the attribute and flag bytes in
+   * separate contiguous arrays. Binary searches for a global index
+   * therefore only touch the global keys and a scan over the attributes
+   * only touches one byte per index.
+   *
+   * The interface mirrors the one of ParallelIndexSet. As there are no
+   * IndexPair objects stored the iterators yield proxies
+   * (CompactIndexPairReference) instead of references. Therefore this
+   * class cannot be used where pointers to the pairs are kept, e.g. in
+   * RemoteIndices.
+   *
+   * @tparam TG The type of the global index.
+   * @tparam TA The type of the attribute (see ParallelLocalIndex).
+   */
+  template<class TG, class TA>
+  class CompactParallelIndexSet
+  {
+    friend class CompactIndexPairReference<CompactParallelIndexSet<TG,TA> >;
+    friend class CompactIndexPairReference<const CompactParallelIndexSet<TG,TA> >;
+
+  public:
+    /**
+     * @brief the type of the global index.
+     * This type has to provide at least a operator&lt; for sorting.
+     */
+    typedef TG GlobalIndex;
+
+    /** @brief The type of the attribute. */
+    typedef TA Attribute;
+
+    /** @brief The type of the local index. */
+    typedef ParallelLocalIndex<Attribute> LocalIndex;
+
+    /** @brief The type of the pair represented by the entries. */
+    typedef Dune::IndexPair<GlobalIndex,LocalIndex> IndexPair;
+
+    /** @brief Proxy for modifiable access to an entry. */
+    typedef CompactIndexPairReference<CompactParallelIndexSet<TG,TA> > reference;
+
+    /** @brief Proxy for read only access to an entry. */
+    typedef CompactIndexPairReference<const CompactParallelIndexSet<TG,TA> > const_reference;
+
+    /** @brief The iterator over the entries. */
+    typedef CompactIndexSetIterator<CompactParallelIndexSet<TG,TA> > iterator;
+
+    /** @brief The constant iterator over the entries. */
+    typedef CompactIndexSetIterator<const CompactParallelIndexSet<TG,TA> > const_iterator;
+
+    enum {
+      /** @brief Flag bit marking a public index. */
+      publicFlag=1,
+      /** @brief Flag bit marking a deleted index. */
+      deletedFlag=2
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    CompactParallelIndexSet();
+
+    /**
+     * @brief Get the state the index set is in.
+     * @return The state of the index set.
+     */
+    inline const ParallelIndexSetState& state()
+    {
+      return state_;
+    }
+
+    /**
+     * @brief Indicate that the index set is to be resized.
+     * @exception InvalidState If index set was not in
+     * ParallelIndexSetState::GROUND mode.
+     */
+    void beginResize() throw(InvalidIndexSetState);
+
+    /**
+     * @brief Add an new index to the set.
+     *
+     * The local index is created by the default constructor.
+     * @param global The globally unique id of the index.
+     * @exception InvalidState If index set is not in
+     * ParallelIndexSetState::RESIZE mode.
+     */
+    inline void add(const GlobalIndex& global) throw(InvalidIndexSetState);
+
+    /**
+     * @brief Add an new index to the set.
+     *
+     * @param global The globally unique id of the index.
+     * @param local The local index.
+     * @exception InvalidState If index set is not in
+     * ParallelIndexSetState::RESIZE mode.
+     */
+    inline void add(const GlobalIndex& global, const LocalIndex& local)
+      throw(InvalidIndexSetState);
+
+    /**
+     * @brief Mark an index as deleted.
+     *
+     * The index will be deleted during endResize().
+     * @param position An iterator at the position we want to delete.
+     * @exception InvalidState If index set is not in ParallelIndexSetState::RESIZE mode.
+     */
+    inline void markAsDeleted(const iterator& position)
+      throw(InvalidIndexSetState);
+
+    /**
+     * @brief Indicate that the resizing finishes.
+     *
+     * @warning Invalidates all iterators of this index set.
+     * @exception InvalidState If index set was not in
+     * ParallelIndexSetState::RESIZE mode.
+     */
+    void endResize() throw(InvalidIndexSetState);
+
+    /**
+     * @brief Find the entry with a specific global id.
+     *
+     * The binary search only touches the array of global indices.
+     * @param global The globally unique id of the pair.
+     * @return Proxy of the entry for the id.
+     * @warning If the global index is not in the set a wrong entry
+     * might be returned. To be save use the throwing alternative at.
+     */
+    inline reference operator[](const GlobalIndex& global);
+
+    /**
+     * @brief Find the entry with a specific global id.
+     *
+     * @param global The globally unique id of the pair.
+     * @return Proxy of the entry for the id.
+     * @exception RangeError Thrown if the global id is not known.
+     */
+    inline reference at(const GlobalIndex& global);
+
+    /**
+     * @brief Find the entry with a specific global id.
+     *
+     * @param global The globally unique id of the pair.
+     * @return Proxy of the entry for the id.
+     * @warning If the global index is not in the set a wrong entry
+     * might be returned. To be save use the throwing alternative at.
+     */
+    inline const_reference operator[](const GlobalIndex& global) const;
+
+    /**
+     * @brief Find the entry with a specific global id.
+     *
+     * @param global The globally unique id of the pair.
+     * @return Proxy of the entry for the id.
+     * @exception RangeError Thrown if the global id is not known.
+     */
+    inline const_reference at(const GlobalIndex& global) const;
+
+    /**
+     * @brief Find the entry with a specific global id.
+     * @param global The globally unique id.
+     * @return An iterator positioned at the entry or end() if the id is unknown.
+     */
+    inline const_iterator find(const GlobalIndex& global) const;
+
+    /**
+     * @brief Get an iterator over the indices positioned at the first index.
+     * @return Iterator over the local indices.
+     */
+    inline iterator begin();
+
+    /**
+     * @brief Get an iterator over the indices positioned after the last index.
+     * @return Iterator over the local indices.
+     */
+    inline iterator end();
+
+    /**
+     * @brief Get an iterator over the indices positioned at the first index.
+     * @return Iterator over the local indices.
+     */
+    inline const_iterator begin() const;
+
+    /**
+     * @brief Get an iterator over the indices positioned after the last index.
+     * @return Iterator over the local indices.
+     */
+    inline const_iterator end() const;
+
+    /**
+     * @brief Renumbers the local index numbers.
+     *
+     * After this function returns the indices are
+     * consecutively numbered beginning from 0 in the
+     * order of the global indices.
+     */
+    inline void renumberLocal();
+
+    /**
+     * @brief Get the internal sequence number.
+     *
+     * Is initially 0 is incremented for each resize.
+     * @return The sequence number.
+     */
+    inline int seqNo() const;
+
+    /**
+     * @brief Get the total number (public and nonpublic) indices.
+     * @return The total number (public and nonpublic) indices.
+     */
+    inline size_t size() const;
+
+    /**
+     * @brief Get the sorted array of all global indices.
+     */
+    inline const std::vector<GlobalIndex>& globalIndices() const;
+
+  private:
+    /** @brief The sorted global indices. */
+    std::vector<GlobalIndex> globals_;
+    /** @brief The local index numbers. */
+    std::vector<std::size_t> locals_;
+    /** @brief The attributes stored as char as in ParallelLocalIndex. */
+    std::vector<char> attributes_;
+    /** @brief The public and deleted flags. */
+    std::vector<unsigned char> flags_;
+    /** @brief The new indices for the RESIZE state. */
+    std::vector<IndexPair> newIndices_;
+    /** @brief The state of the index set. */
+    ParallelIndexSetState state_;
+    /** @brief Number to keep track of the number of resizes. */
+    int seqNo_;
+    /** @brief Whether entries were deleted in resize mode. */
+    bool deletedEntries_;
+
+    /** @brief Position of the first global index not less than global. */
+    inline std::size_t lowerBound(const GlobalIndex& global) const;
+
+    /** @brief Position of the entry for global, throwing if not found. */
+    inline std::size_t position(const GlobalIndex& global) const;
+
+    /** @brief Append an entry to the arrays. */
+    inline void push_back(const GlobalIndex& global, std::size_t local,
+                          char attribute, unsigned char flags);
+
+    /**
+     * @brief Merges the current arrays and the new indices into new arrays.
+     */
+    inline void merge();
+  };
+
+  /**
+   * @brief Print an index set.
+   * @param os The outputstream to print to.
+   * @param indexSet The index set to print.
+   */
+  template<class TG, class TA>
+  inline std::ostream& operator<<(std::ostream& os, const CompactParallelIndexSet<TG,TA>& indexSet)
+  {
+    typedef typename CompactParallelIndexSet<TG,TA>::const_iterator Iterator;
+    Iterator end = indexSet.end();
+    os<<"{";
+    for(Iterator index = indexSet.begin(); index != end; ++index)
+      os<<*index<<" ";
+    os<<"}";
+    return os;
+  }
+
+#ifndef DOXYGEN
+
+  template<class TG, class TA>
+  CompactParallelIndexSet<TG,TA>::CompactParallelIndexSet()
+    : state_(GROUND), seqNo_(0), deletedEntries_(false)
+  {}
+
+  template<class TG, class TA>
+  void CompactParallelIndexSet<TG,TA>::beginResize() throw(InvalidIndexSetState)
+  {
+    // Checks in unproductive code
+#ifndef NDEBUG
+    if(state_!=GROUND)
+      DUNE_THROW(InvalidIndexSetState,
+                 "IndexSet has to be in GROUND state, when "
+                 << "beginResize() is called!");
+#endif
+
+    state_ = RESIZE;
+    deletedEntries_ = false;
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::add(const GlobalIndex& global)
+    throw(InvalidIndexSetState)
+  {
+    // Checks in unproductive code
+#ifndef NDEBUG
+    if(state_ != RESIZE)
+      DUNE_THROW(InvalidIndexSetState, "Indices can only be added "
+                 <<"while in RESIZE state!");
+#endif
+    newIndices_.push_back(IndexPair(global));
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::add(const GlobalIndex& global,
+                                                  const LocalIndex& local)
+    throw(InvalidIndexSetState)
+  {
+    // Checks in unproductive code
+#ifndef NDEBUG
+    if(state_ != RESIZE)
+      DUNE_THROW(InvalidIndexSetState, "Indices can only be added "
+                 <<"while in RESIZE state!");
+#endif
+    newIndices_.push_back(IndexPair(global,local));
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::markAsDeleted(const iterator& position)
+    throw(InvalidIndexSetState)
+  {
+    // Checks in unproductive code
+#ifndef NDEBUG
+    if(state_ != RESIZE)
+      DUNE_THROW(InvalidIndexSetState, "Indices can only be removed "
+                 <<"while in RESIZE state!");
+#endif
+    deletedEntries_ = true;
+    flags_[position.position()] |= deletedFlag;
+  }
+
+  template<class TG, class TA>
+  void CompactParallelIndexSet<TG,TA>::endResize() throw(InvalidIndexSetState)
+  {
+    // Checks in unproductive code
+#ifndef NDEBUG
+    if(state_ != RESIZE)
+      DUNE_THROW(InvalidIndexSetState, "endResize called while not "
+                 <<"in RESIZE state!");
+#endif
+
+    std::sort(newIndices_.begin(), newIndices_.end(), IndexSetSortFunctor<TG,LocalIndex>());
+    merge();
+    seqNo_++;
+    state_ = GROUND;
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::push_back(const GlobalIndex& global,
+                                                        std::size_t local,
+                                                        char attribute,
+                                                        unsigned char flags)
+  {
+    globals_.push_back(global);
+    locals_.push_back(local);
+    attributes_.push_back(attribute);
+    flags_.push_back(flags);
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::merge()
+  {
+    if(newIndices_.size()==0 && !deletedEntries_)
+      return;
+
+    CompactParallelIndexSet<TG,TA> merged;
+    std::size_t capacity=globals_.size()+newIndices_.size();
+    merged.globals_.reserve(capacity);
+    merged.locals_.reserve(capacity);
+    merged.attributes_.reserve(capacity);
+    merged.flags_.reserve(capacity);
+
+    typedef typename std::vector<IndexPair>::const_iterator AddedIterator;
+    std::size_t old=0;
+    const std::size_t endold=globals_.size();
+    AddedIterator added=newIndices_.begin();
+    const AddedIterator endadded=newIndices_.end();
+
+    while(old != endold || added != endadded)
+      {
+        if(old != endold && (flags_[old] & deletedFlag)){
+          ++old;
+          continue;
+        }
+        if(old != endold &&
+           (added == endadded || globals_[old] < added->global() ||
+            (globals_[old] == added->global() &&
+             LocalIndexComparator<LocalIndex>::compare(const_reference(*this, old).local(),
+                                                       added->local()))))
+          {
+            merged.push_back(globals_[old], locals_[old], attributes_[old], flags_[old]);
+            ++old;
+          }
+        else
+          {
+            const LocalIndex& local=added->local();
+            merged.push_back(added->global(), local.local(),
+                             static_cast<char>(local.attribute()),
+                             local.isPublic() ? publicFlag : 0);
+            ++added;
+          }
+      }
+
+    globals_.swap(merged.globals_);
+    locals_.swap(merged.locals_);
+    attributes_.swap(merged.attributes_);
+    flags_.swap(merged.flags_);
+    newIndices_.clear();
+  }
+
+  template<class TG, class TA>
+  inline std::size_t
+  CompactParallelIndexSet<TG,TA>::lowerBound(const GlobalIndex& global) const
+  {
+    return std::lower_bound(globals_.begin(), globals_.end(), global) - globals_.begin();
+  }
+
+  template<class TG, class TA>
+  inline std::size_t
+  CompactParallelIndexSet<TG,TA>::position(const GlobalIndex& global) const
+  {
+    if(globals_.size()==0)
+      DUNE_THROW(RangeError, "No entries!");
+
+    std::size_t pos=lowerBound(global);
+
+    if(pos==globals_.size() || globals_[pos] != global)
+      DUNE_THROW(RangeError, "Could not find entry of "<<global);
+    return pos;
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::reference
+  CompactParallelIndexSet<TG,TA>::operator[](const GlobalIndex& global)
+  {
+    return reference(*this, lowerBound(global));
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::reference
+  CompactParallelIndexSet<TG,TA>::at(const GlobalIndex& global)
+  {
+    return reference(*this, position(global));
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::const_reference
+  CompactParallelIndexSet<TG,TA>::operator[](const GlobalIndex& global) const
+  {
+    return const_reference(*this, lowerBound(global));
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::const_reference
+  CompactParallelIndexSet<TG,TA>::at(const GlobalIndex& global) const
+  {
+    return const_reference(*this, position(global));
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::const_iterator
+  CompactParallelIndexSet<TG,TA>::find(const GlobalIndex& global) const
+  {
+    std::size_t pos=lowerBound(global);
+    if(pos!=globals_.size() && globals_[pos]==global)
+      return const_iterator(*this, pos);
+    return end();
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::iterator
+  CompactParallelIndexSet<TG,TA>::begin()
+  {
+    return iterator(*this, 0);
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::iterator
+  CompactParallelIndexSet<TG,TA>::end()
+  {
+    return iterator(*this, globals_.size());
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::const_iterator
+  CompactParallelIndexSet<TG,TA>::begin() const
+  {
+    return const_iterator(*this, 0);
+  }
+
+  template<class TG, class TA>
+  inline typename CompactParallelIndexSet<TG,TA>::const_iterator
+  CompactParallelIndexSet<TG,TA>::end() const
+  {
+    return const_iterator(*this, globals_.size());
+  }
+
+  template<class TG, class TA>
+  inline void CompactParallelIndexSet<TG,TA>::renumberLocal()
+  {
+#ifndef NDEBUG
+    if(state_==RESIZE)
+      DUNE_THROW(InvalidIndexSetState, "IndexSet has to be in "
+                 <<"GROUND state for renumberLocal()");
+#endif
+    for(std::size_t i=0; i < locals_.size(); ++i)
+      locals_[i]=i;
+  }
+
+  template<class TG, class TA>
+  inline int CompactParallelIndexSet<TG,TA>::seqNo() const
+  {
+    return seqNo_;
+  }
+
+  template<class TG, class TA>
+  inline size_t CompactParallelIndexSet<TG,TA>::size() const
+  {
+    return globals_.size();
+  }
+
+  template<class TG, class TA>
+  inline const std::vector<TG>&
+  CompactParallelIndexSet<TG,TA>::globalIndices() const
+  {
+    return globals_;
+  }
+
+#endif // DOXYGEN
+
+  /** @} */
+} // namespace Dune
+
+#endif
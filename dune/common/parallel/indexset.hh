@@ -5,6 +5,7 @@
 #include<algorithm>
 #include<dune/common/arraylist.hh>
 #include<dune/common/exceptions.hh>
+#include<dune/common/hash.hh>
 #include<iostream>
 
 #include"localindex.hh"
@@ -684,6 +685,21 @@ namespace Dune
     return a.global_>=b.global_;
   }
   
+#if HAVE_DUNE_HASH
+  /**
+   * @brief Hashes the global index, which alone determines equality of index pairs.
+   *
+   * The hash of the global index is mixed with hash_mix(), so consecutive
+   * integral global indices are spread over the hash table.
+   */
+  template<class TG, class TL>
+  inline std::size_t hash_value(const IndexPair<TG,TL>& pair)
+  {
+    Dune::hash<TG> hasher;
+    return hash_mix(hasher(pair.global()));
+  }
+#endif // HAVE_DUNE_HASH
+
   template<class TG, class TL>
   inline bool operator==(const IndexPair<TG,TL>& a, const TG& b)
   {
@@ -1133,4 +1149,7 @@ namespace Dune
 #endif // DOXYGEN
 
 }
+
+DUNE_DEFINE_HASH(DUNE_HASH_TEMPLATE_ARGS(class TG, class TL),DUNE_HASH_TYPE(Dune::IndexPair<TG,TL>))
+
 #endif 
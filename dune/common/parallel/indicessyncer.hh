@@ -4,6 +4,7 @@
 
 #include"indexset.hh"
 #include"remoteindices.hh"
+#include"communicationstatistics.hh"
 #include<dune/common/stdstreams.hh>
 #include<dune/common/tuples.hh>
 #include<dune/common/sllist.hh>
@@ -90,6 +91,18 @@ namespace Dune
      */
     template<typename T1>
     void sync(T1& numberer);
+
+    /** @brief The instrumentation of sync(). */
+    CommunicationStatistics& statistics()
+    {
+      return statistics_;
+    }
+
+    /** @brief The instrumentation of sync(). */
+    const CommunicationStatistics& statistics() const
+    {
+      return statistics_;
+    }
     
   private:    
     
@@ -110,6 +123,9 @@ namespace Dune
     
     /** @brief The size of the receive buffer in bytes. */
     int receiveBufferSize_; // int because of MPI
+
+    /** @brief The instrumentation of the sync. */
+    CommunicationStatistics statistics_;
     
     /**
      * @brief Information about the messages to send to a neighbouring process.
@@ -769,6 +785,8 @@ namespace Dune
 
     const RemoteIterator end = remoteIndices_.end();
     
+    statistics_.beginExchange();
+
     // Number of neighbours might change during the syncing.
     // save the old neighbours
     std::size_t noOldNeighbours = remoteIndices_.neighbours();
@@ -853,6 +871,7 @@ namespace Dune
 	if(MPI_SUCCESS!=statuses[i].MPI_ERROR)
 	  std::cerr<<"Destination "<<statuses[i].MPI_SOURCE<<" error code: "<<statuses[i].MPI_ERROR<<std::endl;
     }
+    statistics_.lap(CommunicationStatistics::wait);
   
     delete[] statuses;
     delete[] requests;
@@ -877,6 +896,8 @@ namespace Dune
 	
     // update the sequence number
     remoteIndices_.sourceSeqNo_ = remoteIndices_.destSeqNo_ = indexSet_.seqNo();    
+    statistics_.lap(CommunicationStatistics::unpack);
+    statistics_.endExchange();
   }
   
   template<typename T>
@@ -978,7 +999,9 @@ namespace Dune
 
     Dune::dverb << rank_<<": Sending message of "<<bpos<<" bytes to "<<destination<<std::endl;
     
+    statistics_.lap(CommunicationStatistics::pack);
     MPI_Issend(buffer, bpos, MPI_PACKED, destination, 345, remoteIndices_.communicator(),&request);
+    statistics_.sent(destination, bpos);
   }
 
   template<typename T>
@@ -1066,6 +1089,8 @@ namespace Dune
     }
 
     MPI_Recv(receiveBuffer_, count, MPI_PACKED, source, 345, remoteIndices_.communicator(), &status);
+    statistics_.received(source, count);
+    statistics_.lap(CommunicationStatistics::wait);
     
     // How many global entries were published?
     MPI_Unpack(receiveBuffer_,  count, &bpos, &publish, 1, MPI_INT, remoteIndices_.communicator());
@@ -1157,6 +1182,7 @@ namespace Dune
     }
     
     resetIteratorsMap();
+    statistics_.lap(CommunicationStatistics::unpack);
   }
   
   template<typename T>
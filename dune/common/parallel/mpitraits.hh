@@ -72,6 +72,8 @@ namespace Dune
   ComposeMPITraits(unsigned int,MPI_UNSIGNED);
   ComposeMPITraits(long,MPI_LONG);
   ComposeMPITraits(unsigned long,MPI_UNSIGNED_LONG);
+  ComposeMPITraits(long long,MPI_LONG_LONG_INT);
+  ComposeMPITraits(unsigned long long,MPI_UNSIGNED_LONG_LONG);
   ComposeMPITraits(float,MPI_FLOAT);
   ComposeMPITraits(double,MPI_DOUBLE);
   ComposeMPITraits(long double,MPI_LONG_DOUBLE);
@@ -95,12 +97,14 @@ namespace Dune
 	FieldVector<K,n> fvector;
 	MPI_Aint base;
 	MPI_Aint displ;
-	MPI_Address(&fvector, &base);
-	MPI_Address(&(fvector[0]), &displ);
+	MPI_Get_address(&fvector, &base);
+	MPI_Get_address(&(fvector[0]), &displ);
 	displ -= base;
 	int length[1]={1};
-	    
-	MPI_Type_struct(1, length, &displ, &vectortype, &datatype);
+	MPI_Datatype tmp;
+	MPI_Type_create_struct(1, length, &displ, &vectortype, &tmp);
+	MPI_Type_create_resized(tmp, 0, sizeof(FieldVector<K,n>), &datatype);
+	MPI_Type_free(&tmp);
 	MPI_Type_commit(&datatype);
       }
       return datatype;
@@ -114,9 +118,57 @@ namespace Dune
   MPI_Datatype MPITraits<FieldVector<K,n> >::vectortype = {MPI_DATATYPE_NULL};
 
 
+  template<class K, int n> class PaddedFieldVector;
+
+  /**
+   * @brief Transfers the n entries of a PaddedFieldVector without the padding.
+   *
+   * The type signature equals that of FieldVector<K,n>, so padded and
+   * natural vectors can be sent and received interchangeably. The
+   * extent is the padded size, so arrays of padded vectors work, too.
+   */
+  template<class K, int n>
+  struct MPITraits<PaddedFieldVector<K,n> >
+  {
+    static MPI_Datatype datatype;
+    static MPI_Datatype vectortype;
+
+    static inline MPI_Datatype getType()
+    {
+      if(datatype==MPI_DATATYPE_NULL){
+	MPI_Type_contiguous(n, MPITraits<K>::getType(), &vectortype);
+	MPI_Type_commit(&vectortype);
+	PaddedFieldVector<K,n> fvector;
+	MPI_Aint base;
+	MPI_Aint displ;
+	MPI_Get_address(&fvector, &base);
+	MPI_Get_address(&(fvector[0]), &displ);
+	displ -= base;
+	int length[1]={1};
+	MPI_Datatype unpadded;
+	MPI_Type_create_struct(1, length, &displ, &vectortype, &unpadded);
+	MPI_Type_create_resized(unpadded, 0, sizeof(PaddedFieldVector<K,n>), &datatype);
+	MPI_Type_free(&unpadded);
+	MPI_Type_commit(&datatype);
+      }
+      return datatype;
+    }
+
+  };
+
+  template<class K, int n>
+  MPI_Datatype MPITraits<PaddedFieldVector<K,n> >::datatype = MPI_DATATYPE_NULL;
+  template<class K, int n>
+  MPI_Datatype MPITraits<PaddedFieldVector<K,n> >::vectortype = MPI_DATATYPE_NULL;
+
   template<int k>
   class bigunsignedint;
   
+  /**
+   * @brief Transfers the limbs of a bigunsignedint.
+   *
+   * This allows bigunsignedint as global index of a ParallelIndexSet.
+   */
   template<int k>
   struct MPITraits<bigunsignedint<k> >
   {
@@ -126,17 +178,20 @@ namespace Dune
     static inline MPI_Datatype getType()
     {
       if(datatype==MPI_DATATYPE_NULL){
-	MPI_Type_contiguous(bigunsignedint<k>::n, MPITraits<unsigned short>::getType(),
+	MPI_Type_contiguous(bigunsignedint<k>::n, MPITraits<typename bigunsignedint<k>::limb_type>::getType(),
 			    &vectortype);
 	//MPI_Type_commit(&vectortype);
 	bigunsignedint<k> data;
 	MPI_Aint base;
 	MPI_Aint displ;
-	MPI_Address(&data, &base);
-	MPI_Address(&(data.digit), &displ);
+	MPI_Get_address(&data, &base);
+	MPI_Get_address(&(data.digit), &displ);
 	displ -= base;
 	int length[1]={1};	
-	MPI_Type_struct(1, length, &displ, &vectortype, &datatype);
+	MPI_Datatype tmp;
+	MPI_Type_create_struct(1, length, &displ, &vectortype, &tmp);
+	MPI_Type_create_resized(tmp, 0, sizeof(bigunsignedint<k>), &datatype);
+	MPI_Type_free(&tmp);
 	MPI_Type_commit(&datatype);
       }
       return datatype;
@@ -163,19 +218,21 @@ namespace Dune
   MPI_Datatype MPITraits<std::pair<T1,T2> >::getType()
     {
     if(type==MPI_DATATYPE_NULL){
-      int length[4];
-      MPI_Aint disp[4];
-      MPI_Datatype types[4] = {MPI_LB, MPITraits<T1>::getType(), 
-			       MPITraits<T2>::getType(), MPI_UB};
-      std::pair<T1,T2> rep[2];
-      length[0]=length[1]=length[2]=length[3]=1;
-      MPI_Address(rep, disp); // lower bound of the datatype
-      MPI_Address(&(rep[0].first), disp+1);
-      MPI_Address(&(rep[0].second), disp+2);
-      MPI_Address(rep+1, disp+3); // upper bound of the datatype
-      for(int i=3; i >= 0; --i)
-	disp[i] -= disp[0];
-      MPI_Type_struct(4, length, disp, types, &type);
+      int length[2]={1,1};
+      MPI_Aint base, disp[2];
+      MPI_Datatype types[2] = {MPITraits<T1>::getType(), 
+			       MPITraits<T2>::getType()};
+      std::pair<T1,T2> rep;
+      MPI_Get_address(&rep, &base);
+      MPI_Get_address(&(rep.first), disp);
+      MPI_Get_address(&(rep.second), disp+1);
+      for(int i=0; i < 2; ++i)
+	disp[i] -= base;
+      // the extent is the size of the pair, so arrays can be sent
+      MPI_Datatype tmp;
+      MPI_Type_create_struct(2, length, disp, types, &tmp);
+      MPI_Type_create_resized(tmp, 0, sizeof(std::pair<T1,T2>), &type);
+      MPI_Type_free(&tmp);
       MPI_Type_commit(&type);
     }
     return type;
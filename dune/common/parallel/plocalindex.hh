@@ -288,17 +288,18 @@ namespace Dune
   {
     
     if(type==MPI_DATATYPE_NULL){
-      int length[3];
-      MPI_Aint disp[3];
-      MPI_Datatype types[3] = {MPI_LB, MPITraits<char>::getType(), MPI_UB};
-      ParallelLocalIndex<T> rep[2];
-      length[0]=length[1]=length[2]=1;
-      MPI_Address(rep, disp); // lower bound of the datatype
-      MPI_Address(&(rep[0].attribute_), disp+1);
-      MPI_Address(rep+1, disp+2); // upper bound of the datatype
-      for(int i=2; i >= 0; --i)
-	disp[i] -= disp[0];
-      MPI_Type_struct(3, length, disp, types, &type);
+      int length[1]={1};
+      MPI_Aint base, disp[1];
+      MPI_Datatype types[1] = {MPITraits<char>::getType()};
+      ParallelLocalIndex<T> rep;
+      MPI_Get_address(&rep, &base);
+      MPI_Get_address(&(rep.attribute_), disp);
+      disp[0] -= base;
+      // the extent is the size of the class, so arrays can be sent
+      MPI_Datatype tmp;
+      MPI_Type_create_struct(1, length, disp, types, &tmp);
+      MPI_Type_create_resized(tmp, 0, sizeof(ParallelLocalIndex<T>), &type);
+      MPI_Type_free(&tmp);
       MPI_Type_commit(&type);
     }
     return type;
@@ -7,6 +7,7 @@
 #include <dune/common/exceptions.hh>
 #include <dune/common/poolallocator.hh>
 #include <dune/common/sllist.hh>
+#include <dune/common/unrolledsllist.hh>
 #include <dune/common/static_assert.hh>
 #include <dune/common/stdstreams.hh>
 #include <map>
@@ -17,6 +18,7 @@
 #include <iterator>
 #if HAVE_MPI
 #include "mpitraits.hh"
+#include "communicationstatistics.hh"
 #include <mpi.h>
 
 namespace Dune{
@@ -229,7 +231,7 @@ namespace Dune{
     typedef typename A::template rebind<RemoteIndex>::other Allocator;
 
     /** @brief The type of the remote index list. */
-    typedef Dune::SLList<RemoteIndex,Allocator>
+    typedef Dune::UnrolledSLList<RemoteIndex,Allocator>
     RemoteIndexList;
     
     /** @brief The type of the map from rank to remote index list. */
@@ -394,6 +396,18 @@ namespace Dune{
     /** @brief Get the index set at destination. */
     inline const ParallelIndexSet& destinationIndexSet() const;
 
+    /** @brief The instrumentation of rebuild(). */
+    CommunicationStatistics& statistics()
+    {
+      return statistics_;
+    }
+
+    /** @brief The instrumentation of rebuild(). */
+    const CommunicationStatistics& statistics() const
+    {
+      return statistics_;
+    }
+
   private:
     /** copying is forbidden. */
     RemoteIndices(const RemoteIndices&)
@@ -456,6 +470,9 @@ namespace Dune{
      * index lists, the first for receiving, the second for sending.
      */
     RemoteIndexMap remoteIndices_;
+
+    /** @brief The instrumentation of the rebuild. */
+    CommunicationStatistics statistics_;
     
     /** 
      * @brief Build the remote mapping. 
@@ -593,13 +610,13 @@ namespace Dune{
     typedef A Allocator;
 
     /** @brief The type of the remote index list. */
-    typedef Dune::SLList<RemoteIndex,Allocator>
+    typedef Dune::UnrolledSLList<RemoteIndex,Allocator>
     RemoteIndexList;
 
     /**
      * @brief The type of the modifying iterator of the remote index list.
      */
-    typedef SLListModifyIterator<RemoteIndex,Allocator> ModifyIterator;
+    typedef typename RemoteIndexList::ModifyIterator ModifyIterator;
     
     /**
      * @brief The type of the remote index list iterator.
@@ -737,7 +754,7 @@ namespace Dune{
     typedef typename A::template rebind<RemoteIndex>::other Allocator;
 
     /** @brief The type of the remote index list. */
-    typedef Dune::SLList<RemoteIndex,Allocator> RemoteIndexList;    
+    typedef Dune::UnrolledSLList<RemoteIndex,Allocator> RemoteIndexList;    
 
     /** @brief The of map for storing the iterators. */
     typedef std::map<int,std::pair<typename RemoteIndexList::const_iterator,
@@ -893,19 +910,21 @@ namespace Dune{
   MPI_Datatype MPITraits<IndexPair<TG,ParallelLocalIndex<TA> > >::getType()
   {
     if(type==MPI_DATATYPE_NULL){
-      int length[4];
-      MPI_Aint disp[4];
-      MPI_Datatype types[4] = {MPI_LB, MPITraits<TG>::getType(), 
-			       MPITraits<ParallelLocalIndex<TA> >::getType(), MPI_UB};
-      IndexPair<TG,ParallelLocalIndex<TA> > rep[2];
-      length[0]=length[1]=length[2]=length[3]=1;
-      MPI_Address(rep, disp); // lower bound of the datatype
-      MPI_Address(&(rep[0].global_), disp+1);
-      MPI_Address(&(rep[0].local_), disp+2);
-      MPI_Address(rep+1, disp+3); // upper bound of the datatype
-      for(int i=3; i >= 0; --i)
-	disp[i] -= disp[0];
-      MPI_Type_struct(4, length, disp, types, &type);
+      int length[2]={1,1};
+      MPI_Aint base, disp[2];
+      MPI_Datatype types[2] = {MPITraits<TG>::getType(), 
+			       MPITraits<ParallelLocalIndex<TA> >::getType()};
+      IndexPair<TG,ParallelLocalIndex<TA> > rep;
+      MPI_Get_address(&rep, &base);
+      MPI_Get_address(&(rep.global_), disp);
+      MPI_Get_address(&(rep.local_), disp+1);
+      for(int i=0; i < 2; ++i)
+	disp[i] -= base;
+      // the extent is the size of the class, so arrays can be sent
+      MPI_Datatype tmp;
+      MPI_Type_create_struct(2, length, disp, types, &tmp);
+      MPI_Type_create_resized(tmp, 0, sizeof(IndexPair<TG,ParallelLocalIndex<TA> >), &type);
+      MPI_Type_free(&tmp);
       MPI_Type_commit(&type);
     }
     return type;
@@ -1219,6 +1238,7 @@ namespace Dune{
     if(sendTwo|| includeSelf)
       unpackCreateRemote(buffer[0], sourcePairs, destPairs, rank, sourcePublish, 
 			 destPublish, bufferSize, sendTwo, includeSelf);
+    statistics_.lap(CommunicationStatistics::pack);
 
     neighbourIds.erase(rank);
 
@@ -1243,6 +1263,9 @@ namespace Dune{
 	    MPI_Ssend(p_out, bufferSize, MPI_PACKED, (rank+1)%procs,
 		      commTag_, comm_);
 	  }
+	  statistics_.sent((rank+1)%procs, bufferSize);
+	  statistics_.received((rank+procs-1)%procs, bufferSize);
+	  statistics_.lap(CommunicationStatistics::wait);
 
 
 	  // The process these indices are from
@@ -1250,6 +1273,7 @@ namespace Dune{
 	  
 	  unpackCreateRemote(p_in, sourcePairs, destPairs, remoteProc, sourcePublish, 
 			     destPublish, bufferSize, sendTwo);
+	  statistics_.lap(CommunicationStatistics::unpack);
 	  
 	}
 	
@@ -1267,6 +1291,7 @@ namespace Dune{
 	    neighbour!= neighbourIds.end(); ++neighbour){
 	    // Only send the information to the neighbouring processors
 	    MPI_Issend(buffer[0], position , MPI_PACKED, *neighbour, commTag_, comm_, req++);
+	    statistics_.sent(*neighbour, position);
 	}
 	
 	//Test for received messages
@@ -1282,9 +1307,12 @@ namespace Dune{
 	    // receive message
 	    MPI_Recv(buffer[1], size, MPI_PACKED, remoteProc,
 		     commTag_, comm_, &status);
+	    statistics_.received(remoteProc, size);
+	    statistics_.lap(CommunicationStatistics::wait);
 	      
 	    unpackCreateRemote(buffer[1], sourcePairs, destPairs, remoteProc, sourcePublish, 
 			       destPublish, bufferSize, sendTwo);
+	    statistics_.lap(CommunicationStatistics::unpack);
 	  }
 	// wait for completion of pending requests
 	MPI_Status* statuses = new MPI_Status[neighbourIds.size()];
@@ -1296,6 +1324,7 @@ namespace Dune{
 	      MPI_Abort(comm_, 999);
 	  }
 	}
+	statistics_.lap(CommunicationStatistics::wait);
 	delete[] requests;
 	delete[] statuses;
       }
@@ -1460,7 +1489,9 @@ namespace Dune{
        isSynced()){
       free();
       
+      statistics_.beginExchange();
       buildRemote<ignorePublic>(includeSelf);
+      statistics_.endExchange();
 
       sourceSeqNo_ = source_->seqNo();
       destSeqNo_ = target_->seqNo();
@@ -0,0 +1,99 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// Records exchanges by hand, as the communicators do, and checks the
+// counters and the JSON and CSV output.
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <dune/common/parallel/communicationstatistics.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed at "                    \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+void exchange(Dune::CommunicationStatistics& statistics)
+{
+  typedef Dune::CommunicationStatistics Statistics;
+  statistics.beginExchange();
+  statistics.lap(Statistics::pack);
+  statistics.sent(3, 100);
+  statistics.sent(1, 20);
+  statistics.received(1, 20);
+  statistics.lap(Statistics::wait);
+  statistics.lap(Statistics::unpack);
+  statistics.received(3, 60);
+  statistics.lap(Statistics::wait);
+  statistics.lap(Statistics::unpack);
+  statistics.endExchange();
+}
+
+int main()
+{
+  int ret = 0;
+  Dune::CommunicationStatistics statistics("halo \"A\"");
+
+  // nothing is recorded until enabled
+  exchange(statistics);
+  CHECK(!statistics.enabled());
+  CHECK(statistics.total().exchanges == 0);
+  CHECK(statistics.neighbours().empty());
+
+  statistics.enable();
+  exchange(statistics);
+  exchange(statistics);
+  const Dune::ExchangeStatistics& total = statistics.total();
+  const Dune::ExchangeStatistics& last = statistics.last();
+  CHECK(total.exchanges == 2 && last.exchanges == 1);
+  CHECK(total.messagesSent == 4 && total.messagesReceived == 4);
+  CHECK(total.bytesSent == 240 && total.bytesReceived == 160);
+  CHECK(last.bytesSent == 120 && last.bytesReceived == 80);
+  CHECK(last.totalTime >= last.packTime + last.waitTime + last.unpackTime);
+  CHECK(total.totalTime >= last.totalTime);
+
+  // neighbours are sorted by rank
+  CHECK(statistics.neighbours().size() == 2);
+  if(statistics.neighbours().size() == 2){
+    const Dune::NeighbourStatistics& n1 = statistics.neighbours()[0];
+    const Dune::NeighbourStatistics& n3 = statistics.neighbours()[1];
+    CHECK(n1.rank == 1 && n1.messagesSent == 2 && n1.bytesReceived == 40);
+    CHECK(n3.rank == 3 && n3.bytesSent == 200 && n3.bytesReceived == 120);
+    CHECK(n3.arrivalTime >= n1.arrivalTime);
+  }
+  // 320 of 400 bytes with the second of two neighbours
+  CHECK(std::abs(statistics.imbalance() - 0.6) < 1e-12);
+
+  std::ostringstream json;
+  statistics.writeJSON(json, 7);
+  std::cout << json.str();
+  CHECK(json.str().find("{\"rank\": 7, \"name\": \"halo \\\"A\\\"\", \"exchanges\": 2,") == 0);
+  CHECK(json.str().find("\"bytesSent\": 240") != std::string::npos);
+  CHECK(json.str().find("{\"rank\": 3, \"messagesSent\": 2, \"bytesSent\": 200") != std::string::npos);
+
+  std::ostringstream csv;
+  statistics.writeCSV(csv, 7);
+  std::cout << csv.str();
+  std::istringstream lines(csv.str());
+  std::string line;
+  std::getline(lines, line);
+  CHECK(line.find("rank,name,neighbour,exchanges,") == 0);
+  std::getline(lines, line);
+  CHECK(line.find("7,\"halo \"\"A\"\"\",all,2,4,240,4,160,") == 0);
+  std::getline(lines, line);
+  CHECK(line.find("7,\"halo \"\"A\"\"\",1,,2,40,2,40,,,,,") == 0);
+
+  statistics.reset();
+  CHECK(statistics.total().exchanges == 0 && statistics.neighbours().empty());
+  CHECK(statistics.enabled());
+
+  return ret;
+}
@@ -0,0 +1,145 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+
+#include <dune/common/parallel/compactindexset.hh>
+#include <dune/common/parallel/indexset.hh>
+#include <dune/common/parallel/plocalindex.hh>
+
+enum GridFlags {owner, overlap, border};
+
+typedef Dune::ParallelLocalIndex<GridFlags> LocalIndex;
+
+int testCompareWithIndexSet()
+{
+  Dune::ParallelIndexSet<int,LocalIndex,15> indexSet;
+  Dune::CompactParallelIndexSet<int,GridFlags> compactSet;
+  int ret=0;
+
+  indexSet.beginResize();
+  compactSet.beginResize();
+
+  // add in reverse order to check sorting
+  for(int i=19; i>=0; --i){
+    LocalIndex local(i, GridFlags(i%3), i%2==0);
+    indexSet.add(3*i, local);
+    compactSet.add(3*i, local);
+  }
+
+  indexSet.endResize();
+  compactSet.endResize();
+
+  if(indexSet.size()!=compactSet.size()){
+    std::cerr<<"Sizes do not match!"<<std::endl;
+    ++ret;
+  }
+
+  typedef Dune::ParallelIndexSet<int,LocalIndex,15>::const_iterator Iterator;
+  typedef Dune::CompactParallelIndexSet<int,GridFlags>::const_iterator CompactIterator;
+
+  CompactIterator centry=compactSet.begin();
+  for(Iterator entry=indexSet.begin(); entry!=indexSet.end(); ++entry, ++centry){
+    if(entry->global()!=centry->global()){
+      std::cerr<<"Global indices do not match!"<<std::endl;
+      ++ret;
+    }
+    if(entry->local()!=centry->local()){
+      std::cerr<<"Local indices do not match!"<<std::endl;
+      ++ret;
+    }
+  }
+  if(centry!=compactSet.end()){
+    std::cerr<<"Compact set has too many entries!"<<std::endl;
+    ++ret;
+  }
+
+  for(int i=0; i<20; ++i){
+    if(compactSet.at(3*i).localIndex()!=indexSet.at(3*i).local().local()){
+      std::cerr<<"Lookup of "<<3*i<<" failed!"<<std::endl;
+      ++ret;
+    }
+    if(compactSet.find(3*i+1)!=compactSet.end()){
+      std::cerr<<"Found nonexisting entry "<<3*i+1<<"!"<<std::endl;
+      ++ret;
+    }
+  }
+
+  try{
+    compactSet.at(1);
+    std::cerr<<"No exception for nonexisting entry!"<<std::endl;
+    ++ret;
+  }catch(Dune::RangeError&){}
+
+  return ret;
+}
+
+int testDeleteIndices()
+{
+  Dune::CompactParallelIndexSet<int,GridFlags> indexSet;
+  int ret=0;
+
+  indexSet.beginResize();
+  for(int i=0; i< 10; i++)
+    indexSet.add(i, LocalIndex(i, owner, true));
+  indexSet.endResize();
+
+  typedef Dune::CompactParallelIndexSet<int,GridFlags>::iterator Iterator;
+
+  indexSet.beginResize();
+  Iterator entry = indexSet.begin();
+  for(int i=0; i < 5; i++)
+    ++entry;
+  indexSet.markAsDeleted(entry);
+  indexSet.add(42, LocalIndex(10, border, false));
+  indexSet.add(-1, LocalIndex(11, overlap, true));
+  indexSet.endResize();
+
+  std::cout<<"Deleted: "<<indexSet<<std::endl;
+
+  if(indexSet.size()!=11){
+    std::cerr<<"Number of entries not correct!"<<std::endl;
+    ++ret;
+  }
+
+  int last=-2;
+  for(entry = indexSet.begin(); entry != indexSet.end(); ++entry){
+    if(entry->global()==5){
+      std::cerr<<"Entry was not deleted!"<<std::endl;
+      ++ret;
+    }
+    if(entry->global()<=last){
+      std::cerr<<"Entries are not sorted!"<<std::endl;
+      ++ret;
+    }
+    last=entry->global();
+  }
+
+  if(indexSet[42].attribute()!=border || indexSet[42].isPublic()){
+    std::cerr<<"Attribute or public flag of added entry wrong!"<<std::endl;
+    ++ret;
+  }
+
+  indexSet.renumberLocal();
+  std::size_t i=0;
+  for(entry = indexSet.begin(); entry != indexSet.end(); ++entry, ++i)
+    if(entry->local().local()!=i){
+      std::cerr<<"Renumbering failed!"<<std::endl;
+      ++ret;
+    }
+
+  return ret;
+}
+
+int main(int argc, char **argv)
+{
+  int ret=testCompareWithIndexSet();
+  ret+=testDeleteIndices();
+  std::exit(ret);
+}
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <ostream>
 
+#include <dune/common/bigunsignedint.hh>
+#include <dune/common/hash.hh>
 #include <dune/common/parallel/indexset.hh>
 #include <dune/common/parallel/localindex.hh>
 
@@ -77,7 +79,42 @@ int testDeleteIndices()
   return  ret;
 }
 
+// index sets with bigunsignedint global indices, the hash of an
+// index pair only depends on the global index
+int testBigGlobalIndices()
+{
+  typedef Dune::bigunsignedint<100> GlobalIndex;
+  typedef Dune::ParallelIndexSet<GlobalIndex,Dune::LocalIndex,15> IndexSet;
+  IndexSet indexSet;
+  GlobalIndex offset = GlobalIndex(1)<<80;
+
+  indexSet.beginResize();
+  for(int i=0; i< 10; i++)
+    indexSet.add(offset+GlobalIndex(9-i), Dune::LocalIndex(i));
+  indexSet.endResize();
+
+  int ret=0;
+  if(indexSet.size()!=10 || indexSet[offset+GlobalIndex(3)].local()!=6){
+    std::cerr<<"Lookup of bigunsignedint global index failed!"<<std::endl;
+    ret++;
+  }
+
+#if HAVE_DUNE_HASH
+  typedef Dune::IndexPair<GlobalIndex,Dune::LocalIndex> Pair;
+  Dune::hash<Pair> hasher;
+  for(IndexSet::const_iterator pair=indexSet.begin(); pair!=indexSet.end(); ++pair)
+    if(hasher(*pair)!=hasher(Pair(pair->global(), Dune::LocalIndex(42)))){
+      std::cerr<<"Hash of index pair depends on the local index!"<<std::endl;
+      ret++;
+    }
+#endif
+
+  return ret;
+}
+
 int main(int argc, char **argv)
 {
-  std::exit(testDeleteIndices());
+  int ret = testDeleteIndices();
+  ret += testBigGlobalIndices();
+  std::exit(ret);
 }
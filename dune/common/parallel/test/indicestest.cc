@@ -5,6 +5,7 @@
 #include<dune/common/enumset.hh>
 #include<algorithm>
 #include<iostream>
+#include<vector>
 
 #if HAVE_MPI
 #include"mpi.h"
@@ -390,6 +391,116 @@ void testIndicesBuffered(MPI_Comm comm)
 }
 
 
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << rank << ": Check " #condition " failed at "          \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+// the ranks of the neighbours recorded in the statistics
+std::vector<int> neighbourRanks(const Dune::CommunicationStatistics& statistics)
+{
+  std::vector<int> ranks;
+  for(std::size_t i=0; i<statistics.neighbours().size(); ++i)
+    ranks.push_back(statistics.neighbours()[i].rank);
+  return ranks;
+}
+
+// every neighbour sent and received at least one byte
+bool allExchanged(const Dune::CommunicationStatistics& statistics)
+{
+  for(std::size_t i=0; i<statistics.neighbours().size(); ++i){
+    const Dune::NeighbourStatistics& n = statistics.neighbours()[i];
+    if(n.messagesSent==0 || n.bytesSent==0 || n.messagesReceived==0 || n.bytesReceived==0)
+      return false;
+  }
+  return true;
+}
+
+int testStatistics(MPI_Comm comm)
+{
+  const int Nx = 8;
+  const int Ny = 1;
+
+  int procs, rank, ret=0;
+  MPI_Comm_size(comm, &procs);
+  MPI_Comm_rank(comm, &rank);
+
+  typedef Dune::ParallelIndexSet<int,Dune::ParallelLocalIndex<GridFlags> > ParallelIndexSet;
+  typedef Dune::RemoteIndices<ParallelIndexSet> RemoteIndices;
+
+  ParallelIndexSet distIndexSet;
+  Array distArray;
+  setupDistributed<Nx,Ny>(distArray, distIndexSet, rank, procs);
+
+  // without neighbours the indices are sent around in a ring, to
+  // the next process and received from the previous one
+  RemoteIndices overlapIndices(distIndexSet, distIndexSet, comm);
+  overlapIndices.statistics().enable();
+  overlapIndices.rebuild<false>();
+
+  std::vector<int> ring;
+  if(procs>1){
+    ring.push_back((rank+1)%procs);
+    ring.push_back((rank+procs-1)%procs);
+    std::sort(ring.begin(), ring.end());
+    ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+  }
+  const Dune::CommunicationStatistics& rebuild = overlapIndices.statistics();
+  CHECK(rebuild.total().exchanges==1);
+  CHECK(rebuild.last().messagesSent==static_cast<unsigned long>(procs-1));
+  CHECK(rebuild.last().messagesReceived==static_cast<unsigned long>(procs-1));
+  CHECK(procs==1 || (rebuild.last().bytesSent>0 && rebuild.last().bytesReceived>0));
+  CHECK(neighbourRanks(rebuild)==ring);
+
+  // an unchanged index set is not rebuilt and not recorded
+  overlapIndices.rebuild<false>();
+  CHECK(rebuild.total().exchanges==1);
+
+  Dune::Interface overlapInterface;
+  overlapInterface.build(overlapIndices, Dune::EnumItem<GridFlags,owner>(),
+                         Dune::EnumItem<GridFlags,overlap>());
+
+  // the neighbours of the interface
+  std::vector<int> interfaceRanks;
+  typedef Dune::Interface::InformationMap InformationMap;
+  const InformationMap& interfaces = static_cast<const Dune::Interface&>(overlapInterface).interfaces();
+  for(InformationMap::const_iterator i=interfaces.begin(); i!=interfaces.end(); ++i)
+    interfaceRanks.push_back(i->first);
+  CHECK(procs==1 || !interfaceRanks.empty());
+
+  Dune::BufferedCommunicator buffered;
+  buffered.build<Array>(overlapInterface);
+  buffered.forward<ArrayGatherScatter>(distArray, distArray);
+  CHECK(buffered.statistics().total().exchanges==0);
+
+  buffered.statistics().enable();
+  buffered.forward<ArrayGatherScatter>(distArray, distArray);
+  buffered.forward<ArrayGatherScatter>(distArray, distArray);
+  const Dune::CommunicationStatistics& forward = buffered.statistics();
+  CHECK(forward.total().exchanges==2);
+  CHECK(forward.last().messagesSent==interfaceRanks.size());
+  CHECK(forward.last().messagesReceived==interfaceRanks.size());
+  CHECK(forward.total().bytesSent==2*forward.last().bytesSent);
+  CHECK(neighbourRanks(forward)==interfaceRanks);
+  CHECK(allExchanged(forward));
+
+  Dune::DatatypeCommunicator<ParallelIndexSet> datatype;
+  datatype.build(overlapIndices, Dune::EnumItem<GridFlags,owner>(), distArray,
+                 Dune::EnumItem<GridFlags,overlap>(), distArray);
+  datatype.statistics().enable();
+  datatype.forward();
+  CHECK(datatype.statistics().total().exchanges==1);
+  CHECK(neighbourRanks(datatype.statistics())==interfaceRanks);
+  CHECK(allExchanged(datatype.statistics()));
+  CHECK(datatype.statistics().last().bytesSent==forward.last().bytesSent);
+
+  return ret;
+}
+
  void testRedistributeIndices(MPI_Comm comm)
 {
   using namespace Dune;
@@ -707,10 +818,12 @@ int main(int argc, char **argv)
 
   //  testRedistributeIndices(comm);
   testRedistributeIndicesBuffered(comm);
+
+  int ret = testStatistics(comm);
   MPI_Comm_free(&comm);
   MPI_Finalize();
 
-  return 0;
+  return ret;
 #else
   return 77;
 #endif
@@ -19,8 +19,96 @@
 
 using namespace Dune;
 
+namespace {
+
+    // the header written by ParameterTree::serialize()
+    const char serializationHeader[] = "DUNEPT1\n";
+
+    void writeNumber(std::ostream& stream, std::size_t n)
+    {
+        if (n > 0xffffffffu)
+            DUNE_THROW(Dune::RangeError, "Cannot serialize ParameterTree, "
+                       << n << " does not fit into 32 bits");
+        const char bytes[4] = { char(n & 0xff), char((n >> 8) & 0xff),
+                                char((n >> 16) & 0xff), char((n >> 24) & 0xff) };
+        stream.write(bytes, 4);
+    }
+
+    void writeString(std::ostream& stream, const std::string& s)
+    {
+        writeNumber(stream, s.size());
+        stream.write(s.data(), s.size());
+    }
+
+    std::size_t readNumber(std::istream& stream)
+    {
+        unsigned char bytes[4];
+        if (not stream.read(reinterpret_cast<char*>(bytes), 4))
+            DUNE_THROW(Dune::IOError, "Serialized ParameterTree is truncated");
+        return std::size_t(bytes[0]) | (std::size_t(bytes[1]) << 8)
+            | (std::size_t(bytes[2]) << 16) | (std::size_t(bytes[3]) << 24);
+    }
+
+    void readString(std::istream& stream, std::string& s)
+    {
+        const std::size_t size = readNumber(stream);
+        s.resize(size);
+        if (size > 0 && not stream.read(&s[0], size))
+            DUNE_THROW(Dune::IOError, "Serialized ParameterTree is truncated");
+    }
+
+} // end anonymous namespace
+
 ParameterTree::ParameterTree()
+    : parent(0), indexed(0)
+{
+}
+
+ParameterTree::ParameterTree(const ParameterTree& other)
+    : parent(0), indexed(0)
+{
+    copyTree(other);
+    rebuildIndex("", *this);
+}
+
+ParameterTree& ParameterTree::operator= (const ParameterTree& other)
 {
+    if (this != &other)
+    {
+        // copy first, other may be a subtree of this tree
+        ParameterTree copy;
+        copy.copyTree(other);
+        valueKeys.swap(copy.valueKeys);
+        subKeys.swap(copy.subKeys);
+        values.swap(copy.values);
+        subs.swap(copy.subs);
+        typedef std::map<std::string, ParameterTree>::iterator SubIt;
+        for (SubIt it = subs.begin(); it != subs.end(); ++it)
+            it->second.parent = this;
+
+        ParameterTree* root = this;
+        while (root->parent)
+            root = root->parent;
+        root->index.clear();
+        root->indexed = 0;
+        root->rebuildIndex("", *root);
+    }
+    return *this;
+}
+
+void ParameterTree::copyTree(const ParameterTree& other)
+{
+    // copy the subtrees one by one, so they get their parent but no index
+    valueKeys = other.valueKeys;
+    subKeys = other.subKeys;
+    values = other.values;
+    typedef std::map<std::string, ParameterTree>::const_iterator SubIt;
+    for (SubIt it = other.subs.begin(); it != other.subs.end(); ++it)
+    {
+        ParameterTree& s = subs.insert(subs.end(), std::make_pair(it->first, ParameterTree()))->second;
+        s.parent = this;
+        s.copyTree(it->second);
+    }
 }
 
 void ParameterTree::report(std::ostream& stream, const std::string& prefix) const
@@ -44,19 +132,7 @@ void ParameterTree::report(std::ostream& stream, const std::string& prefix) cons
 
 bool ParameterTree::hasKey(const std::string& key) const
 {
-	std::string::size_type dot = key.find(".");
-	
-	if (dot != std::string::npos)
-	{
-		std::string prefix = key.substr(0,dot);
-		if (subs.count(prefix) == 0)
-			return false;
-		
-		const ParameterTree& s = sub(prefix);
-		return s.hasKey(key.substr(dot+1));
-	}
-	else
-		return (values.count(key) != 0);
+    return lookup(key) != 0;
 }
 
 bool ParameterTree::hasSub(const std::string& key) const
@@ -87,9 +163,14 @@ ParameterTree& ParameterTree::sub(const std::string& key)
 	}
 	else
     {
-        if (subs.count(key) == 0)
- 			subKeys.push_back(key.substr(0,dot));
-		return subs[key];
+        std::map<std::string, ParameterTree>::iterator s = subs.find(key);
+        if (s == subs.end())
+        {
+ 			subKeys.push_back(key);
+            s = subs.insert(std::make_pair(key, ParameterTree())).first;
+            s->second.parent = this;
+        }
+		return s->second;
     }
 }
 
@@ -112,43 +193,135 @@ const ParameterTree& ParameterTree::sub(const std::string& key) const
 
 std::string& ParameterTree::operator[] (const std::string& key)
 {
-	std::string::size_type dot = key.find(".");
-	
-	if (dot != std::string::npos)
-	{
-		if (not(hasSub(key.substr(0,dot))))
+    // only the root keeps an index
+    if (parent)
+        return insert(key);
+
+    const std::size_t hash = hashKey(key);
+    if (const IndexEntry* entry = findIndex(key, hash))
+        return *entry->value;
+
+    std::string& value = insert(key);
+    insertIndex(key, hash, &value);
+    return value;
+}
+
+const std::string& ParameterTree::operator[] (const std::string& key) const
+{
+    const std::string* value = lookup(key);
+    if (not value)
+        DUNE_THROW(Dune::RangeError, "Key '" << key << "' not found in ParameterTree");
+    return *value;
+}
+
+std::string& ParameterTree::insert(const std::string& key)
+{
+    std::string::size_type dot = key.find(".");
+    if (dot != std::string::npos)
+    {
+        const std::string head = key.substr(0,dot);
+        std::map<std::string, ParameterTree>::iterator s = subs.find(head);
+        if (s == subs.end())
         {
-            subs[key.substr(0,dot)];
- 			subKeys.push_back(key.substr(0,dot));
+            s = subs.insert(std::make_pair(head, ParameterTree())).first;
+            s->second.parent = this;
+            subKeys.push_back(head);
         }
-		ParameterTree& s = sub(key.substr(0,dot));
-		return s[key.substr(dot+1)];
-	}
-	else
-	{
-		if (not(hasKey(key)))
- 			valueKeys.push_back(key);
-		return values[key];
-	}
+        return s->second.insert(key.substr(dot+1));
+    }
+
+    std::map<std::string, std::string>::iterator it = values.find(key);
+    if (it == values.end())
+    {
+        valueKeys.push_back(key);
+        it = values.insert(std::make_pair(key, std::string())).first;
+    }
+    return it->second;
 }
 
-const std::string& ParameterTree::operator[] (const std::string& key) const
+const std::string* ParameterTree::lookup(const std::string& key) const
 {
+    if (const IndexEntry* entry = findIndex(key, hashKey(key)))
+        return entry->value;
+
     std::string::size_type dot = key.find(".");
-    
     if (dot != std::string::npos)
     {
-        if (not(hasSub(key.substr(0,dot))))
-            DUNE_THROW(Dune::RangeError, "Key '" << key << "' not found in ParameterTree");
-        const ParameterTree& s = sub(key.substr(0,dot));
-        return s[key.substr(dot+1)];
+        std::map<std::string, ParameterTree>::const_iterator s = subs.find(key.substr(0,dot));
+        if (s == subs.end())
+            return 0;
+        return s->second.lookup(key.substr(dot+1));
     }
-    else
+    std::map<std::string, std::string>::const_iterator it = values.find(key);
+    if (it == values.end())
+        return 0;
+    return &it->second;
+}
+
+std::size_t ParameterTree::hashKey(const std::string& key)
+{
+    // FNV-1a
+    std::size_t hash = 2166136261u;
+    for (std::size_t i = 0; i < key.size(); ++i)
+        hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+    return hash;
+}
+
+const ParameterTree::IndexEntry* ParameterTree::findIndex(const std::string& key, std::size_t hash) const
+{
+    if (index.empty())
+        return 0;
+    const std::size_t mask = index.size() - 1;
+    for (std::size_t i = hash & mask; index[i].value != 0; i = (i + 1) & mask)
+        if (index[i].hash == hash && index[i].key == key)
+            return &index[i];
+    return 0;
+}
+
+void ParameterTree::insertIndex(const std::string& key, std::size_t hash, std::string* value)
+{
+    // keep the table at most half full
+    if (2 * (indexed + 1) > index.size())
     {
-        if (not(hasKey(key)))
-            DUNE_THROW(Dune::RangeError, "Key '" << key << "' not found in ParameterTree");
-        return values.find(key)->second;
+        std::vector<IndexEntry> old(std::max<std::size_t>(16, 2 * index.size()));
+        for (std::size_t i = 0; i < old.size(); ++i)
+            old[i].value = 0;
+        old.swap(index);
+        const std::size_t mask = index.size() - 1;
+        for (std::size_t i = 0; i < old.size(); ++i)
+            if (old[i].value != 0)
+            {
+                std::size_t j = old[i].hash & mask;
+                while (index[j].value != 0)
+                    j = (j + 1) & mask;
+                index[j].key.swap(old[i].key);
+                index[j].hash = old[i].hash;
+                index[j].value = old[i].value;
+            }
     }
+
+    const std::size_t mask = index.size() - 1;
+    std::size_t i = hash & mask;
+    while (index[i].value != 0)
+        i = (i + 1) & mask;
+    index[i].key = key;
+    index[i].hash = hash;
+    index[i].value = value;
+    ++indexed;
+}
+
+void ParameterTree::rebuildIndex(const std::string& prefix, ParameterTree& tree)
+{
+    typedef std::map<std::string, std::string>::iterator ValueIt;
+    for (ValueIt it = tree.values.begin(); it != tree.values.end(); ++it)
+    {
+        const std::string key = prefix + it->first;
+        insertIndex(key, hashKey(key), &it->second);
+    }
+
+    typedef std::map<std::string, ParameterTree>::iterator SubIt;
+    for (SubIt it = tree.subs.begin(); it != tree.subs.end(); ++it)
+        rebuildIndex(prefix + it->first + ".", it->second);
 }
 
 std::string ParameterTree::get(const std::string& key, const std::string& defaultValue) const
@@ -228,3 +401,60 @@ const ParameterTree::KeyVector& ParameterTree::getSubKeys() const
 {
 	return subKeys;
 }
+
+void ParameterTree::serialize(std::ostream& stream) const
+{
+    stream.write(serializationHeader, sizeof(serializationHeader) - 1);
+    serializeTree(stream);
+    if (not stream)
+        DUNE_THROW(Dune::IOError, "Could not write serialized ParameterTree");
+}
+
+void ParameterTree::deserialize(std::istream& stream, bool overwrite)
+{
+    char header[sizeof(serializationHeader) - 1];
+    if (not stream.read(header, sizeof(header))
+        || not std::equal(header, header + sizeof(header), serializationHeader))
+        DUNE_THROW(Dune::IOError, "Stream does not contain a serialized ParameterTree");
+    deserializeTree(stream, "", overwrite);
+}
+
+void ParameterTree::serializeTree(std::ostream& stream) const
+{
+    writeNumber(stream, valueKeys.size());
+    for (std::size_t i = 0; i < valueKeys.size(); ++i)
+    {
+        writeString(stream, valueKeys[i]);
+        writeString(stream, values.find(valueKeys[i])->second);
+    }
+    writeNumber(stream, subKeys.size());
+    for (std::size_t i = 0; i < subKeys.size(); ++i)
+    {
+        writeString(stream, subKeys[i]);
+        subs.find(subKeys[i])->second.serializeTree(stream);
+    }
+}
+
+void ParameterTree::deserializeTree(std::istream& stream, const std::string& prefix, bool overwrite)
+{
+    std::string key, value;
+    const std::size_t valueCount = readNumber(stream);
+    for (std::size_t i = 0; i < valueCount; ++i)
+    {
+        readString(stream, key);
+        readString(stream, value);
+        key.insert(0, prefix);
+        // values are set through this tree, so they end up in its index
+        if (overwrite || not hasKey(key))
+            (*this)[key].swap(value);
+    }
+    const std::size_t subCount = readNumber(stream);
+    for (std::size_t i = 0; i < subCount; ++i)
+    {
+        readString(stream, key);
+        key.insert(0, prefix);
+        // create substructures without values, too
+        sub(key);
+        deserializeTree(stream, key + ".", overwrite);
+    }
+}
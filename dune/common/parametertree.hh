@@ -42,10 +42,21 @@ namespace Dune {
      */
     typedef std::vector<std::string> KeyVector;
 
+    template<class T>
+    class Handle;
+
     /** \brief Create new empty ParameterTree
      */
     ParameterTree();
 
+    /** \brief Copy the parameters of another tree
+     */
+    ParameterTree(const ParameterTree& other);
+
+    /** \brief Copy the parameters of another tree
+     */
+    ParameterTree& operator= (const ParameterTree& other);
+
 
     /** \brief test for key
      *
@@ -189,19 +200,48 @@ namespace Dune {
      */
     template <class T>
     T get(const std::string& key) const {
-      if(not hasKey(key))
+      const std::string* value = lookup(key);
+      if(not value)
         DUNE_THROW(RangeError, "Key '" << key << "' not found in parameter "
                    "file!");
       try {
-        return Parser<T>::parse((*this)[key]);
+        return Parser<T>::parse(*value);
       }
       catch(const RangeError&) {
         DUNE_THROW(RangeError, "Cannot parse value \"" <<
-                   (*this)[key] << "\" for key \"" << key << "\" as a " <<
+                   *value << "\" for key \"" << key << "\" as a " <<
                    className<T>());
       }
     }
 
+    /** \brief Get a handle to the value of a key, parsed as T
+     *
+     * The key is looked up and the value parsed once. Dereferencing
+     * the handle afterwards only compares the value with the string it
+     * was parsed from, and parses it again if it was modified since.
+     *
+     * \code
+     * ParameterTree::Handle<double> tol = tree.handle<double>("solver.tol");
+     * while (defect > *tol) ...
+     * \endcode
+     *
+     * \note The handle refers to the value in the tree holding it,
+     * which has to outlive the handle; assigning to that tree or to one
+     * of its parents invalidates the handle.
+     *
+     * \tparam T Type of the value
+     * \param key Key name
+     * \throws RangeError if key does not exist or cannot be parsed as T
+     */
+    template <class T>
+    Handle<T> handle(const std::string& key) const {
+      const std::string* value = lookup(key);
+      if(not value)
+        DUNE_THROW(RangeError, "Key '" << key << "' not found in parameter "
+                   "file!");
+      return Handle<T>(key, value);
+    }
+
     /** \brief get value keys
      *
      * Returns a vector of all keys associated to (key,values) entries in
@@ -221,12 +261,72 @@ namespace Dune {
      */
     const KeyVector& getSubKeys() const;
 
+
+    /** \brief write the tree in a compact binary format
+     *
+     * Writes the keys, values and substructures in order of
+     * appearance, so deserialize() recreates the tree including the
+     * key orders. The format is independent of the byte order and can
+     * be used to send a tree to other processes or to cache it on disk:
+     * a header "DUNEPT1\n", followed by the tree as the number of values,
+     * the (key, value) pairs, the number of substructures and the
+     * (name, substructure) pairs. Numbers are 32 bit little endian,
+     * strings are preceded by their length.
+     *
+     * \param stream Stream to write to, should be opened in binary mode
+     */
+    void serialize(std::ostream& stream) const;
+
+
+    /** \brief read a tree written by serialize()
+     *
+     * The entries are added to this tree.
+     *
+     * \param stream Stream to read from
+     * \param overwrite Whether to overwrite already existing values.
+     *        If false, values already present are kept.
+     * \throw Dune::IOError if the stream does not contain a serialized tree
+     */
+    void deserialize(std::istream& stream, bool overwrite = true);
+
   protected:
+    // entry of the flat index from dotted keys to values
+    struct IndexEntry
+    {
+      std::string key;
+      std::size_t hash;
+      std::string* value;
+    };
+
     KeyVector valueKeys;
     KeyVector subKeys;
 
     std::map<std::string, std::string> values;
     std::map<std::string, ParameterTree> subs;
+
+    // the tree this is a substructure of, or 0
+    ParameterTree* parent;
+
+    // open addressing hash table over the dotted keys of the values of
+    // this tree and its subtrees, only kept by trees without a parent.
+    // It is built when the tree is copied or assigned to and extended
+    // by its non-const operator[]; other keys are found by walking the
+    // subtrees. Assigning to a subtree rebuilds the index of the root,
+    // as the assignment destroys values the index points to.
+    std::vector<IndexEntry> index;
+    std::size_t indexed;
+
+    // the value of key, or 0
+    const std::string* lookup(const std::string& key) const;
+    std::string& insert(const std::string& key);
+    void copyTree(const ParameterTree& other);
+    const IndexEntry* findIndex(const std::string& key, std::size_t hash) const;
+    void insertIndex(const std::string& key, std::size_t hash, std::string* value);
+    void rebuildIndex(const std::string& prefix, ParameterTree& tree);
+    void serializeTree(std::ostream& stream) const;
+    void deserializeTree(std::istream& stream, const std::string& prefix, bool overwrite);
+    static std::size_t hashKey(const std::string& key);
+
     static std::string ltrim(const std::string& s);
     static std::string rtrim(const std::string& s);
     static std::vector<std::string> split(const std::string & s);
@@ -257,6 +357,71 @@ namespace Dune {
     }
   };
 
+  /** \brief Value of a ParameterTree, parsed once as a T
+   *
+   * Obtained from ParameterTree::handle(). Dereferencing costs a
+   * comparison of the value with the string it was parsed from, the
+   * value is parsed again only if it was modified since.
+   */
+  template<class T>
+  class ParameterTree::Handle
+  {
+  public:
+    //! \brief Create a handle which does not refer to a value
+    Handle() : text_(0), value_() {}
+
+    //! \brief The value, parsed again if it was modified
+    const T& operator*() const
+    {
+      if(*text_ != parsed_)
+        refresh();
+      return value_;
+    }
+
+    //! \brief Access members of the value
+    const T* operator->() const
+    {
+      return &**this;
+    }
+
+    //! \brief The key the handle was obtained for
+    const std::string& key() const
+    {
+      return key_;
+    }
+
+  private:
+    friend class ParameterTree;
+
+    Handle(const std::string& key, const std::string* text)
+      : key_(key), text_(text), parsed_(*text), value_(parse())
+    {}
+
+    void refresh() const
+    {
+      value_ = parse();
+      parsed_ = *text_;
+    }
+
+    T parse() const
+    {
+      try {
+        return Parser<T>::parse(*text_);
+      }
+      catch(const RangeError&) {
+        DUNE_THROW(RangeError, "Cannot parse value \"" <<
+                   *text_ << "\" for key \"" << key_ << "\" as a " <<
+                   className<T>());
+      }
+    }
+
+    std::string key_;
+    const std::string* text_;
+    // the string value_ was parsed from
+    mutable std::string parsed_;
+    mutable T value_;
+  };
+
   template<typename T>
   struct ParameterTree::Parser {
     static T parse(const std::string& str) {
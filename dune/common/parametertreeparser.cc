@@ -13,40 +13,214 @@
 #include <string>
 #include <sstream>
 #include <fstream>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 
-std::string Dune::ParameterTreeParser::ltrim(const std::string& s)
-{
-    std::size_t firstNonWS = s.find_first_not_of(" \t\n\r");
+namespace {
 
-    if (firstNonWS!=std::string::npos)
-        return s.substr(firstNonWS);
-    return std::string();
-}
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
 
-std::string Dune::ParameterTreeParser::rtrim(const std::string& s)
-{
-    std::size_t lastNonWS = s.find_last_not_of(" \t\n\r");
+    // the first non-whitespace character in [begin,end), or end
+    const char* skipSpace(const char* begin, const char* end)
+    {
+        while (begin != end && isSpace(*begin))
+            ++begin;
+        return begin;
+    }
 
-    if (lastNonWS!=std::string::npos)
-        return s.substr(0, lastNonWS+1);
-    return std::string();
-}
+    // the end of [begin,end) without trailing whitespace
+    const char* trimEnd(const char* begin, const char* end)
+    {
+        while (end != begin && isSpace(end[-1]))
+            --end;
+        return end;
+    }
 
+    // the set of the values set from a file, identified by their address
+    // in the tree, open addressing with linear probing
+    class ValueSet
+    {
+    public:
+        ValueSet() : slots_(64, 0), size_(0) {}
+
+        // returns false if value is already in the set
+        bool insert(const std::string* value)
+        {
+            if (2 * (size_ + 1) > slots_.size())
+                grow();
+            std::size_t i = find(value);
+            if (slots_[i] != 0)
+                return false;
+            slots_[i] = value;
+            ++size_;
+            return true;
+        }
+
+    private:
+        // the slot holding value or the free slot to put it in
+        std::size_t find(const std::string* value) const
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t i = (reinterpret_cast<std::size_t>(value) / sizeof(std::string)
+                             * 2654435761u) & mask;
+            while (slots_[i] != 0 && slots_[i] != value)
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        void grow()
+        {
+            std::vector<const std::string*> old(2 * slots_.size(), 0);
+            old.swap(slots_);
+            for (std::size_t i = 0; i < old.size(); ++i)
+                if (old[i] != 0)
+                    slots_[find(old[i])] = old[i];
+        }
+
+        std::vector<const std::string*> slots_;
+        std::size_t size_;
+    };
+
+    // the lines of [begin,end), split like by repeated getline() until eof
+    class LineReader
+    {
+    public:
+        LineReader(const char* begin, const char* end)
+            : next_(begin), end_(end), eof_(false)
+        {}
+
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        // the next line without the newline
+        void read(const char*& begin, const char*& end)
+        {
+            begin = next_;
+            end = std::find(next_, end_, '\n');
+            eof_ = (end == end_);
+            next_ = eof_ ? end_ : end + 1;
+        }
+
+    private:
+        const char* next_;
+        const char* end_;
+        bool eof_;
+    };
+
+    // true if the last non-whitespace character of value is quote
+    bool endsWith(const std::string& value, char quote)
+    {
+        const char* end = trimEnd(value.data(), value.data() + value.size());
+        return end != value.data() && end[-1] == quote;
+    }
+
+    void parseINI(const char* begin, const char* end, Dune::ParameterTree& pt,
+                  const std::string& srcname, bool overwrite)
+    {
+        std::string prefix, key, value;
+        ValueSet valuesInFile;
+        LineReader lines(begin, end);
+        while (not lines.eof())
+        {
+            const char* lineBegin;
+            const char* lineEnd;
+            lines.read(lineBegin, lineEnd);
+            lineBegin = skipSpace(lineBegin, lineEnd);
+            if (lineBegin == lineEnd || *lineBegin == '#')
+                continue;
+
+            if (*lineBegin == '[')
+            {
+                lineEnd = trimEnd(lineBegin, lineEnd);
+                if (lineEnd[-1] == ']' && lineEnd - lineBegin >= 2)
+                {
+                    const char* nameBegin = skipSpace(lineBegin + 1, lineEnd - 1);
+                    prefix.assign(nameBegin, trimEnd(nameBegin, lineEnd - 1));
+                    if (prefix != "")
+                        prefix += ".";
+                }
+                continue;
+            }
+
+            lineEnd = std::find(lineBegin, lineEnd, '#');
+            const char* mid = std::find(lineBegin, lineEnd, '=');
+            if (mid == lineEnd)
+                continue;
+
+            key.assign(prefix);
+            key.append(lineBegin, trimEnd(lineBegin, mid));
+            const char* valueBegin = skipSpace(mid + 1, lineEnd);
+
+            if (valueBegin != lineEnd && (*valueBegin == '\'' || *valueBegin == '"'))
+            {
+                // quoted strings may span several lines
+                const char quote = *valueBegin;
+                value.assign(valueBegin + 1, lineEnd);
+                while (not endsWith(value, quote))
+                {
+                    if (not lines.eof())
+                    {
+                        lines.read(lineBegin, lineEnd);
+                        value += '\n';
+                        value.append(lineBegin, lineEnd);
+                    }
+                    else
+                        value += quote;
+                }
+                value.erase(trimEnd(value.data(), value.data() + value.size()) - value.data() - 1);
+            }
+            else
+                value.assign(valueBegin, trimEnd(valueBegin, lineEnd));
+
+            // a key appears twice if its value was read from the file before
+            const Dune::ParameterTree& cpt = pt;
+            const bool keep = not overwrite && pt.hasKey(key);
+            std::string* target = keep ? 0 : &pt[key];
+            if (not valuesInFile.insert(keep ? &cpt[key] : target))
+                DUNE_THROW(Dune::Exception, "Key '" << key <<
+                           "' appears twice in " << srcname << " !");
+            if (target)
+                target->swap(value);
+        }
+    }
+
+} // end anonymous namespace
 
 
 void Dune::ParameterTreeParser::readINITree(std::string file,
                                             ParameterTree& pt,
                                             bool overwrite)
 {
-    std::ifstream in(file.c_str());
+    std::ifstream in(file.c_str(), std::ios::binary);
 
     if (!in)
         DUNE_THROW(Dune::IOError, "Could not open configuration file " << file);
 
-    readINITree(in, pt, "file '" + file + "'", overwrite);
+    // read the whole file at once
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    if (size <= 0)
+    {
+        // pipes and FIFOs cannot seek, read them in blocks
+        in.clear();
+        readINITree(in, pt, "file '" + file + "'", overwrite);
+        return;
+    }
+
+    std::string buffer(size, '\0');
+    in.read(&buffer[0], size);
+    buffer.resize(in.gcount());
+
+    parseINI(buffer.data(), buffer.data() + buffer.size(), pt,
+             "file '" + file + "'", overwrite);
 }
 
 
@@ -63,73 +237,13 @@ void Dune::ParameterTreeParser::readINITree(std::istream& in,
                                             const std::string srcname,
                                             bool overwrite)
 {
-    std::string prefix;
-    std::set<std::string> keysInFile;
-    while(!in.eof())
-    {
-        std::string line;
-        getline(in, line);
-        line = ltrim(line);
-        switch (line[0]) {
-            case '#':
-                break;
-            case '[':
-                line = rtrim(line);
-                if (line[line.length()-1] == ']')
-                {
-                    prefix = rtrim(ltrim(line.substr(1, line.length()-2)));
-                    if (prefix != "")
-                        prefix += ".";
-                }
-                break;
-            default:
-                std::string::size_type comment = line.find("#");
-                line = line.substr(0,comment);
-                std::string::size_type mid = line.find("=");
-                if (mid != std::string::npos)
-                {
-                    std::string key = prefix+rtrim(ltrim(line.substr(0, mid)));
-                    std::string value = ltrim(line.substr(mid+1));
-
-                    if (value.length()>0)
-                    {
-                        // handle quoted strings
-                        if ((value[0]=='\'') or (value[0]=='"'))
-                        {
-                            char quote = value[0];
-                            value=value.substr(1);
-                            while (*(rtrim(value).rbegin())!=quote)
-                            {
-                                if (not in.eof())
-                                {
-                                    std::string l;
-                                    getline(in, l);
-                                    value = value+"\n"+l;
-                                }
-                                else
-                                    value = value+quote;
-                            }
-                            value = rtrim(value);
-                            value = value.substr(0,value.length()-1);
-                        }
-                        else
-                            value = rtrim(value);
-                    }
-
-                    if (keysInFile.count(key) != 0)
-                        DUNE_THROW(Exception, "Key '" << key <<
-                                   "' appears twice in " << srcname << " !");
-                    else
-                    {
-                        if(overwrite || ! pt.hasKey(key))
-                            pt[key] = value;
-                        keysInFile.insert(key);
-                    }
-                }
-                break;
-        }
-    }
+    // read the rest of the stream in large blocks
+    std::string buffer;
+    std::vector<char> block(1 << 16);
+    while (in.read(&block[0], block.size()) || in.gcount() > 0)
+        buffer.append(&block[0], in.gcount());
 
+    parseINI(buffer.data(), buffer.data() + buffer.size(), pt, srcname, overwrite);
 }
 
 
@@ -7,10 +7,16 @@
  * \brief Various parser methods to get data into a ParameterTree object
  */
 
+#include <climits>
+#include <exception>
 #include <istream>
+#include <new>
+#include <sstream>
 #include <string>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/parametertree.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
 
 namespace Dune {
 
@@ -20,10 +26,6 @@ namespace Dune {
    */
   class ParameterTreeParser
   {
-      
-    static std::string ltrim(const std::string& s);
-    static std::string rtrim(const std::string& s);
-
   public:
 
     /** @name Parsing methods for the INITree file format
@@ -117,6 +119,33 @@ namespace Dune {
      */
     static void readINITree(std::string file, ParameterTree& pt, bool overwrite = true);
 
+
+    /** \brief parse file on one process and broadcast the result
+     *
+     * Collective version of readINITree(std::string, ParameterTree&, bool)
+     * for large parallel jobs: only the process with rank 0 in comm opens
+     * and parses the file, the tree is sent to the other processes in
+     * the format of ParameterTree::serialize(). Errors are reported on
+     * all processes.
+     *
+     * \param file filename
+     * \param pt   The parameter tree to store the config structure.
+     * \param comm The processes reading the file, all of them have to call this method.
+     * \param overwrite Whether to overwrite already existing values.
+     *                  If false, values in the file will be ignored
+     *                  if the key is already present.
+     * \throw Dune::IOError if the file cannot be read on rank 0
+     *
+     * An exception on rank 0 is rethrown there unchanged. The other
+     * ranks throw a Dune::IOError, Dune::RangeError, Dune::Exception or
+     * std::bad_alloc with the message of the original exception, and a
+     * Dune::Exception for any other type.
+     */
+    template<class C>
+    static void readINITree(std::string file, ParameterTree& pt,
+                            const CollectiveCommunication<C>& comm,
+                            bool overwrite = true);
+
     //@}
 
     /** \brief parse command line options and build hierarchical ParameterTree structure
@@ -132,8 +161,105 @@ namespace Dune {
      */
     static void readOptions(int argc, char* argv [], ParameterTree& pt);
 
+  private:
+    // the outcome of reading a file on rank 0, sent to the other ranks
+    enum ReadStatus { readOk, ioError, rangeError, duneError, badAlloc, otherError };
+
+    // tell the other ranks about an error on rank 0
+    template<class C>
+    static void broadcastError(const CollectiveCommunication<C>& comm,
+                               ReadStatus status, const char* message)
+    {
+      std::string data(message);
+      int header[2] = { status, int(data.size()) };
+      comm.broadcast(header, 2, 0);
+      if (header[1] > 0)
+        comm.broadcast(&data[0], header[1], 0);
+    }
+
   };
 
+  template<class C>
+  void ParameterTreeParser::readINITree(std::string file, ParameterTree& pt,
+                                        const CollectiveCommunication<C>& comm,
+                                        bool overwrite)
+  {
+    // the serialized tree, or the message of the error on rank 0
+    std::string data;
+    // the ReadStatus of rank 0 and the size of data
+    int header[2] = { readOk, 0 };
+
+    if (comm.rank() == 0) {
+      // the other ranks wait for the broadcast, so they have to hear
+      // about every error before it is rethrown here
+      try {
+        ParameterTree parsed;
+        readINITree(file, parsed);
+        std::ostringstream stream;
+        parsed.serialize(stream);
+        data = stream.str();
+        if (data.size() > std::size_t(INT_MAX))
+          DUNE_THROW(IOError, "Configuration file " << file << " is too large to broadcast");
+      }
+      catch (const IOError& e) {
+        broadcastError(comm, ioError, e.what().c_str());
+        throw;
+      }
+      catch (const RangeError& e) {
+        broadcastError(comm, rangeError, e.what().c_str());
+        throw;
+      }
+      catch (const Exception& e) {
+        broadcastError(comm, duneError, e.what().c_str());
+        throw;
+      }
+      catch (const std::bad_alloc&) {
+        broadcastError(comm, badAlloc, "");
+        throw;
+      }
+      catch (const std::exception& e) {
+        broadcastError(comm, otherError, e.what());
+        throw;
+      }
+      catch (...) {
+        broadcastError(comm, otherError, "Unknown exception while reading the configuration file");
+        throw;
+      }
+      header[1] = data.size();
+    }
+
+    comm.broadcast(header, 2, 0);
+    data.resize(header[1]);
+    if (header[1] > 0)
+      comm.broadcast(&data[0], header[1], 0);
+
+    // throw with the message of the original exception
+    switch (header[0]) {
+    case readOk :
+      break;
+    case ioError : {
+      IOError e;
+      e.message(data);
+      throw e;
+    }
+    case rangeError : {
+      RangeError e;
+      e.message(data);
+      throw e;
+    }
+    case badAlloc :
+      throw std::bad_alloc();
+    default : {
+      Exception e;
+      e.message(data);
+      throw e;
+    }
+    }
+
+    std::istringstream stream(data);
+    pt.deserialize(stream, overwrite);
+  }
+
 } // end namespace Dune
 
 #endif // DUNE_PARAMETER_PARSER_HH
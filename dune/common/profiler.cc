@@ -0,0 +1,171 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cassert>
+#include <map>
+
+#if HAVE_STD_THREAD
+#include <mutex>
+#endif
+
+#include <dune/common/profiler.hh>
+
+namespace Dune {
+
+  namespace {
+
+    // owns the profilers of all threads, which live until the end of
+    // the program
+    struct ProfilerRegistry
+    {
+      ~ProfilerRegistry ()
+      {
+        for (std::size_t i=0; i<profilers.size(); ++i)
+          delete profilers[i];
+      }
+
+      std::vector<Profiler*> profilers;
+#if HAVE_STD_THREAD
+      std::mutex mutex;
+#else
+      int mutex; // unused without threads
+#endif
+    };
+
+    ProfilerRegistry& registry ()
+    {
+      static ProfilerRegistry r;
+      return r;
+    }
+
+#if HAVE_STD_THREAD
+    typedef std::lock_guard<std::mutex> RegistryLock;
+#else
+    struct RegistryLock
+    {
+      explicit RegistryLock (const int&) {}
+    };
+#endif
+
+#if HAVE_STD_THREAD && defined(__GNUC__)
+    __thread Profiler* localProfiler = 0;
+#elif HAVE_STD_THREAD
+    thread_local Profiler* localProfiler = 0;
+#else
+    Profiler* localProfiler = 0;
+#endif
+
+    // adds the regions below node to the summaries
+    void summarizeTree (const std::vector<Profiler::Region>& regions, std::size_t node,
+                        const std::string& path, int depth,
+                        std::map<std::string, Profiler::Summary>& summaries)
+    {
+      const Profiler::Region& region = regions[node];
+      for (std::size_t i=0; i<region.children.size(); ++i) {
+        const Profiler::Region& child = regions[region.children[i]];
+        const std::string childPath = depth > 0 ? path + Profiler::separator + child.name : child.name;
+        double exclusive = child.timer.elapsed();
+        for (std::size_t j=0; j<child.children.size(); ++j)
+          exclusive -= regions[child.children[j]].timer.elapsed();
+
+        std::map<std::string, Profiler::Summary>::iterator s = summaries.find(childPath);
+        if (s == summaries.end()) {
+          Profiler::Summary summary;
+          summary.path = childPath;
+          summary.depth = depth;
+          summary.count = 0;
+          summary.inclusive = 0;
+          summary.exclusive = 0;
+          summary.threads = 0;
+          s = summaries.insert(std::make_pair(childPath, summary)).first;
+        }
+        s->second.count += child.count;
+        s->second.inclusive = std::max(s->second.inclusive, child.timer.elapsed());
+        s->second.exclusive = std::max(s->second.exclusive, exclusive);
+        s->second.threads += 1;
+
+        summarizeTree(regions, region.children[i], childPath, depth + 1, summaries);
+      }
+    }
+
+  } // end anonymous namespace
+
+  const char Profiler::separator;
+
+  Profiler::Profiler ()
+    : current_(0), depth_(0)
+  {
+    regions_.push_back(Region("", 0));
+  }
+
+  Profiler& Profiler::local ()
+  {
+    if (localProfiler == 0) {
+      ProfilerRegistry& r = registry();
+      RegistryLock lock(r.mutex);
+      localProfiler = new Profiler;
+      r.profilers.push_back(localProfiler);
+    }
+    return *localProfiler;
+  }
+
+  void Profiler::enter (const char* name)
+  {
+    std::size_t child = regions_.size();
+    const std::vector<std::size_t>& children = regions_[current_].children;
+    for (std::size_t i=0; i<children.size(); ++i)
+      if (regions_[children[i]].name == name) {
+        child = children[i];
+        break;
+      }
+    if (child == regions_.size()) {
+      regions_.push_back(Region(name, current_));
+      regions_[current_].children.push_back(child);
+    }
+
+    current_ = child;
+    ++depth_;
+    ++regions_[child].count;
+    regions_[child].timer.start();
+  }
+
+  void Profiler::leave ()
+  {
+    assert(depth_ > 0);
+    regions_[current_].timer.stop();
+    current_ = regions_[current_].parent;
+    --depth_;
+  }
+
+  void Profiler::reset ()
+  {
+    ProfilerRegistry& r = registry();
+    RegistryLock lock(r.mutex);
+    for (std::size_t i=0; i<r.profilers.size(); ++i) {
+      assert(r.profilers[i]->depth_ == 0);
+      *r.profilers[i] = Profiler();
+    }
+  }
+
+  std::vector<Profiler::Summary> Profiler::summarize ()
+  {
+    std::map<std::string, Summary> summaries;
+    {
+      ProfilerRegistry& r = registry();
+      RegistryLock lock(r.mutex);
+      for (std::size_t i=0; i<r.profilers.size(); ++i)
+        summarizeTree(r.profilers[i]->regions_, 0, "", 0, summaries);
+    }
+
+    std::vector<Summary> result;
+    result.reserve(summaries.size());
+    for (std::map<std::string, Summary>::const_iterator s = summaries.begin(); s != summaries.end(); ++s)
+      result.push_back(s->second);
+    return result;
+  }
+
+} // end namespace Dune
@@ -0,0 +1,301 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_COMMON_PROFILER_HH
+#define DUNE_COMMON_PROFILER_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/timer.hh>
+
+/** @file
+    @brief Hierarchical profiling of named code regions
+*/
+
+namespace Dune {
+
+  /** @addtogroup Common
+      @{
+  */
+
+  /**
+     @brief Call tree of named regions with call counts and wall times
+
+     Every thread has its own profiler, which records the regions
+     entered by the thread as a call tree: a region entered while
+     another one is open becomes its child, so the same name can
+     appear at several places in the tree. For each node the number of
+     calls and the wall time spent inside (inclusive) and outside of
+     its children (exclusive) is recorded with a WallTimer.
+
+     Regions are usually opened with DUNE_PROFILE_SCOPE, which
+     expands to nothing unless DUNE_PROFILING is defined:
+
+     @code
+     void assemble ()
+     {
+       DUNE_PROFILE_SCOPE("assemble");
+       for (...) {
+         DUNE_PROFILE_SCOPE("local");
+         ...
+       }
+     }
+     ...
+     Dune::Profiler::report(std::cout, grid.comm());
+     @endcode
+
+     report() merges the trees of all threads of a process, taking
+     the sum of the calls and the maximum of the times over the
+     threads, and then reduces the merged trees over all processes.
+     Only the root process prints the minimum, average and maximum
+     over the processes and the load imbalance max/avg - 1 for each
+     region.
+
+     @note The profiler of a thread stays alive until the end of the
+     program, so regions of threads that have finished are reported,
+     too. reset() and report() must not be called while another thread
+     is inside a region.
+  */
+  class Profiler
+  {
+  public:
+    //! A node of the call tree of one thread
+    struct Region
+    {
+      Region (const std::string& name_, std::size_t parent_)
+        : name(name_), parent(parent_), count(0), timer(false)
+      {}
+
+      //! The name given to enter()
+      std::string name;
+      //! The index of the enclosing region, the root is its own parent
+      std::size_t parent;
+      //! The indices of the regions entered from this one
+      std::vector<std::size_t> children;
+      //! The number of times the region was entered
+      unsigned long count;
+      //! The inclusive wall time spent in the region
+      WallTimer timer;
+    };
+
+    //! The statistics of one region, merged over the threads of a process
+    struct Summary
+    {
+      /** @brief The names of the enclosing regions and of the region,
+          separated by Profiler::separator
+      */
+      std::string path;
+      //! The nesting depth, 0 for top level regions
+      int depth;
+      //! The number of calls, summed over the threads
+      unsigned long count;
+      //! The maximum inclusive time over the threads
+      double inclusive;
+      //! The maximum exclusive time over the threads
+      double exclusive;
+      //! The number of threads which entered the region
+      int threads;
+    };
+
+    //! Separates the region names in Summary::path, sorts before all printable characters
+    static const char separator = '\x1f';
+
+    //! The profiler of the calling thread
+    static Profiler& local ();
+
+    //! Enter the region name below the current region
+    void enter (const char* name);
+
+    //! Leave the current region
+    void leave ();
+
+    //! The number of open regions
+    std::size_t depth () const
+    {
+      return depth_;
+    }
+
+    /** @brief The call tree of this thread
+
+        The first entry is an unnamed root, which is never entered.
+     */
+    const std::vector<Region>& regions () const
+    {
+      return regions_;
+    }
+
+    //! Clear the call trees of all threads
+    static void reset ();
+
+    //! Merge the call trees of all threads, sorted by path
+    static std::vector<Summary> summarize ();
+
+    /** @brief Print the regions of all threads and processes
+
+        This is a collective operation, all processes of comm have to
+        call it. Only the process root writes to os.
+     */
+    template<class C>
+    static void report (std::ostream& os, const CollectiveCommunication<C>& comm, int root = 0);
+
+    //! Print the regions of all threads of this process
+    static void report (std::ostream& os)
+    {
+      report(os, CollectiveCommunication<No_Comm>());
+    }
+
+  private:
+    Profiler ();
+
+    // unions the paths of all processes into paths
+    template<class C>
+    static void gatherPaths (const std::vector<Summary>& local, const CollectiveCommunication<C>& comm,
+                             std::vector<std::string>& paths);
+
+    std::vector<Region> regions_;
+    std::size_t current_;
+    std::size_t depth_;
+  };
+
+  /**
+     @brief Enters a region of the profiler of the calling thread on
+     construction and leaves it on destruction
+  */
+  class ProfileScope
+  {
+  public:
+    explicit ProfileScope (const char* name)
+      : profiler_(Profiler::local())
+    {
+      profiler_.enter(name);
+    }
+
+    ~ProfileScope ()
+    {
+      profiler_.leave();
+    }
+
+  private:
+    ProfileScope (const ProfileScope&);
+    ProfileScope& operator= (const ProfileScope&);
+
+    Profiler& profiler_;
+  };
+
+#ifndef DOXYGEN
+#define DUNE_PROFILE_CONCAT_(a,b) a##b
+#define DUNE_PROFILE_CONCAT(a,b) DUNE_PROFILE_CONCAT_(a,b)
+#endif
+
+#if defined(DUNE_PROFILING) || defined(DOXYGEN)
+  /**
+     @brief Profile the rest of the enclosing scope as region name
+
+     Expands to nothing unless DUNE_PROFILING is defined.
+  */
+#define DUNE_PROFILE_SCOPE(name) \
+  Dune::ProfileScope DUNE_PROFILE_CONCAT(duneProfileScope,__LINE__)(name)
+#else
+#define DUNE_PROFILE_SCOPE(name)
+#endif
+
+  template<class C>
+  void Profiler::gatherPaths (const std::vector<Summary>& local, const CollectiveCommunication<C>& comm,
+                              std::vector<std::string>& paths)
+  {
+    // every process sends its paths as zero terminated strings,
+    // padded with zeros to the longest list
+    std::string names;
+    for (std::size_t i=0; i<local.size(); ++i) {
+      names += local[i].path;
+      names += '\0';
+    }
+    int length = names.size() + 1;
+    length = comm.max(length);
+    std::vector<char> send(length, '\0'), recv(std::size_t(length) * comm.size());
+    std::copy(names.begin(), names.end(), send.begin());
+    comm.allgather(&send[0], length, &recv[0]);
+
+    paths.clear();
+    for (int p=0; p<comm.size(); ++p) {
+      const char* name = &recv[std::size_t(p) * length];
+      while (*name != '\0') {
+        std::string path(name);
+        paths.push_back(path);
+        name += path.size() + 1;
+      }
+    }
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+  }
+
+  template<class C>
+  void Profiler::report (std::ostream& os, const CollectiveCommunication<C>& comm, int root)
+  {
+    std::vector<Summary> local = summarize();
+    std::vector<std::string> paths;
+    gatherPaths(local, comm, paths);
+
+    // statistics of all regions of all processes, zero where a process
+    // did not enter a region
+    const std::size_t n = paths.size();
+    std::vector<unsigned long> count(n+1, 0);
+    std::vector<double> inclusive(n+1, 0.0), exclusive(n+1, 0.0);
+    std::vector<int> threads(n+1, 0);
+    for (std::size_t i=0, j=0; i<local.size(); ++i) {
+      while (paths[j] != local[i].path)
+        ++j;
+      count[j] = local[i].count;
+      inclusive[j] = local[i].inclusive;
+      exclusive[j] = local[i].exclusive;
+      threads[j] = local[i].threads;
+    }
+    std::vector<double> minInclusive(inclusive), maxInclusive(inclusive);
+    comm.sum(&count[0], n);
+    comm.min(&minInclusive[0], n);
+    comm.max(&maxInclusive[0], n);
+    comm.sum(&inclusive[0], n);
+    comm.sum(&exclusive[0], n);
+    comm.max(&threads[0], n);
+
+    if (comm.rank() != root)
+      return;
+
+    const double size = comm.size();
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "Profile of " << comm.size() << " process(es), wall times in seconds\n"
+       << std::left << std::setw(32) << "region" << std::right
+       << std::setw(12) << "calls" << std::setw(8) << "threads"
+       << std::setw(12) << "incl min" << std::setw(12) << "incl avg"
+       << std::setw(12) << "incl max" << std::setw(12) << "excl avg"
+       << std::setw(11) << "imbalance" << "\n";
+    os << std::scientific << std::setprecision(3);
+    for (std::size_t i=0; i<n; ++i) {
+      std::size_t begin = paths[i].rfind(separator);
+      begin = (begin == std::string::npos) ? 0 : begin + 1;
+      const std::string indent(2 * std::count(paths[i].begin(), paths[i].end(), separator), ' ');
+      const double average = inclusive[i] / size;
+      const double imbalance = average > 0 ? maxInclusive[i] / average - 1 : 0;
+      os << std::left << std::setw(32) << (indent + paths[i].substr(begin)) << std::right
+         << std::setw(12) << count[i] << std::setw(8) << threads[i]
+         << std::setw(12) << minInclusive[i] << std::setw(12) << average
+         << std::setw(12) << maxInclusive[i] << std::setw(12) << exclusive[i] / size
+         << std::fixed << std::setprecision(1)
+         << std::setw(10) << 100 * imbalance << "%\n"
+         << std::scientific << std::setprecision(3);
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  /** @} */
+
+} // namespace Dune
+
+#endif // DUNE_COMMON_PROFILER_HH
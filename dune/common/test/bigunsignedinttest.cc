@@ -3,6 +3,7 @@
 #endif
 
 #include<dune/common/bigunsignedint.hh>
+#include<cstdlib>
 #include<limits>
 #include<iostream>
 
@@ -10,6 +11,94 @@
 #include<boost/functional/hash.hpp>
 #endif
 
+// random number with the given number of significant bits
+template<int k>
+Dune::bigunsignedint<k> randomNumber(int significant)
+{
+  Dune::bigunsignedint<k> x(0);
+  for(int i=0; i<significant; i+=16)
+    x = (x<<16) + std::size_t(std::rand()&0xFFFF);
+  return x>>((16-significant%16)%16);
+}
+
+// check the arithmetic against identities that hold for all operands
+template<int k>
+int checkArithmetic(const Dune::bigunsignedint<k>& a, const Dune::bigunsignedint<k>& b)
+{
+  typedef Dune::bigunsignedint<k> Big;
+  int ret=0;
+  if(a+b-b!=a || a-b+b!=a){
+    std::cerr<<"addition/subtraction failed for "<<a<<", "<<b<<std::endl;
+    ++ret;
+  }
+  if(a*Big(1)!=a || a*Big(2)!=a+a || a*(b+Big(1))!=a*b+a){
+    std::cerr<<"multiplication failed for "<<a<<", "<<b<<std::endl;
+    ++ret;
+  }
+  if(b!=Big(0)){
+    Big q=a/b, r=a%b;
+    if(!(r<b) || q*b+r!=a){
+      std::cerr<<"division failed for "<<a<<" / "<<b<<": "<<q<<" rest "<<r<<std::endl;
+      ++ret;
+    }
+  }
+  for(int s=0; s<k; s+=13)
+    if(((a<<s)>>s)!=(a&((~Big(0))>>s)) || (a>>s)<<s!=(a&((~Big(0))<<s))){
+      std::cerr<<"shift by "<<s<<" failed for "<<a<<std::endl;
+      ++ret;
+    }
+  if((a<b)!=(b>a) || (a<=b)!=!(a>b) || (a==b)!=(!(a<b) && !(b<a))){
+    std::cerr<<"comparison failed for "<<a<<", "<<b<<std::endl;
+    ++ret;
+  }
+  return ret;
+}
+
+template<int k>
+int checkRandom()
+{
+  int ret=0;
+  for(int i=0; i<200; ++i){
+    int bitsA = 1+std::rand()%k, bitsB = 1+std::rand()%k;
+    ret += checkArithmetic(randomNumber<k>(bitsA), randomNumber<k>(bitsB));
+  }
+  // divisors with a single nonzero limb and the largest numbers
+  Dune::bigunsignedint<k> max = std::numeric_limits<Dune::bigunsignedint<k> >::max();
+  ret += checkArithmetic(max, Dune::bigunsignedint<k>(7));
+  ret += checkArithmetic(max, max);
+  ret += checkArithmetic(max, max>>1);
+  ret += checkArithmetic(max-Dune::bigunsignedint<k>(1), max);
+  return ret;
+}
+
+#ifdef __SIZEOF_INT128__
+// compare with the 128 bit integer type of the compiler
+int checkInt128()
+{
+  typedef unsigned __int128 uint128;
+  typedef Dune::bigunsignedint<128> Big;
+  int ret=0;
+  for(int i=0; i<1000; ++i){
+    Big a = randomNumber<128>(1+std::rand()%128), b = randomNumber<128>(1+std::rand()%128);
+    uint128 ra=0, rb=0;
+    for(int j=127; j>=0; --j){
+      ra = (ra<<1) | (((a>>j)&Big(1))==Big(1));
+      rb = (rb<<1) | (((b>>j)&Big(1))==Big(1));
+    }
+    uint128 results[5] = { ra+rb, ra-rb, ra*rb, rb ? ra/rb : 0, rb ? ra%rb : 0 };
+    Big bigResults[5] = { a+b, a-b, a*b, rb ? a/b : Big(0), rb ? a%b : Big(0) };
+    for(int r=0; r<5; ++r){
+      Big expected = (Big(std::size_t(results[r]>>64))<<64) + std::size_t(results[r]);
+      if(bigResults[r]!=expected){
+        std::cerr<<"operation "<<r<<" differs from unsigned __int128 for "<<a<<", "<<b<<std::endl;
+        ++ret;
+      }
+    }
+  }
+  return ret;
+}
+#endif
+
 int main()
 {
   
@@ -100,4 +189,24 @@ int main()
   catch(Dune::MathError e){
     std::cout<<e<<std::endl;
   }
+
+  int ret=0;
+  ret += checkRandom<32>();
+  ret += checkRandom<64>();
+  ret += checkRandom<100>();
+  ret += checkRandom<256>();
+#ifdef __SIZEOF_INT128__
+  ret += checkInt128();
+#endif
+
+  // division by zero
+  try{
+    b=0;
+    c=a/b;
+    std::cerr<<"division by zero did not throw"<<std::endl;
+    ++ret;
+  }
+  catch(Dune::MathError&){}
+
+  return ret;
 }
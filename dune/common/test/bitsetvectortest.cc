@@ -9,6 +9,10 @@
 
 #include<dune/common/test/iteratortest.hh>
 
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
 template<class BBF>
 struct ConstReferenceOp
 {
@@ -177,11 +181,137 @@ void doTest() {
 #endif
 }
 
+// compare the whole vector operations with a bitwise reference
+template<int block_size>
+int testBulkOperations(int blocks)
+{
+    typedef Dune::BitSetVector<block_size> BBF;
+    int ret = 0;
+
+    std::vector<bool> a(blocks*block_size), b(blocks*block_size);
+    for (size_t k=0; k<a.size(); ++k)
+    {
+        a[k] = (k%3 == 0) || (k%7 == 1);
+        b[k] = (k%5 == 2);
+    }
+
+    BBF x(a), y(b);
+    size_t n = std::count(a.begin(), a.end(), true);
+    if (x.count() != n)
+    {
+        std::cerr << "count() returned " << x.count() << " instead of " << n << std::endl;
+        ++ret;
+    }
+
+    for (int j=0; j<block_size; ++j)
+    {
+        size_t m = 0;
+        for (int i=0; i<blocks; ++i)
+            m += a[i*block_size+j];
+        if (x.countmasked(j) != m)
+        {
+            std::cerr << "countmasked(" << j << ") is wrong" << std::endl;
+            ++ret;
+        }
+    }
+
+    // iterate over the set bits
+    size_t k = 0, found = 0;
+    for (size_t pos = x.findFirst(); pos != BBF::npos; pos = x.findNext(pos), ++found)
+    {
+        while (!a[k])
+            ++k;
+        if (pos != k || !x[pos/block_size][pos%block_size])
+        {
+            std::cerr << "findNext() returned " << pos << " instead of " << k << std::endl;
+            ++ret;
+        }
+        ++k;
+    }
+    if (found != n)
+    {
+        std::cerr << "Iteration visited " << found << " bits instead of " << n << std::endl;
+        ++ret;
+    }
+
+    BBF z(x);
+    z &= y;
+    BBF o(x);
+    o |= y;
+    BBF e(x);
+    e ^= y;
+    BBF f(x);
+    f.flip();
+    for (int i=0; i<blocks; ++i)
+        for (int j=0; j<block_size; ++j)
+        {
+            size_t l = i*block_size+j;
+            if (z[i][j] != (a[l] && b[l]) || o[i][j] != (a[l] || b[l])
+                || e[i][j] != (a[l] != b[l]) || f[i][j] == a[l])
+            {
+                std::cerr << "Bitwise operation failed for bit " << l << std::endl;
+                ++ret;
+            }
+        }
+    if (f.count() != a.size() - n)
+    {
+        std::cerr << "flip() touched bits outside the vector" << std::endl;
+        ++ret;
+    }
+
+    // growing with true must only set the new bits
+    BBF g(blocks, false);
+    g.resize(blocks+3, true);
+    if (g.count() != size_t(3*block_size) || g[blocks-1].any() || !g.back().test(block_size-1))
+    {
+        std::cerr << "resize() failed" << std::endl;
+        ++ret;
+    }
+
+    g.unsetAll();
+    if (g.any() || !g.none() || g.findFirst() != BBF::npos)
+    {
+        std::cerr << "unsetAll() failed" << std::endl;
+        ++ret;
+    }
+    g.setAll();
+    if (g.count() != size_t((blocks+3)*block_size))
+    {
+        std::cerr << "setAll() failed" << std::endl;
+        ++ret;
+    }
+    g[1].reset();
+    if (g[1].any())
+    {
+        std::cerr << "reset() failed" << std::endl;
+        ++ret;
+    }
+
+    if (block_size > 1)
+    {
+        try {
+            std::vector<bool> c(block_size+1);
+            BBF h(c);
+            std::cerr << "No exception for bitfield of wrong size" << std::endl;
+            ++ret;
+        } catch (Dune::RangeError&) {}
+    }
+
+    return ret;
+}
+
 int main()
 {
     doTest<4, std::allocator<bool> >();
 #if defined(__GNUC__) && ! defined(__clang__)
     doTest<4, __gnu_cxx::malloc_allocator<bool> >();
 #endif
-    return 0;
+
+    int ret = 0;
+    ret += testBulkOperations<1>(200);
+    ret += testBulkOperations<3>(100);
+    ret += testBulkOperations<4>(50);
+    ret += testBulkOperations<64>(5);
+    ret += testBulkOperations<70>(7);
+    return ret;
 }
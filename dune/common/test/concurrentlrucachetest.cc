@@ -0,0 +1,96 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <assert.h>
+#include <iostream>
+#include <dune/common/concurrentlrucache.hh>
+
+#if HAVE_STD_THREAD
+#include <thread>
+#include <vector>
+
+void concurrentlrucache_test()
+{
+    std::cout << "testing Dune::ConcurrentLRUCache<int,double>\n";
+
+    Dune::ConcurrentLRUCache<int, double> cache(64, 4);
+    assert(cache.capacity() == 64 && cache.shards() == 4);
+
+    double d;
+    assert(!cache.find(1, d));
+    cache.insert(1, 1.0);
+    cache.insert(2, 2.0);
+    assert(cache.find(1, d) && d == 1.0);
+    cache.insert(1, 3.0);
+    assert(cache.find(1, d) && d == 3.0);
+    assert(cache.size() == 2);
+    assert(cache.hits() == 2 && cache.misses() == 1);
+    assert(cache.touch(2) && !cache.touch(3));
+    assert(cache.erase(2) && !cache.erase(2) && !cache.contains(2));
+
+    // fill beyond capacity, the cache has to evict
+    for (int i = 0; i < 1000; ++i)
+        cache.insert(i, i);
+    assert(cache.size() <= cache.capacity());
+    assert(cache.evictions() >= 1000 - 64);
+    // entries are either gone or hold the right value
+    for (int i = 0; i < 1000; ++i)
+        assert(!cache.find(i, d) || d == i);
+
+    cache.clear();
+    assert(cache.size() == 0);
+
+    std::cout << "... passed\n";
+}
+
+void fill (Dune::ConcurrentLRUCache<int, double> * cache, int offset, int * errors)
+{
+    for (int round = 0; round < 20; ++round)
+        for (int i = 0; i < 500; ++i)
+        {
+            int key = (offset + i) % 1500;
+            double d;
+            if (cache->find(key, d))
+            {
+                if (d != 0.5 * key)
+                    ++*errors;
+            }
+            else
+                cache->insert(key, 0.5 * key);
+        }
+}
+
+void concurrentlrucache_thread_test()
+{
+    std::cout << "testing Dune::ConcurrentLRUCache with threads\n";
+
+    Dune::ConcurrentLRUCache<int, double> cache(256);
+    const int nthreads = 4;
+    std::vector<int> errors(nthreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; ++t)
+        threads.push_back(std::thread(fill, &cache, 300 * t, &errors[t]));
+    for (int t = 0; t < nthreads; ++t)
+        threads[t].join();
+
+    for (int t = 0; t < nthreads; ++t)
+        assert(errors[t] == 0);
+    assert(cache.size() <= cache.capacity());
+    assert(cache.hits() + cache.misses() == nthreads * 20 * 500);
+
+    std::cout << "... passed\n";
+}
+#endif // HAVE_STD_THREAD
+
+int main ()
+{
+#if HAVE_STD_THREAD
+    concurrentlrucache_test();
+    concurrentlrucache_thread_test();
+    return 0;
+#else
+    std::cout << "std::thread is not supported, skipping test\n";
+    return 77;
+#endif
+}
@@ -0,0 +1,141 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if HAVE_STD_THREAD
+#include <thread>
+#endif
+
+#include <dune/common/debuglog.hh>
+#include <dune/common/debugstream.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed at "                    \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+void writeLines (Dune::DebugLog* log, int id, int lines)
+{
+  std::ostream& os = log->stream();
+  for (int j=0; j<lines; ++j)
+    os << "writer " << id << " line " << j << std::endl;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  {
+    // lines are prefixed and only handed over when complete
+    std::ostringstream target;
+    Dune::DebugLog log(target, 2, Dune::DebugLog::rankPrefix | Dune::DebugLog::threadPrefix);
+    log.stream() << "hello " << 42 << "\nworld";
+    log.flush();
+    CHECK(target.str() == "[r2|t0] hello 42\n");
+    log.stream() << " and more" << std::endl;
+    log.flush();
+    CHECK(target.str() == "[r2|t0] hello 42\n[r2|t0] world and more\n");
+
+    // a line longer than the buffer of the thread
+    const std::string longLine(10000, 'x');
+    log.stream() << longLine << std::endl;
+    log.flush();
+    CHECK(target.str().size() == 40 + 8 + longLine.size() + 1);
+  }
+
+  {
+    std::ostringstream target;
+    {
+      Dune::DebugLog log(target, 0);
+      log.stream() << "timed" << std::endl << "incomplete";
+      log.flush();
+      const std::string s = target.str();
+      CHECK(s.compare(0, 7, "[r0|t0|") == 0);
+      CHECK(s.find("s] timed\n") != std::string::npos);
+    }
+    // the destructor writes the incomplete line
+    CHECK(target.str().find("s] incomplete\n") != std::string::npos);
+  }
+
+  {
+    // DebugStream output through the log, disabled levels vanish
+    std::ostringstream target;
+    Dune::DebugLog log(target, 0, Dune::DebugLog::noPrefix);
+    Dune::DebugStream<1, 1> on;
+    Dune::DebugStream<1, 4> off;
+    CHECK((Dune::DebugStream<1, 1>::enabled));
+    CHECK(!(Dune::DebugStream<1, 4>::enabled));
+    on.attach(log);
+    off.attach(log);
+    on << "on " << 1 << std::endl;
+    off << "off " << 2 << std::endl;
+    on.flush();
+    on.detach();
+    off.detach();
+    log.flush();
+    CHECK(target.str() == "on 1\n");
+  }
+
+  {
+    // one file per rank
+    {
+      Dune::DebugLog log("debuglogtest", 5, Dune::DebugLog::rankPrefix);
+      log.stream() << "to file" << std::endl;
+    }
+    std::ifstream file("debuglogtest.5.log");
+    std::string line;
+    std::getline(file, line);
+    CHECK(line == "[r5] to file");
+    file.close();
+    std::remove("debuglogtest.5.log");
+  }
+
+#if HAVE_STD_THREAD
+  {
+    // lines of different threads do not interleave and keep their order
+    const int writers = 4, lines = 2000;
+    std::ostringstream target;
+    Dune::DebugLog log(target, 0, Dune::DebugLog::threadPrefix);
+    std::vector<std::thread> threads;
+    for (int i=0; i<writers; ++i)
+      threads.push_back(std::thread(writeLines, &log, i, lines));
+    // the batch size may change while the threads are writing
+    log.setBatchSize(1024);
+    CHECK(log.batchSize() == 1024);
+    for (int i=0; i<writers; ++i)
+      threads[i].join();
+    log.flush();
+
+    std::istringstream output(target.str());
+    std::vector<int> next(writers, 0);
+    std::string line;
+    int count = 0;
+    while (std::getline(output, line)) {
+      int thread, id, j;
+      if (std::sscanf(line.c_str(), "[t%d] writer %d line %d", &thread, &id, &j) != 3
+          || thread < 0 || thread >= writers || id < 0 || id >= writers) {
+        CHECK(false);
+        std::cerr << "bad line: " << line << std::endl;
+        break;
+      }
+      CHECK(j == next[id]);
+      next[id] = j + 1;
+      ++count;
+    }
+    CHECK(count == writers * lines);
+  }
+#endif
+
+  return ret;
+}
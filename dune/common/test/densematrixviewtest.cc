@@ -0,0 +1,213 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// The views have to give the same results as DynamicVector and
+// DynamicMatrix holding copies of the viewed entries.
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/densematrixview.hh>
+#include <dune/common/densevectorview.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed at "                    \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+template<class K>
+K random ()
+{
+  return K(double(std::rand()) / RAND_MAX - 0.5);
+}
+
+template<class V1, class V2>
+bool equal (const Dune::DenseVector<V1>& x, const Dune::DenseVector<V2>& y)
+{
+  if (x.size() != y.size())
+    return false;
+  for (std::size_t i=0; i<x.size(); ++i)
+    if (x[i] != y[i])
+      return false;
+  return true;
+}
+
+template<class M1, class M2>
+bool equal (const Dune::DenseMatrix<M1>& A, const Dune::DenseMatrix<M2>& B)
+{
+  if (A.rows() != B.rows() || A.cols() != B.cols())
+    return false;
+  for (std::size_t i=0; i<A.rows(); ++i)
+    for (std::size_t j=0; j<A.cols(); ++j)
+      if (A[i][j] != B[i][j])
+        return false;
+  return true;
+}
+
+template<class K>
+int testVectorView ()
+{
+  int ret = 0;
+
+  // every third entry of a buffer
+  std::vector<K> buffer(3*7);
+  Dune::DenseVectorView<K> x(&buffer[0], 7, 3);
+  Dune::DynamicVector<K> y(7);
+  for (std::size_t i=0; i<7; ++i)
+    y[i] = x[i] = random<K>();
+
+  CHECK(x.size() == 7);
+  CHECK(&x[2] == &buffer[6]);
+  CHECK(x.one_norm() == y.one_norm());
+  CHECK(x.two_norm() == y.two_norm());
+  CHECK(x.infinity_norm() == y.infinity_norm());
+  CHECK(x * y == y * y);
+
+  // arithmetic writes through, binary operators return owning vectors
+  x *= K(2);
+  y *= K(2);
+  CHECK(equal(x, y));
+  CHECK(buffer[3] == y[1]);
+  Dune::DynamicVector<K> z = x + y;
+  y += y;
+  CHECK(equal(z, y));
+
+  // copies are shallow, assignment copies the entries
+  Dune::DenseVectorView<K> w(x);
+  w[0] = K(42);
+  CHECK(x[0] == K(42));
+  std::vector<K> other(7);
+  Dune::DenseVectorView<K> u(&other[0], 7);
+  u = x;
+  CHECK(equal(u, x));
+  CHECK(&u[0] == &other[0]);
+
+  return ret;
+}
+
+template<class K>
+int testMatrixView ()
+{
+  int ret = 0;
+  const std::size_t n = 6;
+
+  // n x n block at offset (1,2) of a row-major 8x9 array
+  std::vector<K> storage(8*9);
+  for (std::size_t i=0; i<storage.size(); ++i)
+    storage[i] = random<K>();
+  Dune::DenseMatrixView<K> whole(&storage[0], 8, 9);
+  Dune::DenseMatrixView<K> A = whole.block(1, 2, n, n);
+  CHECK(&A[0][0] == &storage[1*9+2]);
+  CHECK(A.rows() == n && A.cols() == n);
+  for (std::size_t i=0; i<n; ++i)
+    A[i][i] += K(n);
+
+  Dune::DynamicMatrix<K> dA(A);
+  CHECK(equal(A, dA));
+
+  // norms
+  CHECK(A.frobenius_norm() == dA.frobenius_norm());
+  CHECK(A.infinity_norm() == dA.infinity_norm());
+  CHECK(A.infinity_norm_real() == dA.infinity_norm_real());
+
+  // matrix-vector products, also with views as vector arguments
+  std::vector<K> xbuf(2*n), ybuf(n);
+  Dune::DenseVectorView<K> x(&xbuf[0], n, 2), y(&ybuf[0], n);
+  Dune::DynamicVector<K> dx(n), dy(n);
+  for (std::size_t i=0; i<n; ++i)
+    dx[i] = x[i] = random<K>();
+  A.mv(x, y);
+  dA.mv(dx, dy);
+  CHECK(equal(y, dy));
+  A.umtv(x, y);
+  dA.umtv(dx, dy);
+  CHECK(equal(y, dy));
+
+  // transposed view and columns
+  Dune::DenseMatrixView<K> At = A.transposed();
+  Dune::DynamicVector<K> dz(n);
+  At.mv(dx, dz);
+  dA.mtv(dx, dy);
+  CHECK(equal(dz, dy));
+  CHECK(equal(A.column(3), At[3]));
+  CHECK(&At[1][4] == &A[4][1]);
+
+  // solve, determinant and invert work on the viewed entries
+  A.solve(y, x);
+  dA.solve(dy, dx);
+  CHECK(equal(y, dy));
+  CHECK(A.determinant() == dA.determinant());
+  CHECK(std::abs(At.determinant() - A.determinant()) <= 1e-4*std::abs(A.determinant()));
+  std::vector<K> before(storage);
+  A.invert();
+  dA.invert();
+  CHECK(equal(A, dA));
+  // entries outside the block are untouched
+  CHECK(storage[0] == before[0] && storage[1*9+1] == before[1*9+1]
+        && storage[1*9+8] == before[1*9+8] && storage[7*9+2] == before[7*9+2]);
+
+  // products with the view as target and as factor
+  Dune::DynamicMatrix<K> dB(n, n);
+  for (std::size_t i=0; i<n; ++i)
+    for (std::size_t j=0; j<n; ++j)
+      dB[i][j] = random<K>();
+  A.rightmultiply(dB);
+  dA.rightmultiply(dB);
+  CHECK(equal(A, dA));
+  Dune::DynamicMatrix<K> dC(dB);
+  dB.leftmultiply(A);
+  dC.leftmultiply(dA);
+  CHECK(equal(dB, dC));
+
+  // row iterators return the rows as views by value
+  typedef typename Dune::DenseMatrixView<K>::RowIterator RowIterator;
+  typedef typename Dune::DenseMatrixView<K>::ConstRowIterator ConstRowIterator;
+  std::size_t rows = 0;
+  for (RowIterator it = A.begin(); it != A.end(); ++it, ++rows)
+  {
+    typename RowIterator::reference row = *it;
+    CHECK(it.index() == rows && &row[0] == &A[rows][0]);
+    for (typename RowIterator::reference::Iterator jt = row.begin(); jt != row.end(); ++jt)
+      *jt *= K(2);
+  }
+  CHECK(rows == n);
+  dA *= K(2);
+  CHECK(equal(A, dA));
+  const Dune::DenseMatrixView<K>& cA = A;
+  ConstRowIterator cit = A.begin();
+  CHECK(cit == cA.begin() && cA.end() - cit == std::ptrdiff_t(n));
+  CHECK(equal(cit[2], dA[2]) && equal(*(cA.end() - 1), dA[n-1]));
+
+  // assignment copies into the viewed memory
+  std::vector<K> copy(n*n);
+  Dune::DenseMatrixView<K> C(&copy[0], n, n);
+  C = A;
+  CHECK(equal(C, dA));
+  C = K(0);
+  CHECK(C.frobenius_norm() == 0);
+  CHECK(equal(A, dA));
+
+  return ret;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  ret += testVectorView<double>();
+  ret += testVectorView<std::complex<double> >();
+  ret += testMatrixView<double>();
+  ret += testMatrixView<float>();
+
+  return ret;
+}
@@ -0,0 +1,113 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <complex>
+#include <iostream>
+
+#include <dune/common/dynvector.hh>
+#include <dune/common/fvector.hh>
+
+// the lazily evaluated expressions have to give the same entries as the
+// eager vector operators
+template<class V>
+int testExpressions (V a, V b, V c)
+{
+  typedef typename V::value_type K;
+  int ret = 0;
+
+  for (typename V::size_type i=0; i<a.size(); ++i) {
+    a[i] = K(1.0 + i);
+    b[i] = K(0.1 * i);
+    c[i] = K(-2.0 / (i + 1));
+  }
+
+  V eager = a + b - c;
+  V fused = Dune::lazy(a) + b - c;
+  if (fused != eager) {
+    std::cerr << "lazy(a) + b - c differs from a + b - c" << std::endl;
+    ++ret;
+  }
+
+  fused = a - (Dune::lazy(b) + c);
+  eager = a - (b + c);
+  if (fused != eager) {
+    std::cerr << "a - (lazy(b) + c) differs from a - (b + c)" << std::endl;
+    ++ret;
+  }
+
+  // scaling and negation
+  V scaled(c);
+  scaled *= K(2);
+  eager = a - scaled;
+  eager += b;
+  fused = Dune::lazy(a) - 2.0*Dune::lazy(c) + b;
+  if (fused != eager) {
+    std::cerr << "Scaled expression is wrong" << std::endl;
+    ++ret;
+  }
+  fused = -Dune::lazy(c)*2.0 + a + b;
+  if (fused != eager) {
+    std::cerr << "Negated expression is wrong" << std::endl;
+    ++ret;
+  }
+
+  // update operators, also with the target appearing in the expression
+  V target(a);
+  target += Dune::lazy(b) - c;
+  eager = a;
+  eager += b - c;
+  if (target != eager) {
+    std::cerr << "operator+= with an expression is wrong" << std::endl;
+    ++ret;
+  }
+  eager -= eager - a;
+  target -= Dune::lazy(target) - a;
+  if (target != eager) {
+    std::cerr << "operator-= with an expression is wrong" << std::endl;
+    ++ret;
+  }
+  target = Dune::lazy(target) + target;
+  eager = eager + eager;
+  if (target != eager) {
+    std::cerr << "Aliased assignment is wrong" << std::endl;
+    ++ret;
+  }
+
+  return ret;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  typedef Dune::FieldVector<double,3> FV;
+  ret += testExpressions(FV(), FV(), FV());
+  typedef Dune::FieldVector<double,1> FV1;
+  ret += testExpressions(FV1(), FV1(), FV1());
+  typedef Dune::DynamicVector<double> DV;
+  ret += testExpressions(DV(7), DV(7), DV(7));
+  typedef Dune::DynamicVector<std::complex<double> > CV;
+  ret += testExpressions(CV(5), CV(5), CV(5));
+
+  // construction and resizing of dynamic vectors
+  DV a(4, 1.0), b(4, 2.0);
+  DV c = Dune::lazy(a) + b;
+  DV d;
+  d = 3.0*(Dune::lazy(c) - a);
+  if (c.size() != 4 || d.size() != 4 || c[3] != 3.0 || d[2] != 6.0) {
+    std::cerr << "Dynamic vector from expression is wrong" << std::endl;
+    ++ret;
+  }
+
+  // mixed field vector and dynamic vector operands
+  FV x(1.0), y(2.0);
+  DV z(3, 4.0);
+  FV w = Dune::lazy(x) + y - z;
+  if (w[0] != -1.0 || w[2] != -1.0) {
+    std::cerr << "Mixed expression is wrong" << std::endl;
+    ++ret;
+  }
+
+  return ret;
+}
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <vector>
 
 #include <dune/common/fvector.hh>
 #include <dune/common/exceptions.hh>
@@ -62,6 +63,83 @@ void test_interface()
   checkMatrixInterface< DiagonalMatrix, Traits >( A );
 }
 
+// the batched kernels have to give the same results as the methods
+// applied to each block
+template<class K, int n>
+void test_batch()
+{
+  typedef DiagonalMatrix<K,n> Matrix;
+  typedef FieldVector<K,n> Vector;
+  typedef DiagonalMatrixBatch<K,n> Batch;
+  const std::size_t count = 13;
+
+  std::vector<Matrix> D(count);
+  std::vector<Vector> x(count), b(count), r(count), y(count), z(count);
+  for (std::size_t k=0; k<count; ++k)
+    for (int i=0; i<n; ++i) {
+      D[k].diagonal(i) = K(2 + k + i);
+      x[k][i] = K(1) / K(1 + k*n + i);
+      b[k][i] = K(3 - int(k));
+      r[k][i] = K(0.25 * i);
+    }
+
+  Batch::mv(count, &D[0], &x[0], &y[0]);
+  for (std::size_t k=0; k<count; ++k)
+    D[k].mv(x[k], z[k]);
+  if (y != z)
+    DUNE_THROW(FMatrixError, "DiagonalMatrixBatch::mv differs from DiagonalMatrix::mv");
+
+  Batch::umv(count, &D[0], &x[0], &y[0]);
+  Batch::mmv(count, &D[0], &b[0], &y[0]);
+  Batch::usmv(count, K(0.5), &D[0], &r[0], &y[0]);
+  for (std::size_t k=0; k<count; ++k) {
+    D[k].umv(x[k], z[k]);
+    D[k].mmv(b[k], z[k]);
+    D[k].usmv(K(0.5), r[k], z[k]);
+  }
+  if (y != z)
+    DUNE_THROW(FMatrixError, "DiagonalMatrixBatch updates differ from DiagonalMatrix");
+
+  Batch::solve(count, &D[0], &y[0], &b[0]);
+  for (std::size_t k=0; k<count; ++k)
+    D[k].solve(z[k], b[k]);
+  if (y != z)
+    DUNE_THROW(FMatrixError, "DiagonalMatrixBatch::solve differs from DiagonalMatrix::solve");
+
+  Batch::solveResidual(count, &D[0], &y[0], &b[0], &r[0]);
+  for (std::size_t k=0; k<count; ++k) {
+    D[k].solveResidual(z[k], b[k], r[k]);
+    Vector t(b[k]);
+    t -= r[k];
+    Vector s;
+    D[k].solve(s, t);
+    if (s != z[k])
+      DUNE_THROW(FMatrixError, "DiagonalMatrix::solveResidual differs from solve");
+  }
+  if (y != z)
+    DUNE_THROW(FMatrixError, "DiagonalMatrixBatch::solveResidual differs from DiagonalMatrix::solveResidual");
+
+  y = x;
+  Batch::jacobi(count, K(0.7), &D[0], &y[0], &b[0], &r[0]);
+  for (std::size_t k=0; k<count; ++k) {
+    Vector t;
+    D[k].solveResidual(t, b[k], r[k]);
+    z[k] = x[k];
+    z[k].axpy(K(0.7), t);
+  }
+  if (y != z)
+    DUNE_THROW(FMatrixError, "DiagonalMatrixBatch::jacobi is wrong");
+
+  std::vector<Matrix> E(D);
+  Batch::invert(count, &E[0]);
+  for (std::size_t k=0; k<count; ++k) {
+    D[k].invert();
+    for (int i=0; i<n; ++i)
+      if (E[k].diagonal(i) != D[k].diagonal(i))
+        DUNE_THROW(FMatrixError, "DiagonalMatrixBatch::invert differs from DiagonalMatrix::invert");
+  }
+}
+
 int main()
 {
   try {
@@ -71,9 +149,14 @@ int main()
     test_interface<double, 1>();
     test_matrix<double, 5>();
     test_interface<double, 5>();
+    test_batch<double, 1>();
+    test_batch<double, 3>();
+    test_batch<float, 4>();
+    test_batch<double, 5>();
   }
   catch (Dune::Exception & e)
   {
     std::cerr << "Exception: " << e << std::endl;
+    return 1;
   }
 }
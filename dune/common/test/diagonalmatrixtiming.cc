@@ -0,0 +1,154 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// Compares the run time of y += D x and of the Jacobi update
+// x += D^{-1} (b - r) for many diagonal blocks, using
+// - the row and column iterators of DiagonalMatrix, as a generic
+//   sparse matrix algorithm does,
+// - the DiagonalMatrix methods for each block,
+// - the DiagonalMatrixBatch kernels for all blocks at once.
+//
+// usage: diagonalmatrixtiming [number of blocks] [repetitions]
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/diagonalmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+
+// One sweep over all blocks per call. The sweeps are called through
+// volatile function pointers, otherwise the compiler fuses the loop
+// over the repetitions with the loop over the blocks and the
+// comparison measures that instead of the kernels.
+
+template<int dim>
+void umvIterators (std::size_t n, const Dune::DiagonalMatrix<double,dim>* D,
+                   const Dune::FieldVector<double,dim>* x, Dune::FieldVector<double,dim>* y)
+{
+  typedef Dune::DiagonalMatrix<double,dim> Matrix;
+  typedef typename Matrix::ConstRowIterator RowIterator;
+  typedef typename Matrix::ConstColIterator ColIterator;
+  for (std::size_t k=0; k<n; ++k)
+    for (RowIterator row = D[k].begin(); row != D[k].end(); ++row)
+      for (ColIterator col = row->begin(); col != row->end(); ++col)
+        y[k][row.index()] += (*col) * x[k][col.index()];
+}
+
+template<int dim>
+void umvMethods (std::size_t n, const Dune::DiagonalMatrix<double,dim>* D,
+                 const Dune::FieldVector<double,dim>* x, Dune::FieldVector<double,dim>* y)
+{
+  for (std::size_t k=0; k<n; ++k)
+    D[k].umv(x[k], y[k]);
+}
+
+template<int dim>
+void umvBatch (std::size_t n, const Dune::DiagonalMatrix<double,dim>* D,
+               const Dune::FieldVector<double,dim>* x, Dune::FieldVector<double,dim>* y)
+{
+  Dune::DiagonalMatrixBatch<double,dim>::umv(n, D, x, y);
+}
+
+template<int dim>
+void jacobiSolve (std::size_t n, const Dune::DiagonalMatrix<double,dim>* D, Dune::FieldVector<double,dim>* x,
+                  const Dune::FieldVector<double,dim>* b, const Dune::FieldVector<double,dim>* r)
+{
+  typedef Dune::FieldVector<double,dim> Vector;
+  for (std::size_t k=0; k<n; ++k) {
+    Vector d(b[k]);
+    d -= r[k];
+    Vector c;
+    D[k].solve(c, d);
+    x[k] += c;
+  }
+}
+
+template<int dim>
+void jacobiBatch (std::size_t n, const Dune::DiagonalMatrix<double,dim>* D, Dune::FieldVector<double,dim>* x,
+                  const Dune::FieldVector<double,dim>* b, const Dune::FieldVector<double,dim>* r)
+{
+  Dune::DiagonalMatrixBatch<double,dim>::jacobi(n, 1.0, D, x, b, r);
+}
+
+template<int dim>
+bool timing(std::size_t n, int repetitions)
+{
+  typedef Dune::DiagonalMatrix<double,dim> Matrix;
+  typedef Dune::FieldVector<double,dim> Vector;
+  typedef void (*UmvSweep)(std::size_t, const Matrix*, const Vector*, Vector*);
+  typedef void (*JacobiSweep)(std::size_t, const Matrix*, Vector*, const Vector*, const Vector*);
+
+  std::vector<Matrix> D(n);
+  std::vector<Vector> x(n), b(n), r(n);
+  for (std::size_t k=0; k<n; ++k)
+    for (int i=0; i<dim; ++i) {
+      D[k].diagonal(i) = 1.0 + double(std::rand()) / RAND_MAX;
+      x[k][i] = double(std::rand()) / RAND_MAX;
+      b[k][i] = double(std::rand()) / RAND_MAX;
+      r[k][i] = 1e-3 * double(std::rand()) / RAND_MAX;
+    }
+  std::vector<Vector> yIterators(n, Vector(0.0)), yMethods(yIterators), yBatch(yIterators);
+  Dune::Timer stopwatch;
+
+  std::cout << "DiagonalMatrix<double," << dim << ">, " << n << " blocks\n";
+
+  // y += D x
+  UmvSweep volatile umv = umvIterators<dim>;
+  stopwatch.reset();
+  for (int rep=0; rep<repetitions; ++rep)
+    umv(n, &D[0], &x[0], &yIterators[0]);
+  std::cout << "  umv     iterators: " << stopwatch.elapsed() << " s";
+
+  umv = umvMethods<dim>;
+  stopwatch.reset();
+  for (int rep=0; rep<repetitions; ++rep)
+    umv(n, &D[0], &x[0], &yMethods[0]);
+  std::cout << ", methods: " << stopwatch.elapsed() << " s";
+
+  umv = umvBatch<dim>;
+  stopwatch.reset();
+  for (int rep=0; rep<repetitions; ++rep)
+    umv(n, &D[0], &x[0], &yBatch[0]);
+  std::cout << ", batch: " << stopwatch.elapsed() << " s" << std::endl;
+
+  bool ok = (yIterators == yMethods && yMethods == yBatch);
+
+  // x += D^{-1} (b - r)
+  std::vector<Vector> xMethods(x), xBatch(x);
+  JacobiSweep volatile jacobi = jacobiSolve<dim>;
+  stopwatch.reset();
+  for (int rep=0; rep<repetitions; ++rep)
+    jacobi(n, &D[0], &xMethods[0], &b[0], &r[0]);
+  std::cout << "  jacobi  solve: " << stopwatch.elapsed() << " s";
+
+  jacobi = jacobiBatch<dim>;
+  stopwatch.reset();
+  for (int rep=0; rep<repetitions; ++rep)
+    jacobi(n, &D[0], &xBatch[0], &b[0], &r[0]);
+  std::cout << ", batch: " << stopwatch.elapsed() << " s" << std::endl;
+
+  return ok && xMethods == xBatch;
+}
+
+int main (int argc, char** argv)
+{
+  std::size_t n = 100000;
+  int repetitions = 100;
+  if (argc > 1)
+    n = std::atol(argv[1]);
+  if (argc > 2)
+    repetitions = std::atoi(argv[2]);
+
+  bool ok = true;
+  ok = timing<1>(n, repetitions) && ok;
+  ok = timing<3>(n, repetitions) && ok;
+  ok = timing<4>(n, repetitions) && ok;
+  ok = timing<7>(n, repetitions) && ok;
+
+  if (!ok)
+    std::cerr << "Results differ!" << std::endl;
+  return ok ? 0 : 1;
+}
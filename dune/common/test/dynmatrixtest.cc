@@ -385,9 +385,72 @@ int test_determinant()
     return 0;
 }
 
+int test_memory_reuse()
+{
+  int ret = 0;
+
+  DynamicMatrix<double> A(4, 3, 1.0);
+  const double* row0 = &A[0][0];
+  A.resize(2, 3, 2.0);
+  if (&A[0][0] != row0 || A.N() != 2 || A[1][2] != 2.0)
+  {
+    std::cerr << "Shrinking resize did not reuse the rows" << std::endl;
+    ++ret;
+  }
+  A.resize(5, 2, 3.0);
+  if (&A[0][0] != row0 || A.N() != 5 || A.M() != 2 || A[0][1] != 3.0 || A[4][1] != 3.0)
+  {
+    std::cerr << "Growing resize is wrong" << std::endl;
+    ++ret;
+  }
+
+  // copy assignment reuses the memory of rows of matching size
+  DynamicMatrix<double> B(5, 2, 4.0);
+  A = B;
+  if (&A[0][0] != row0 || A[3][1] != 4.0)
+  {
+    std::cerr << "Copy assignment did not reuse the rows" << std::endl;
+    ++ret;
+  }
+
+  std::vector< DynamicVector<double> > rows(3, DynamicVector<double>(2, 5.0));
+  const double* adopted = &rows[0][0];
+  A.swap(rows);
+  if (&A[0][0] != adopted || A.N() != 3 || rows.size() != 5 || &rows[0][0] != row0)
+  {
+    std::cerr << "Swapping rows failed" << std::endl;
+    ++ret;
+  }
+
+#if HAVE_RVALUE_REFERENCES
+  DynamicMatrix<double> C(std::move(A));
+  if (&C[0][0] != adopted || A.N() != 0)
+  {
+    std::cerr << "Move construction copied the matrix" << std::endl;
+    ++ret;
+  }
+  B = std::move(C);
+  if (&B[0][0] != adopted || B.N() != 3)
+  {
+    std::cerr << "Move assignment copied the matrix" << std::endl;
+    ++ret;
+  }
+  DynamicMatrix<double> D(std::move(rows));
+  if (&D[0][0] != row0 || D.N() != 5)
+  {
+    std::cerr << "Adopting rows copied the matrix" << std::endl;
+    ++ret;
+  }
+#endif
+
+  return ret;
+}
+
 int main()
 {
   try {
+    if (test_memory_reuse())
+      return 1;
     Dune::DynamicMatrix<double> A( 5, 5 );
     checkMatrixInterface( A );
 
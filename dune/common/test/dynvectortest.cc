@@ -4,6 +4,7 @@
 #include <dune/common/dynvector.hh>
 #include <dune/common/exceptions.hh>
 #include <iostream>
+#include <vector>
 
 using Dune::DynamicVector;
 
@@ -57,9 +58,52 @@ void dynamicVectorTest(int d) {
     
 }
 
+int dynamicVectorMemoryTest()
+{
+  int ret = 0;
+
+  DynamicVector<double> v(10, 1.0), w(10, 2.0);
+  const double* data = &v[0];
+  v = w;
+  if (&v[0] != data || v[9] != 2.0) {
+    std::cerr << "Copy assignment did not reuse the memory" << std::endl;
+    ++ret;
+  }
+
+  std::vector<double> buffer(4, 3.0);
+  const double* external = &buffer[0];
+  v.swap(buffer);
+  if (&v[0] != external || v.size() != 4 || &buffer[0] != data) {
+    std::cerr << "Swapping with a std::vector failed" << std::endl;
+    ++ret;
+  }
+
+#if HAVE_RVALUE_REFERENCES
+  DynamicVector<double> moved(std::move(v));
+  if (&moved[0] != external || v.size() != 0) {
+    std::cerr << "Move construction copied the vector" << std::endl;
+    ++ret;
+  }
+  w = std::move(moved);
+  if (&w[0] != external || w.size() != 4) {
+    std::cerr << "Move assignment copied the vector" << std::endl;
+    ++ret;
+  }
+  DynamicVector<double> adopted(std::move(buffer));
+  if (&adopted[0] != data || adopted.size() != 10) {
+    std::cerr << "Adopting a std::vector copied it" << std::endl;
+    ++ret;
+  }
+#endif
+
+  return ret;
+}
+
 int main()
 {
   try {
+    if (dynamicVectorMemoryTest())
+      return 1;
     for (int d=1; d<6; d++)
     {
       dynamicVectorTest<int>(d);
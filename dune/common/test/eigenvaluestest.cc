@@ -11,9 +11,14 @@
 //==============================================================================
 
 #include <dune/common/fvector.hh>
+#include <dune/common/densematrixview.hh>
 #include <dune/common/dynmatrixev.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <iostream>
+#include <vector>
 
 
 //! \brief Represents a cardinal function on a line
@@ -249,9 +254,151 @@ protected:
     }
 };
 
+// The eigenvalues of the 1D Laplacian are 2-2cos(k pi/(n+1)), k=1,...,n.
+void laplacian(int n, Dune::DynamicMatrix<double>& A, std::vector<double>& eigenValues)
+{
+  A.resize(n, n, 0.0);
+  for (int i=0; i<n; ++i) {
+    A[i][i] = 2.0;
+    if (i > 0)
+      A[i][i-1] = A[i-1][i] = -1.0;
+  }
+  eigenValues.resize(n);
+  for (int k=0; k<n; ++k)
+    eigenValues[k] = 2.0 - 2.0*std::cos((k+1)*M_PI/(n+1));
+}
+
+int checkEigenPairs(const Dune::DynamicMatrix<double>& A,
+                    const Dune::DynamicVector<double>& eigenValues,
+                    const Dune::DynamicMatrix<double>& eigenVectors,
+                    const std::vector<double>& expected, int offset)
+{
+  int ret = 0;
+  if (eigenVectors.rows() != eigenValues.size())
+    return 1;
+  for (size_t i=0; i < eigenValues.size(); ++i) {
+    if (std::abs(eigenValues[i] - expected[i+offset]) > 1e-10) {
+      std::cerr << "Wrong eigenvalue " << eigenValues[i] << ", expected "
+                << expected[i+offset] << std::endl;
+      ++ret;
+    }
+    Dune::DynamicVector<double> Av(A.rows());
+    A.mv(eigenVectors[i], Av);
+    Av.axpy(-eigenValues[i], eigenVectors[i]);
+    if (Av.two_norm() > 1e-10 || std::abs(eigenVectors[i].two_norm() - 1.0) > 1e-10) {
+      std::cerr << "Wrong eigenvector for eigenvalue " << eigenValues[i] << std::endl;
+      ++ret;
+    }
+  }
+  return ret;
+}
+
+int testDynamicEigenSolver(Dune::DynamicEigenSolver<double>::Method method)
+{
+  int ret = 0;
+  Dune::DynamicEigenSolver<double> solver(method);
+  Dune::DynamicMatrix<double> A, eigenVectors;
+  Dune::DynamicVector<double> eigenValues;
+  std::vector<double> expected;
+
+  laplacian(40, A, expected);
+  solver.eigenValues(A, eigenValues);
+  for (size_t i=0; i < expected.size(); ++i)
+    if (std::abs(eigenValues[i] - expected[i]) > 1e-10) {
+      std::cerr << "Wrong eigenvalue " << eigenValues[i] << ", expected "
+                << expected[i] << std::endl;
+      ++ret;
+    }
+
+  // the workspace is reused for problems of the same size
+  solver.eigenValuesVectors(A, eigenValues, eigenVectors);
+  ret += checkEigenPairs(A, eigenValues, eigenVectors, expected, 0);
+  size_t workspace = solver.workspaceSize();
+  solver.eigenValuesVectors(A, eigenValues, eigenVectors);
+  ret += checkEigenPairs(A, eigenValues, eigenVectors, expected, 0);
+  if (solver.workspaceSize() != workspace) {
+    std::cerr << "Workspace was reallocated for a problem of the same size" << std::endl;
+    ++ret;
+  }
+
+  // selected eigenvalues
+  solver.eigenValuesRange(A, 5, 12, eigenValues, &eigenVectors);
+  if (eigenValues.size() != 7)
+    ++ret;
+  ret += checkEigenPairs(A, eigenValues, eigenVectors, expected, 5);
+
+  solver.eigenValuesInterval(A, 0.5*(expected[2]+expected[3]), 0.5*(expected[9]+expected[10]),
+                             eigenValues, &eigenVectors);
+  if (eigenValues.size() != 7)
+    ++ret;
+  ret += checkEigenPairs(A, eigenValues, eigenVectors, expected, 3);
+
+  try {
+    solver.eigenValuesRange(A, 10, 41, eigenValues);
+    std::cerr << "Invalid range not detected" << std::endl;
+    ++ret;
+  } catch (Dune::RangeError&) {}
+
+  // too large for the stack of most systems
+  laplacian(1000, A, expected);
+  solver.eigenValues(A, eigenValues);
+  for (size_t i=0; i < expected.size(); ++i)
+    if (std::abs(eigenValues[i] - expected[i]) > 1e-10) {
+      std::cerr << "Wrong eigenvalue " << eigenValues[i] << ", expected "
+                << expected[i] << std::endl;
+      ++ret;
+      break;
+    }
+
+  // nonsymmetric matrix with eigenvalues 1, 2 and 3
+  Dune::DynamicMatrix<double> B(3, 3, 0.0);
+  B[0][0] = 1.0; B[0][1] = 5.0; B[1][1] = 2.0; B[1][2] = -4.0; B[2][2] = 3.0;
+  Dune::DynamicVector<std::complex<double> > complexEigenValues;
+  solver.eigenValuesNonSym(B, complexEigenValues);
+  std::vector<double> real;
+  for (size_t i=0; i < complexEigenValues.size(); ++i)
+    real.push_back(std::real(complexEigenValues[i]));
+  std::sort(real.begin(), real.end());
+  if (real.size() != 3 || std::abs(real[0] - 1.0) > 1e-12
+      || std::abs(real[1] - 2.0) > 1e-12 || std::abs(real[2] - 3.0) > 1e-12) {
+    std::cerr << "Wrong eigenvalues of nonsymmetric matrix" << std::endl;
+    ++ret;
+  }
+
+  // the transposed nonsymmetric matrix as a view of column-major storage
+  // with leading dimension 5, its eigenvalues are the same
+  double storage[5*3] = {};
+  Dune::DenseMatrixView<double> Bt(storage, 3, 3, 1, 5);
+  Bt.transposed() = B;
+  solver.eigenValuesNonSym(Bt, complexEigenValues);
+  real.clear();
+  for (size_t i=0; i < complexEigenValues.size(); ++i)
+    real.push_back(std::real(complexEigenValues[i]));
+  std::sort(real.begin(), real.end());
+  if (real.size() != 3 || std::abs(real[0] - 1.0) > 1e-12
+      || std::abs(real[1] - 2.0) > 1e-12 || std::abs(real[2] - 3.0) > 1e-12) {
+    std::cerr << "Wrong eigenvalues of nonsymmetric matrix view" << std::endl;
+    ++ret;
+  }
+
+  // the Laplacian as a block of a larger array
+  laplacian(20, A, expected);
+  std::vector<double> large(25*25, 0.0);
+  Dune::DenseMatrixView<double> block = Dune::DenseMatrixView<double>(&large[0], 25, 25).block(2, 3, 20, 20);
+  block = A;
+  solver.eigenValuesVectors(block, eigenValues, eigenVectors);
+  ret += checkEigenPairs(A, eigenValues, eigenVectors, expected, 0);
+
+  return ret;
+}
+
 int main()
 {
     // Not really a test but better than nothing.
     PNShapeFunctionSet<2> lbasis(2, 3);
-    return 0;
+
+    int ret = 0;
+    ret += testDynamicEigenSolver(Dune::DynamicEigenSolver<double>::divideAndConquer);
+    ret += testDynamicEigenSolver(Dune::DynamicEigenSolver<double>::relativelyRobust);
+    return ret;
 }
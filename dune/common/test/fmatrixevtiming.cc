@@ -0,0 +1,102 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// Compares the run time of the symmetric eigenvalue solvers in
+// fmatrixev.hh for many small matrices.
+//
+// usage: fmatrixevtiming [number of matrices] [number of threads]
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fmatrixev.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+
+template<int dim>
+double maxDifference(const std::vector<Dune::FieldVector<double,dim> >& a,
+                     const std::vector<Dune::FieldVector<double,dim> >& b)
+{
+  double diff = 0;
+  for (std::size_t k=0; k<a.size(); ++k)
+    diff = std::max(diff, (a[k] - b[k]).infinity_norm());
+  return diff;
+}
+
+template<int dim>
+bool timing(std::size_t n, unsigned int threads)
+{
+  typedef Dune::FieldMatrix<double,dim,dim> Matrix;
+  typedef Dune::FieldVector<double,dim> Vector;
+
+  std::vector<Matrix> matrices(n);
+  for (std::size_t k=0; k<n; ++k)
+    for (int i=0; i<dim; ++i)
+      for (int j=0; j<=i; ++j)
+        matrices[k][i][j] = matrices[k][j][i] = double(std::rand()) / RAND_MAX;
+
+  std::vector<Vector> reference(n), eig(n);
+  std::vector<Matrix> vectors(n);
+  // wall clock time, the process CPU time adds up over the threads
+  Dune::WallTimer timer;
+  bool ok = true;
+
+  std::cout << "dim=" << dim << ", " << n << " matrices" << std::endl;
+
+  timer.reset();
+  for (std::size_t k=0; k<n; ++k)
+    Dune::FMatrixHelp::eigenValues<dim>(matrices[k], reference[k]);
+  std::cout << "  eigenValues, one call per matrix:       " << timer.elapsed() << " s" << std::endl;
+
+#if HAVE_LAPACK
+  timer.reset();
+  for (std::size_t k=0; k<n; ++k)
+    Dune::FMatrixHelp::eigenValuesLapack(matrices[k], eig[k]);
+  const double lapackTime = timer.elapsed();
+  std::cout << "  dsyev, one call per matrix:             " << lapackTime << " s"
+            << " (max difference " << maxDifference(reference, eig) << ")" << std::endl;
+  ok = ok && maxDifference(reference, eig) < 1e-10;
+#endif
+
+  timer.reset();
+  Dune::FMatrixHelp::eigenValuesBatched(&matrices[0], n, &eig[0]);
+  std::cout << "  eigenValuesBatched:                     " << timer.elapsed() << " s"
+            << " (max difference " << maxDifference(reference, eig) << ")" << std::endl;
+  ok = ok && maxDifference(reference, eig) < 1e-10;
+
+  timer.reset();
+  Dune::FMatrixHelp::eigenValuesBatched(&matrices[0], n, &eig[0], (Matrix*) 0, threads);
+  std::cout << "  eigenValuesBatched, " << threads << " threads:          " << timer.elapsed() << " s"
+            << " (max difference " << maxDifference(reference, eig) << ")" << std::endl;
+  ok = ok && maxDifference(reference, eig) < 1e-10;
+
+  timer.reset();
+  Dune::FMatrixHelp::eigenValuesBatched(&matrices[0], n, &eig[0], &vectors[0], threads);
+  std::cout << "  eigenValuesBatched with eigenvectors:   " << timer.elapsed() << " s" << std::endl;
+
+  return ok;
+}
+
+int main (int argc, char** argv)
+{
+  std::size_t n = 100000;
+  unsigned int threads = 4;
+  if (argc > 1)
+    n = std::atol(argv[1]);
+  if (argc > 2)
+    threads = std::atoi(argv[2]);
+
+  bool ok = true;
+  ok = timing<2>(n, threads) && ok;
+  ok = timing<3>(n, threads) && ok;
+  ok = timing<4>(n, threads) && ok;
+  ok = timing<8>(n, threads) && ok;
+  ok = timing<12>(n / 10, threads) && ok;
+
+  if (!ok)
+    std::cerr << "Results of the eigenvalue solvers differ!" << std::endl;
+  return ok ? 0 : 1;
+}
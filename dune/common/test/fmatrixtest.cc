@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <vector>
 #include <cassert>
+#include <cstdlib>
 #include <complex>
 
 #include "checkmatrixinterface.hh"
@@ -494,6 +495,160 @@ void test_ev()
   std::cout << "Eigenvalues of Rosser matrix: " << eig << std::endl;
 }
 
+// check eigenvalues and eigenvectors of a symmetric matrix
+template<typename ft, int dim>
+void check_eigenvectors(const Dune::FieldMatrix<ft,dim,dim>& A,
+                        const Dune::FieldVector<ft,dim>& eig,
+                        const Dune::FieldMatrix<ft,dim,dim>& vectors)
+{
+  const ft tolerance = 1e-10 * A.frobenius_norm();
+  for (int i=0; i<dim; ++i)
+  {
+    if (i>0 && eig[i-1] > eig[i])
+      DUNE_THROW(FMatrixError,"eigenvalues are not sorted");
+
+    Dune::FieldVector<ft,dim> Av;
+    A.mv(vectors[i], Av);
+    Av.axpy(-eig[i], vectors[i]);
+    if (Av.two_norm() > tolerance)
+      DUNE_THROW(FMatrixError,"wrong eigenvector for eigenvalue " << eig[i]);
+
+    for (int j=0; j<dim; ++j)
+      if (std::abs(vectors[i]*vectors[j] - (i==j ? 1.0 : 0.0)) > 1e-10)
+        DUNE_THROW(FMatrixError,"eigenvectors are not orthonormal");
+  }
+}
+
+template<typename ft, int dim>
+void test_ev_symmetric(const Dune::FieldMatrix<ft,dim,dim>& A)
+{
+  Dune::FieldVector<ft,dim> eig, eigJacobi;
+  Dune::FieldMatrix<ft,dim,dim> vectors, vectorsJacobi;
+
+  Dune::FMatrixHelp::eigenValues<dim>(A, eig);
+  Dune::FMatrixHelp::eigenValuesVectors(A, eig, vectors);
+  check_eigenvectors(A, eig, vectors);
+
+  Dune::FMatrixHelp::eigenValuesJacobi(A, eigJacobi, &vectorsJacobi);
+  check_eigenvectors(A, eigJacobi, vectorsJacobi);
+
+  if( (eig - eigJacobi).two_norm() > 1e-10 * A.frobenius_norm() )
+    DUNE_THROW(FMatrixError,"eigenvalues of Jacobi method differ");
+
+#if HAVE_LAPACK
+  Dune::FieldVector<ft,dim> eigLapack;
+  Dune::FMatrixHelp::eigenValuesLapack(A, eigLapack);
+  if( (eig - eigLapack).two_norm() > 1e-10 * A.frobenius_norm() )
+    DUNE_THROW(FMatrixError,"eigenvalues differ from LAPACK result");
+#endif
+}
+
+// symmetric matrices with well separated and with multiple eigenvalues
+template<typename ft>
+void test_ev_small()
+{
+  Dune::FieldMatrix<ft,3,3> A;
+  A <<=
+    4, 1, -2, Dune::nextRow,
+    1, 2, 0, Dune::nextRow,
+    -2, 0, 3;
+  test_ev_symmetric(A);
+
+  // diagonal matrix with unsorted entries
+  A <<=
+    3, 0, 0, Dune::nextRow,
+    0, -1, 0, Dune::nextRow,
+    0, 0, 2;
+  test_ev_symmetric(A);
+
+  // multiple of the identity
+  A <<=
+    2, 0, 0, Dune::nextRow,
+    0, 2, 0, Dune::nextRow,
+    0, 0, 2;
+  test_ev_symmetric(A);
+
+  // double eigenvalue 1 and simple eigenvalue 4
+  A <<=
+    2, 1, 1, Dune::nextRow,
+    1, 2, 1, Dune::nextRow,
+    1, 1, 2;
+  test_ev_symmetric(A);
+
+  // eigenvalues of very different magnitude
+  A <<=
+    1e6, 1e-3, 0, Dune::nextRow,
+    1e-3, 1, 1e-2, Dune::nextRow,
+    0, 1e-2, 1e-6;
+  test_ev_symmetric(A);
+
+  Dune::FieldMatrix<ft,2,2> B;
+  B <<=
+    1, 2, Dune::nextRow,
+    2, -3;
+  test_ev_symmetric(B);
+
+  Dune::FieldMatrix<ft,5,5> C;
+  for (int i=0; i<5; ++i)
+    for (int j=0; j<5; ++j)
+      C[i][j] = 1.0 / (i + j + 1.0) + (i==j ? i : 0);
+  test_ev_symmetric(C);
+
+  // badly scaled matrices, the Jacobi method stops at a relative tolerance
+  Dune::FieldMatrix<ft,5,5> S = C;
+  S *= 1e100;
+  test_ev_symmetric(S);
+  S = C;
+  S *= 1e-100;
+  test_ev_symmetric(S);
+
+  // large enough for dsyev
+  Dune::FieldMatrix<ft,7,7> D;
+  for (int i=0; i<7; ++i)
+    for (int j=0; j<7; ++j)
+      D[i][j] = 1.0 / (i + j + 1.0) + (i==j ? 1.0 : 0.0);
+  test_ev_symmetric(D);
+}
+
+// compare the batched eigenvalue computation with the one for single matrices
+template<typename ft, int dim>
+void test_ev_batched()
+{
+  typedef Dune::FieldMatrix<ft,dim,dim> Matrix;
+  typedef Dune::FieldVector<ft,dim> Vector;
+
+  // large enough to be split over two threads
+  const std::size_t n = 2100;
+  std::vector<Matrix> matrices(n);
+  for (std::size_t k=0; k<n; ++k)
+    for (int i=0; i<dim; ++i)
+      for (int j=0; j<=i; ++j)
+        matrices[k][i][j] = matrices[k][j][i] = (k % 7 == 0 && i != j) ? 0 : ft(std::rand()) / RAND_MAX - 0.5;
+  // multiple eigenvalues
+  for (int i=0; i<dim; ++i)
+    for (int j=0; j<dim; ++j)
+    {
+      matrices[3][i][j] = (i==j) ? 2 : 0;
+      matrices[5][i][j] = 1;
+    }
+
+  for (int threads=1; threads<=4; threads+=3)
+  {
+    std::vector<Vector> eig(n), eig2(n);
+    std::vector<Matrix> vectors(n);
+    Dune::FMatrixHelp::eigenValuesBatched(&matrices[0], n, &eig[0], (Matrix*) 0, threads);
+    Dune::FMatrixHelp::eigenValuesBatched(&matrices[0], n, &eig2[0], &vectors[0], threads);
+    for (std::size_t k=0; k<n; ++k)
+    {
+      Vector single;
+      Dune::FMatrixHelp::eigenValues<dim>(matrices[k], single);
+      if ((single - eig[k]).two_norm() > 1e-12 || (single - eig2[k]).two_norm() > 1e-12)
+        DUNE_THROW(FMatrixError,"batched eigenvalues of matrix " << k << " differ");
+      check_eigenvectors(matrices[k], eig2[k], vectors[k]);
+    }
+  }
+}
+
 template< class K, int n >
 void test_invert ()
 {
@@ -573,10 +728,12 @@ int main()
     // test complex matrices
     test_matrix<std::complex<float>, 1, 1>();
     test_matrix<std::complex<double>, 5, 10>();
-#if HAVE_LAPACK
     // test eigemvalue computation
     test_ev<double>();
-#endif
+    test_ev_small<double>();
+    test_ev_batched<double,2>();
+    test_ev_batched<double,3>();
+    test_ev_batched<double,4>();
     // test high level methods
     test_determinant();
     test_invert< float, 34 >();
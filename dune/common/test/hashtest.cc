@@ -0,0 +1,113 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// The hashes of equal keys have to be equal, and consecutive keys have
+// to be spread evenly over the buckets of a hash table.
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/bigunsignedint.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hash.hh>
+
+#if HAVE_DUNE_HASH
+
+// largest number of keys in one of 1024 buckets
+template<class Key>
+std::size_t maxBucketLoad (const std::vector<Key>& keys)
+{
+  Dune::hash<Key> hasher;
+  std::vector<std::size_t> load(1024, 0);
+  std::size_t max = 0;
+  for (std::size_t i=0; i<keys.size(); ++i) {
+    std::size_t& l = load[hasher(keys[i]) % load.size()];
+    if (++l > max)
+      max = l;
+  }
+  return max;
+}
+
+int main ()
+{
+  int ret = 0;
+  const int count = 16384;
+
+  // hash_mix spreads consecutive integers
+  {
+    std::vector<std::size_t> buckets(1024, 0);
+    std::size_t max = 0;
+    for (int i=0; i<count; ++i)
+      max = std::max(max, ++buckets[Dune::hash_mix(i) % buckets.size()]);
+    if (max > 40) {
+      std::cerr << "hash_mix: " << max << " of " << count << " keys in one bucket" << std::endl;
+      ++ret;
+    }
+  }
+
+  // bigunsignedint, equal for equal values, spread for consecutive ones
+  {
+    typedef Dune::bigunsignedint<128> Big;
+    Dune::hash<Big> hasher;
+    Big a = (Big(1)<<100) + Big(12345);
+    Big b = (Big(1)<<100) + Big(12345);
+    if (hasher(a) != hasher(b) || hasher(a) == hasher(a+Big(1))) {
+      std::cerr << "bigunsignedint hash is inconsistent" << std::endl;
+      ++ret;
+    }
+    std::vector<Big> keys;
+    for (int i=0; i<count; ++i)
+      keys.push_back((Big(7)<<64) + Big(i));
+    std::size_t max = maxBucketLoad(keys);
+    if (max > 40) {
+      std::cerr << "bigunsignedint: " << max << " of " << count << " keys in one bucket" << std::endl;
+      ++ret;
+    }
+  }
+
+  // FieldVector, by value such that 0 and -0 hash equal
+  {
+    typedef Dune::FieldVector<double,3> Vector;
+    Dune::hash<Vector> hasher;
+    Vector x(0.0), y(-0.0);
+    x[1] = y[1] = 0.5;
+    if (hasher(x) != hasher(y)) {
+      std::cerr << "FieldVector hash differs for 0 and -0" << std::endl;
+      ++ret;
+    }
+    std::vector<Vector> keys;
+    for (int i=0; i<128; ++i)
+      for (int j=0; j<128; ++j) {
+        Vector v(0.0);
+        v[0] = 0.125*i;
+        v[2] = 0.125*j;
+        keys.push_back(v);
+      }
+    std::size_t max = maxBucketLoad(keys);
+    if (max > 40) {
+      std::cerr << "FieldVector: " << max << " of " << keys.size() << " keys in one bucket" << std::endl;
+      ++ret;
+    }
+
+    Dune::FieldVector<int,2> i(3), j(3);
+    if (Dune::hash<Dune::FieldVector<int,2> >()(i) != Dune::hash<Dune::FieldVector<int,2> >()(j)) {
+      std::cerr << "FieldVector<int> hash is inconsistent" << std::endl;
+      ++ret;
+    }
+  }
+
+  return ret;
+}
+
+#else // HAVE_DUNE_HASH
+
+int main ()
+{
+  // no hash implementation available
+  return 77;
+}
+
+#endif // HAVE_DUNE_HASH
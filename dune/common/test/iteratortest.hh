@@ -124,7 +124,7 @@ int testRandomAccessIterator(Iter begin, Iter end, Opt opt){
     if(test != rand)
     {
       std::cerr << "i+=n should have the same result as applying the"
-		<< "increment ooperator n times!"<< std::cerr;
+		<< "increment ooperator n times!"<< std::endl;
       ret++;
     } 
     
@@ -143,7 +143,7 @@ int testRandomAccessIterator(Iter begin, Iter end, Opt opt){
     if(test != rand)
     {
       std::cerr << "i+=n should have the same result as applying the"
-		<< "increment ooperator n times!"<< std::cerr;
+		<< "increment ooperator n times!"<< std::endl;
       ret++;
     } 
   }
@@ -0,0 +1,120 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <assert.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <dune/common/lrucache.hh>
+
+struct RecordEviction
+{
+    RecordEviction (std::vector<int> & evicted) : _evicted(&evicted) {}
+    void operator() (const int & key, double &) const
+    {
+        _evicted->push_back(key);
+    }
+    std::vector<int> * _evicted;
+};
+
+void lrucache_test()
+{
+    std::cout << "testing Dune::LRUCache<int,double>\n";
+
+    Dune::LRUCache<int, double> lru;
+    lru.insert(10, 1.0);
+    assert(lru.front() == lru.back());
+    lru.insert(11, 2.0);
+    assert(lru.front() == 2.0 && lru.back() == 1.0);
+    lru.insert(12, 99);
+    lru.insert(13, 1.3);
+    lru.insert(14, 12345);
+    lru.insert(15, -17);
+    assert(lru.front() == -17 && lru.back() == 1.0);
+    // update
+    lru.insert(10);
+    assert(lru.front() == 1.0 && lru.back() == 2.0);
+    // update
+    lru.touch(13);
+    assert(lru.front() == 1.3 && lru.back() == 2.0);
+    // remove item
+    lru.pop_front();
+    assert(lru.front() == 1.0 && lru.back() == 2.0);
+    // remove item
+    lru.pop_back();
+    assert(lru.front() == 1.0 && lru.back() == 99);
+    assert(lru.size() == 4);
+
+    // lookup statistics
+    assert(lru.get(12) && *lru.get(12) == 99);
+    assert(lru.front() == 99);
+    assert(lru.get(13) == 0);
+    assert(lru.find(14) != lru.end() && lru.find(14)->second == 12345);
+    assert(lru.hits() == 4 && lru.misses() == 1);
+
+    // erase and reinsert, forcing the hash index to grow
+    assert(lru.erase(14) && !lru.erase(14));
+    for (int i = 0; i < 1000; ++i)
+        lru.insert(100 + i, i);
+    for (int i = 0; i < 1000; i += 2)
+        lru.erase(100 + i);
+    for (int i = 1; i < 1000; i += 2)
+        assert(*lru.get(100 + i) == i);
+    assert(lru.size() == 503);
+
+    // erase the key whose insert grew the hash index
+    Dune::LRUCache<int, double> grow;
+    for (int i = 0; i < 100; ++i)
+    {
+        grow.insert(i, i);
+        assert(grow.erase(i));
+        assert(grow.find(i) == grow.end() && grow.get(i) == 0);
+        assert(grow.size() == std::size_t(i));
+        grow.insert(i, i);
+    }
+    assert(grow.size() == 100);
+
+    std::cout << "... passed\n";
+}
+
+void lrucache_eviction_test()
+{
+    std::cout << "testing Dune::LRUCache eviction\n";
+
+    std::vector<int> evicted;
+    typedef Dune::LRUCache<int, double, RecordEviction> Cache;
+    Cache lru(3, 0, RecordEviction(evicted));
+    lru.insert(1, 1.0);
+    lru.insert(2, 2.0);
+    lru.insert(3, 3.0);
+    lru.touch(1);
+    lru.insert(4, 4.0);
+    assert(lru.size() == 3);
+    assert(evicted.size() == 1 && evicted[0] == 2);
+    assert(lru.find(2) == lru.end());
+
+    // iteration in recency order
+    int order[] = {4, 1, 3};
+    int i = 0;
+    for (Cache::const_iterator it = lru.begin(); it != lru.end(); ++it, ++i)
+        assert(it->first == order[i]);
+
+    // byte budget
+    lru.setCapacity(0);
+    lru.setByteBudget(10);
+    lru.insert(5, 5.0, 6);
+    lru.insert(6, 6.0, 6);
+    assert(lru.size() == 1 && lru.bytes() == 6);
+    assert(lru.evictions() == 5);
+
+    std::cout << "... passed\n";
+}
+
+int main ()
+{
+    lrucache_test();
+    lrucache_eviction_test();
+
+    return 0;
+}
@@ -0,0 +1,187 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/gmpfield.hh>
+#include <dune/common/mixedprecisionsolver.hh>
+
+// fill a diagonally dominant random matrix
+template<class M>
+void randomMatrix (M& A, int n)
+{
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<n; ++j)
+      A[i][j] = double(std::rand()) / RAND_MAX - 0.5 + ((i == j) ? n : 0);
+}
+
+// the n x n Hilbert matrix, condition number about 1e13 for n=10
+template<class M>
+void hilbertMatrix (M& A, int n)
+{
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<n; ++j)
+      A[i][j] = 1.0 / (i + j + 1.0);
+}
+
+// relative difference between the computed and the reference solution
+template<class V>
+double difference (const V& x, const V& reference)
+{
+  V diff(x);
+  diff -= reference;
+  return diff.infinity_norm() / reference.infinity_norm();
+}
+
+int testWellConditioned ()
+{
+  int ret = 0;
+
+  Dune::FieldMatrix<double,8,8> A;
+  Dune::FieldVector<double,8> x, b, reference;
+  randomMatrix(A, 8);
+  for (int i=0; i<8; ++i)
+    b[i] = i - 3.5;
+  A.solve(reference, b);
+
+  Dune::MixedPrecisionSolver<double> solver;
+  int iterations = solver.solve(A, x, b);
+  if (solver.usedFallback() || iterations != solver.iterations() || iterations > 5) {
+    std::cerr << "Refinement took " << iterations << " iterations for a well conditioned matrix" << std::endl;
+    ++ret;
+  }
+  if (difference(x, reference) > 1e-14) {
+    std::cerr << "Refined solution " << x << " differs from " << reference << std::endl;
+    ++ret;
+  }
+
+  const int n = 60;
+  Dune::DynamicMatrix<double> B(n, n);
+  Dune::DynamicVector<double> y(n), c(n), exact(n);
+  randomMatrix(B, n);
+  for (int i=0; i<n; ++i)
+    exact[i] = std::sin(double(i));
+  B.mv(exact, c);
+  solver.solve(B, y, c);
+  if (solver.usedFallback() || difference(y, exact) > 1e-13) {
+    std::cerr << "Refinement failed for a well conditioned " << n << "x" << n << " matrix" << std::endl;
+    ++ret;
+  }
+
+  return ret;
+}
+
+int testIllConditioned ()
+{
+  int ret = 0;
+
+  const int n = 10;
+  Dune::DynamicMatrix<double> A(n, n);
+  Dune::DynamicVector<double> x(n), b(n), reference(n);
+  hilbertMatrix(A, n);
+  for (int i=0; i<n; ++i)
+    b[i] = 1.0;
+  A.solve(reference, b);
+
+  // float cannot resolve a condition number of 1e13
+  Dune::MixedPrecisionSolver<double> solver;
+  solver.solve(A, x, b);
+  if (!solver.usedFallback()) {
+    std::cerr << "No fallback for the Hilbert matrix" << std::endl;
+    ++ret;
+  }
+  if (difference(x, reference) > 1e-2) {
+    std::cerr << "Fallback solution differs from the direct solution" << std::endl;
+    ++ret;
+  }
+
+  // entries too large for float
+  Dune::FieldMatrix<double,4,4> B;
+  Dune::FieldVector<double,4> y, c, exact;
+  randomMatrix(B, 4);
+  B *= 1e40;
+  exact = 1.0;
+  B.mv(exact, c);
+  solver.solve(B, y, c);
+  if (!solver.usedFallback() || difference(y, exact) > 1e-14) {
+    std::cerr << "Solution for entries beyond the range of float is wrong" << std::endl;
+    ++ret;
+  }
+
+  // singular matrix
+  B = 1.0;
+  try {
+    solver.solve(B, y, c);
+    std::cerr << "Singular matrix not detected" << std::endl;
+    ++ret;
+  } catch (Dune::FMatrixError&) {}
+
+  return ret;
+}
+
+#if HAVE_GMP
+int testHighPrecisionResidual ()
+{
+  int ret = 0;
+  typedef Dune::GMPField<256> R;
+
+  // the Hilbert matrix scaled by lcm(1,...,19) has integer entries, so
+  // A and b = A * solution are stored exactly
+  const int n = 10;
+  Dune::DynamicMatrix<double> A(n, n);
+  Dune::DynamicVector<double> x(n), b(n), solution(n);
+  hilbertMatrix(A, n);
+  A *= 232792560.0;
+  for (int i=0; i<n; ++i)
+    solution[i] = (i % 2 == 0) ? i + 1.0 : -(i + 1.0);
+  A.mv(solution, b);
+
+  // a single solve in double loses most digits to the condition number
+  A.solve(x, b);
+  const double directError = difference(x, solution);
+
+  // with the residual in high precision the solution is accurate up to
+  // the precision of double, even though the matrix is ill-conditioned
+  Dune::MixedPrecisionSolver<double, double, R> solver;
+  solver.solve(A, x, b);
+  const double refinedError = difference(x, solution);
+  if (solver.usedFallback() || refinedError > 1e-14 || !(refinedError < directError)) {
+    std::cerr << "High precision residual did not improve the solution: error "
+              << refinedError << " vs. " << directError << std::endl;
+    ++ret;
+  }
+
+  // float factorization with high precision residual
+  Dune::MixedPrecisionSolver<double, float, R> mixed;
+  Dune::FieldMatrix<double,5,5> B;
+  Dune::FieldVector<double,5> y, c, exact;
+  randomMatrix(B, 5);
+  exact = 2.0;
+  B.mv(exact, c);
+  mixed.solve(B, y, c);
+  if (mixed.usedFallback() || difference(y, exact) > 1e-14) {
+    std::cerr << "Float factorization with high precision residual failed" << std::endl;
+    ++ret;
+  }
+
+  return ret;
+}
+#endif
+
+int main ()
+{
+  int ret = 0;
+  ret += testWellConditioned();
+  ret += testIllConditioned();
+#if HAVE_GMP
+  ret += testHighPrecisionResidual();
+#endif
+  return ret;
+}
@@ -0,0 +1,170 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// The padded vectors and matrices have to give the same results as
+// FieldVector and FieldMatrix, keep their padding zero and be aligned,
+// also in containers using AlignedMallocAllocator.
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/mallocallocator.hh>
+#include <dune/common/paddedfmatrix.hh>
+#include <dune/common/paddedfvector.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed for size " << n         \
+                << " at " << __FILE__ << ":" << __LINE__ << std::endl;  \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+double randomEntry ()
+{
+  return double(std::rand()) / RAND_MAX - 0.5;
+}
+
+template<class V>
+bool aligned (const V& v)
+{
+  return reinterpret_cast<std::size_t>(&v[0]) % V::alignment == 0;
+}
+
+template<class K, int n>
+bool paddingIsZero (const Dune::PaddedFieldVector<K,n>& v)
+{
+  for (int i=n; i<Dune::PaddedFieldVector<K,n>::paddedSize; ++i)
+    if (v.data()[i] != K(0))
+      return false;
+  return true;
+}
+
+template<class K, int n>
+bool equal (const Dune::PaddedFieldVector<K,n>& x, const Dune::FieldVector<K,n>& y)
+{
+  for (int i=0; i<n; ++i)
+    if (x[i] != y[i])
+      return false;
+  return true;
+}
+
+template<class K, int n>
+int testVector ()
+{
+  int ret = 0;
+  typedef Dune::PaddedFieldVector<K,n> PV;
+  typedef Dune::FieldVector<K,n> FV;
+
+  CHECK(int(PV::paddedSize) % int(Dune::PaddedLength<K,1>::lanes) == 0);
+  CHECK(PV::paddedSize >= n);
+  CHECK(sizeof(PV) == PV::paddedSize * sizeof(K));
+  CHECK(std::size_t(Dune::AlignmentOf<PV>::value) == std::size_t(DUNE_SIMD_ALIGNMENT));
+
+  PV x, y;
+  FV fx, fy;
+  for (int i=0; i<n; ++i) {
+    fx[i] = x[i] = K(randomEntry());
+    fy[i] = y[i] = K(randomEntry());
+  }
+  CHECK(paddingIsZero(x));
+  CHECK(aligned(x));
+
+  x += y;  fx += fy;
+  CHECK(equal(x, fx));
+  x -= y;  fx -= fy;
+  CHECK(equal(x, fx));
+  x *= K(3); fx *= K(3);
+  CHECK(equal(x, fx));
+  x /= K(2); fx /= K(2);
+  CHECK(equal(x, fx));
+  x.axpy(K(0.5), y); fx.axpy(K(0.5), fy);
+  CHECK(equal(x, fx));
+  CHECK(paddingIsZero(x));
+
+  CHECK(x * y == fx * fy);
+  CHECK(x.two_norm() == fx.two_norm());
+  CHECK(x.one_norm() == fx.one_norm());
+  CHECK(x.infinity_norm() == fx.infinity_norm());
+
+  // conversion in both directions, mixed operations
+  PV z(fx);
+  FV fz(x);
+  CHECK(equal(z, fz));
+  CHECK(paddingIsZero(z));
+  z += fy;
+  fz += fy;
+  CHECK(equal(z, fz));
+
+  // containers with the aligned allocator
+  std::vector<PV, Dune::AlignedMallocAllocator<PV> > many(7, x);
+  for (std::size_t k=0; k<many.size(); ++k)
+    CHECK(aligned(many[k]) && equal(many[k], fx) && paddingIsZero(many[k]));
+
+  return ret;
+}
+
+template<int n>
+int testMatrix ()
+{
+  int ret = 0;
+  Dune::PaddedFieldMatrix<double,n,n> A;
+  Dune::FieldMatrix<double,n,n> fA;
+  for (int i=0; i<n; ++i) {
+    for (int j=0; j<n; ++j)
+      fA[i][j] = A[i][j] = randomEntry();
+    fA[i][i] = A[i][i] += n;
+    CHECK(aligned(A[i]) && paddingIsZero(A[i]));
+  }
+
+  Dune::PaddedFieldVector<double,n> x, y;
+  Dune::FieldVector<double,n> fx, fy;
+  for (int i=0; i<n; ++i)
+    fx[i] = x[i] = randomEntry();
+  A.mv(x, y);
+  fA.mv(fx, fy);
+  CHECK(equal(y, fy));
+  A.umtv(x, y);
+  fA.umtv(fx, fy);
+  CHECK(equal(y, fy));
+  A.usmv(0.5, x, y);
+  fA.usmv(0.5, fx, fy);
+  CHECK(equal(y, fy));
+  CHECK(A.determinant() == fA.determinant());
+
+  A.invert();
+  fA.invert();
+  for (int i=0; i<n; ++i) {
+    CHECK(equal(A[i], fA[i]));
+    CHECK(paddingIsZero(A[i]));
+  }
+
+  Dune::PaddedFieldMatrix<double,n,n> B(fA);
+  CHECK(B.frobenius_norm() == fA.frobenius_norm());
+
+  return ret;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  ret += testVector<double,1>();
+  ret += testVector<double,3>();
+  ret += testVector<double,4>();
+  ret += testVector<double,5>();
+  ret += testVector<float,3>();
+  ret += testVector<float,9>();
+
+  ret += testMatrix<2>();
+  ret += testMatrix<3>();
+  ret += testMatrix<4>();
+  ret += testMatrix<7>();
+
+  return ret;
+}
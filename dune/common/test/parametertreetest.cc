@@ -2,8 +2,16 @@
 #include "config.h"
 #endif
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <dune/common/parametertree.hh>
 #include <dune/common/parametertreeparser.hh>
 
@@ -100,6 +108,304 @@ void testmodify(P parameterSet)
         DUNE_THROW(Dune::Exception, "Failed to write subtree entry");
 }
 
+void testhandle(Dune::ParameterTree& parameterSet)
+{
+    parameterSet["Solver.tol"] = "1e-8";
+    parameterSet["Solver.maxit"] = "100";
+    parameterSet.sub("Solver")["verbose"] = "yes";
+
+    Dune::ParameterTree::Handle<double> tol =
+        parameterSet.handle<double>("Solver.tol");
+    Dune::ParameterTree::Handle<int> maxit =
+        parameterSet.sub("Solver").handle<int>("maxit");
+    Dune::ParameterTree::Handle<bool> verbose =
+        parameterSet.handle<bool>("Solver.verbose");
+    if (*tol != 1e-8 || *maxit != 100 || !*verbose)
+        DUNE_THROW(Dune::Exception, "Handles return wrong values");
+    if (tol.key() != "Solver.tol")
+        DUNE_THROW(Dune::Exception, "Handle returns wrong key");
+
+    // modifications through the tree and its subtrees are seen
+    parameterSet["Solver.tol"] = "1e-10";
+    parameterSet.sub("Solver")["maxit"] = "200";
+    if (*tol != 1e-10 || *maxit != 200)
+        DUNE_THROW(Dune::Exception, "Handles do not see modifications");
+
+    // keys added through sub() are found
+    if (parameterSet.get<std::string>("Solver.verbose") != "yes"
+        || !parameterSet.hasKey("Solver.verbose"))
+        DUNE_THROW(Dune::Exception, "Failed to find key added to subtree");
+
+    // assigning to a subtree must not leave stale entries in the index
+    Dune::ParameterTree other;
+    other["tol"] = "0.5";
+    parameterSet.sub("Solver") = other;
+    if (parameterSet.get<double>("Solver.tol") != 0.5
+        || parameterSet.hasKey("Solver.maxit"))
+        DUNE_THROW(Dune::Exception, "Stale index after assignment");
+    parameterSet["Solver.tol"] = "0.25";
+    if (parameterSet.sub("Solver").get<double>("tol") != 0.25)
+        DUNE_THROW(Dune::Exception, "Stale index after assignment");
+
+    try {
+        parameterSet.handle<int>("Solver.missing");
+        DUNE_THROW(Dune::Exception, "failed to detect missing key");
+    }
+    catch (Dune::RangeError & r) {}
+    try {
+        parameterSet.handle<int>("Foo.peng");
+        DUNE_THROW(Dune::Exception, "failed to detect unparsable value");
+    }
+    catch (Dune::RangeError & r) {}
+
+    // reading through the non-const operator[] does not parse again,
+    // writing through a reference kept from it is seen
+    parameterSet["Solver.list"] = "1 2 3";
+    Dune::ParameterTree::Handle<std::vector<int> > list =
+        parameterSet.handle<std::vector<int> >("Solver.list");
+    const int* parsed = &(*list)[0];
+    std::string& text = parameterSet["Solver.list"];
+    if (text != "1 2 3" || &(*list)[0] != parsed)
+        DUNE_THROW(Dune::Exception, "Handle parsed again after a read");
+    text = "4 5";
+    if (list->size() != 2 || (*list)[0] != 4)
+        DUNE_THROW(Dune::Exception, "Handle does not see modifications");
+
+    // assigning to a subtree of a copy leaves the original alone
+    Dune::ParameterTree copy(parameterSet);
+    copy.sub("Solver") = other;
+    if (copy.hasKey("Solver.list") || copy.get<double>("Solver.tol") != 0.5
+        || parameterSet.get<std::string>("Solver.list") != "4 5")
+        DUNE_THROW(Dune::Exception, "Stale index after assignment to a copy");
+
+    // a tree can be assigned one of its own subtrees
+    copy["Solver.deep.key"] = "deep";
+    copy = copy.sub("Solver");
+    if (copy.get<std::string>("deep.key") != "deep" || copy.hasSub("Solver"))
+        DUNE_THROW(Dune::Exception, "Failed to assign a subtree to its parent");
+    copy["deep.key"] = "deeper";
+    if (copy.sub("deep").get<std::string>("key") != "deeper")
+        DUNE_THROW(Dune::Exception, "Stale index after assignment of a subtree");
+
+    // an invalid value is reported when the handle is dereferenced
+    Dune::ParameterTree::Handle<double> x1 = parameterSet.handle<double>("x1");
+    parameterSet["x1"] = "one";
+    try {
+        *x1;
+        DUNE_THROW(Dune::Exception, "failed to detect unparsable value");
+    }
+    catch (Dune::RangeError & r) {}
+    parameterSet["x1"] = "1";
+}
+
+void testserialize(const Dune::ParameterTree& parameterSet)
+{
+    std::ostringstream out;
+    parameterSet.serialize(out);
+
+    // the copy reports the same entries in the same order
+    Dune::ParameterTree copy;
+    std::istringstream in(out.str());
+    copy.deserialize(in);
+    std::ostringstream original, copied;
+    parameterSet.report(original);
+    copy.report(copied);
+    if (original.str() != copied.str()
+        || copy.getValueKeys() != parameterSet.getValueKeys()
+        || copy.getSubKeys() != parameterSet.getSubKeys())
+        DUNE_THROW(Dune::Exception, "Deserialized tree differs");
+
+    // existing values are kept without overwrite
+    Dune::ParameterTree merged;
+    merged["x1"] = "keep";
+    merged["Foo.new"] = "new";
+    std::istringstream in2(out.str());
+    merged.deserialize(in2, false);
+    if (merged["x1"] != "keep" || merged["Foo.new"] != "new"
+        || merged["Foo.peng"] != "ligapokal")
+        DUNE_THROW(Dune::Exception, "Failed to merge deserialized tree");
+
+    // truncated data is detected
+    try {
+        std::istringstream truncated(out.str().substr(0, out.str().size() / 2));
+        Dune::ParameterTree broken;
+        broken.deserialize(truncated);
+        DUNE_THROW(Dune::Exception, "failed to detect truncated data");
+    }
+    catch (Dune::IOError & e) {}
+    try {
+        std::istringstream garbage("x1 = 1\n");
+        Dune::ParameterTree broken;
+        broken.deserialize(garbage);
+        DUNE_THROW(Dune::Exception, "failed to detect wrong format");
+    }
+    catch (Dune::IOError & e) {}
+}
+
+void testparser()
+{
+    std::stringstream s;
+    s << "a = \"multi\n  line\"  \r\n"
+      << "b = 'single' \r\n"
+      << "  [ Sec.Sub ]  \n"
+      << "c = x # y = z\n"
+      << "#d = 1\n"
+      << "e =\n"
+      << "[]\n"
+      << "f = \"unterminated";
+    Dune::ParameterTree c;
+    c["b"] = "kept";
+    Dune::ParameterTreeParser::readINITree(s, c, false);
+    if (c["a"] != "multi\n  line" || c["b"] != "kept"
+        || c["Sec.Sub.c"] != "x" || c.hasKey("Sec.Sub.d")
+        || c["Sec.Sub.e"] != "" || c["f"] != "unterminated")
+        DUNE_THROW(Dune::Exception, "Failed to parse stream");
+
+    // keys must not appear twice, even if they are not overwritten
+    const char* duplicates[] = { "a = 1\n[s]\nb = 2\n[]\na = 3\n",
+                                 "b = 1\nb = 2\n" };
+    for (int i = 0; i < 2; ++i)
+        try {
+            std::stringstream d(duplicates[i]);
+            Dune::ParameterTree t;
+            t["b"] = "0";
+            Dune::ParameterTreeParser::readINITree(d, t, i == 0);
+            DUNE_THROW(Dune::Exception, "failed to detect duplicate key");
+        }
+        catch (Dune::RangeError & e) { throw; }
+        catch (Dune::Exception & e) {
+            if (e.what().find("appears twice") == std::string::npos)
+                throw;
+        }
+}
+
+// communicators playing rank 0, which records its broadcasts, and
+// rank 1, which receives them
+struct RecordingComm {};
+struct ReplayingComm {};
+
+std::vector<std::string> broadcasts;
+
+namespace Dune {
+
+    template<>
+    class CollectiveCommunication<RecordingComm>
+    {
+    public:
+        int rank() const { return 0; }
+        int size() const { return 2; }
+
+        template<typename T>
+        int broadcast(T* inout, int len, int) const
+        {
+            broadcasts.push_back(std::string(reinterpret_cast<const char*>(inout), len * sizeof(T)));
+            return 0;
+        }
+    };
+
+    template<>
+    class CollectiveCommunication<ReplayingComm>
+    {
+    public:
+        int rank() const { return 1; }
+        int size() const { return 2; }
+
+        template<typename T>
+        int broadcast(T* inout, int len, int) const
+        {
+            if (broadcasts.empty() || broadcasts.front().size() != len * sizeof(T))
+                DUNE_THROW(Dune::Exception, "Broadcasts of rank 0 and 1 do not match");
+            std::copy(broadcasts.front().begin(), broadcasts.front().end(),
+                      reinterpret_cast<char*>(inout));
+            broadcasts.erase(broadcasts.begin());
+            return 0;
+        }
+    };
+
+} // end namespace Dune
+
+// an error on rank 0 is rethrown there and sent to the other ranks
+template<class E>
+void testcollectiveerror(const char* file)
+{
+    std::string message;
+    Dune::ParameterTree c;
+    broadcasts.clear();
+    try {
+        Dune::CollectiveCommunication<RecordingComm> root;
+        Dune::ParameterTreeParser::readINITree(file, c, root);
+        DUNE_THROW(Dune::Exception, "failed to detect error on rank 0");
+    }
+    catch (E & e) {
+        message = e.what();
+    }
+    try {
+        Dune::CollectiveCommunication<ReplayingComm> other;
+        Dune::ParameterTreeParser::readINITree(file, c, other);
+        DUNE_THROW(Dune::Exception, "failed to detect error on rank 1");
+    }
+    catch (E & e) {
+        if (e.what() != message || not broadcasts.empty())
+            DUNE_THROW(Dune::Exception, "rank 1 did not receive the error of rank 0");
+    }
+}
+
+void testcollective()
+{
+    const char* file = "parametertreetest.ini";
+    {
+        std::ofstream out(file);
+        out << "a = 1\n[Foo]\nbar = \"quoted\nvalue\"\n";
+    }
+    Dune::CollectiveCommunication<Dune::No_Comm> comm;
+    Dune::ParameterTree c;
+    c["a"] = "0";
+    Dune::ParameterTreeParser::readINITree(file, c, comm, false);
+    if (c["a"] != "0" || c["Foo.bar"] != "quoted\nvalue")
+        DUNE_THROW(Dune::Exception, "Collective reading failed");
+    std::remove(file);
+
+    try {
+        Dune::ParameterTreeParser::readINITree(file, c, comm);
+        DUNE_THROW(Dune::Exception, "failed to detect missing file");
+    }
+    catch (Dune::IOError & e) {}
+    testcollectiveerror<Dune::IOError>(file);
+
+    {
+        std::ofstream out(file);
+        out << "a = 1\na = 2\n";
+    }
+    testcollectiveerror<Dune::Exception>(file);
+    std::remove(file);
+}
+
+// a FIFO cannot seek, its size is unknown before reading it
+void testfifo()
+{
+    const char* file = "parametertreetest.fifo";
+    std::remove(file);
+    if (mkfifo(file, 0600) != 0)
+        DUNE_THROW(Dune::IOError, "Could not create FIFO " << file);
+    pid_t writer = fork();
+    if (writer < 0)
+        DUNE_THROW(Dune::IOError, "Could not fork the writer of " << file);
+    if (writer == 0)
+    {
+        {
+            std::ofstream out(file);
+            out << "a = 1\n[Foo]\nbar = 2\n";
+        }
+        _exit(0);
+    }
+    Dune::ParameterTree c;
+    Dune::ParameterTreeParser::readINITree(file, c);
+    waitpid(writer, 0, 0);
+    std::remove(file);
+    if (c["a"] != "1" || c["Foo.bar"] != "2")
+        DUNE_THROW(Dune::Exception, "Reading from a FIFO failed");
+}
+
 int main()
 {
     try {
@@ -124,8 +430,18 @@ int main()
         }
         catch (Dune::RangeError & r) {}
 
+        // typed handles
+        testhandle(c);
+
         // more const tests
         testparam<Dune::ParameterTree>(c);
+
+        testparser();
+
+        // serialization and collective reading
+        testserialize(c);
+        testcollective();
+        testfifo();
     }
     catch (Dune::Exception & e)
     {
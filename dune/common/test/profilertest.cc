@@ -0,0 +1,109 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#define DUNE_PROFILING 1
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if HAVE_STD_THREAD
+#include <thread>
+#endif
+
+#include <dune/common/profiler.hh>
+#include <dune/common/timer.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed at "                    \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+void busyWait (double seconds)
+{
+  Dune::WallTimer wall;
+  while (wall.elapsed() < seconds) ;
+}
+
+void kernel ()
+{
+  DUNE_PROFILE_SCOPE("kernel");
+  busyWait(0.002);
+}
+
+void assemble ()
+{
+  DUNE_PROFILE_SCOPE("assemble");
+  for (int i=0; i<5; ++i) {
+    DUNE_PROFILE_SCOPE("local");
+    kernel();
+  }
+  busyWait(0.002);
+}
+
+const Dune::Profiler::Summary* find (const std::vector<Dune::Profiler::Summary>& summaries,
+                                     const std::string& path)
+{
+  for (std::size_t i=0; i<summaries.size(); ++i)
+    if (summaries[i].path == path)
+      return &summaries[i];
+  return 0;
+}
+
+int main ()
+{
+  int ret = 0;
+  const std::string sep(1, Dune::Profiler::separator);
+
+  assemble();
+  kernel();
+  CHECK(Dune::Profiler::local().depth() == 0);
+
+  std::vector<Dune::Profiler::Summary> s = Dune::Profiler::summarize();
+  CHECK(s.size() == 4);
+  const Dune::Profiler::Summary* a = find(s, "assemble");
+  const Dune::Profiler::Summary* l = find(s, "assemble" + sep + "local");
+  const Dune::Profiler::Summary* k = find(s, "assemble" + sep + "local" + sep + "kernel");
+  const Dune::Profiler::Summary* top = find(s, "kernel");
+  CHECK(a && l && k && top);
+  if (a && l && k && top) {
+    CHECK(a->count == 1 && l->count == 5 && k->count == 5 && top->count == 1);
+    CHECK(a->depth == 0 && l->depth == 1 && k->depth == 2 && top->depth == 0);
+    CHECK(a->inclusive >= l->inclusive && l->inclusive >= k->inclusive);
+    CHECK(k->inclusive >= 0.01);
+    // assemble itself waits for 2 ms
+    CHECK(a->exclusive >= 0.002 && a->exclusive < a->inclusive);
+    CHECK(a->threads == 1);
+  }
+
+#if HAVE_STD_THREAD
+  // the regions of every thread form their own tree
+  std::thread t1(assemble), t2(assemble);
+  t1.join();
+  t2.join();
+  s = Dune::Profiler::summarize();
+  a = find(s, "assemble");
+  k = find(s, "assemble" + sep + "local" + sep + "kernel");
+  CHECK(a && a->count == 3 && a->threads == 3);
+  CHECK(k && k->count == 15);
+#endif
+
+  // the report names every region once, indented by its depth
+  std::ostringstream out;
+  Dune::Profiler::report(out);
+  std::cout << out.str();
+  CHECK(out.str().find("assemble") != std::string::npos);
+  CHECK(out.str().find("\n    kernel") != std::string::npos);
+  CHECK(out.str().find("\nkernel") != std::string::npos);
+
+  Dune::Profiler::reset();
+  CHECK(Dune::Profiler::summarize().empty());
+
+  return ret;
+}
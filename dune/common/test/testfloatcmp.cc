@@ -4,9 +4,14 @@
 #include "config.h"
 #endif
 
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
+#include <dune/common/dynvector.hh>
 #include <dune/common/float_cmp.hh>
+#include <dune/common/fvector.hh>
 
 using std::cout;
 using std::endl;
@@ -128,6 +133,57 @@ void tests(F f1, F f2, const typename Dune::FloatCmpOps<F> &ops, bool inside)
   cout << endl;
 }
 
+// entrywise comparison of ranges, checked against the scalar comparisons
+template<Dune::FloatCmp::CmpStyle style>
+void rangeTests(double eps)
+{
+  const std::size_t n = 5000;
+  std::vector<double> a(n), b(n);
+  for(std::size_t i = 0; i < n; ++i) {
+    a[i] = b[i] = std::sin(double(i)) * std::pow(10.0, double(i % 7) - 3);
+    if(i % 3 == 0)
+      b[i] += 0.1 * eps * std::abs(a[i]);
+  }
+  b[1500] = a[1500] * (1 + 100*eps) + 10*eps;
+  b[3333] = a[3333] + 1;
+  b[4000] = std::numeric_limits<double>::quiet_NaN();
+
+  std::size_t mismatches = 0, first = n, maxIndex = 0;
+  double maxDeviation = 0;
+  for(std::size_t i = 0; i < n; ++i) {
+    if(!Dune::FloatCmp::eq<double, style>(a[i], b[i], eps)) {
+      ++mismatches;
+      if(first == n) first = i;
+    }
+    if(std::abs(a[i] - b[i]) > maxDeviation) {
+      maxDeviation = std::abs(a[i] - b[i]);
+      maxIndex = i;
+    }
+  }
+
+  cout << "compare(std::vector), style " << style << ": " << flush;
+  Dune::FloatCmp::RangeCmpResult<double> r = Dune::FloatCmp::compare<style>(a, b, eps);
+  count(r.size == n && r.mismatches == mismatches && r.firstMismatch == first
+        && r.maxDeviation == maxDeviation && r.maxDeviationIndex == maxIndex && !r.equal());
+  cout << endl;
+
+  cout << "compareRanges(double*), style " << style << ": " << flush;
+  r = Dune::FloatCmp::compareRanges<style>(&a[0], &a[0] + n, &b[0], eps);
+  count(r.mismatches == mismatches && r.firstMismatch == first && r.maxDeviationIndex == maxIndex);
+  cout << endl;
+
+  cout << "compare(DynamicVector), style " << style << ": " << flush;
+  Dune::DynamicVector<double> x(n), y(n);
+  for(std::size_t i = 0; i < n; ++i) { x[i] = a[i]; y[i] = b[i]; }
+  Dune::FloatCmpOps<double, style> ops(eps);
+  r = ops.compare(x, y);
+  bool pass = r.mismatches == mismatches && r.firstMismatch == first;
+  r = ops.compareRanges(x.begin(), x.end(), x.begin());
+  pass = pass && r.equal() && r.firstMismatch == n && r.maxDeviation == 0;
+  count(pass);
+  cout << endl;
+}
+
 int main() {
   cout.setf(std::ios_base::scientific, std::ios_base::floatfield);
   cout.precision(16);
@@ -149,6 +205,28 @@ int main() {
   tests<double>(0, 0, 1e-7, true);
   tests<double>(0, 0, ops,  true);
 
+  cout << "Tests comparing ranges" << endl;
+  rangeTests<Dune::FloatCmp::relativeWeak>(1e-8);
+  rangeTests<Dune::FloatCmp::relativeStrong>(1e-8);
+  rangeTests<Dune::FloatCmp::absolute>(1e-8);
+
+  cout << "compare with different sizes: " << flush;
+  {
+    std::vector<double> a(10, 1.0), b(12, 1.0);
+    Dune::FloatCmp::RangeCmpResult<double> r = Dune::FloatCmp::compare(a, b);
+    count(r.size == 12 && r.mismatches == 2 && r.firstMismatch == 10);
+  }
+  cout << endl;
+
+  cout << "eq for std::vector and FieldVector: " << flush;
+  {
+    std::vector<double> a(3, 1.0), b(3, 1.0 + 1e-12);
+    Dune::FieldVector<double, 3> x(1.0), y(1.0 + 1e-12);
+    count(Dune::FloatCmp::eq(a, b, 1e-10) && !Dune::FloatCmp::eq(a, b, 1e-14)
+          && Dune::FloatCmp::eq(x, y, 1e-10) && Dune::FloatCmp::ne(x, y, 1e-14));
+  }
+  cout << endl;
+
   int total = passed + failed;
   cout << passed << "/" << total << " tests passed; " << failed << "/" << total << " tests failed" << endl;
   if(failed > 0) return 1;
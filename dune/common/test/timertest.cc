@@ -0,0 +1,98 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// Sleeping counts as wall time but not as CPU time, busy waiting
+// counts as both. How much CPU time a thread gets per wall time depends
+// on the load of the machine, so only bounds that hold under any load
+// are checked.
+
+#include <ctime>
+#include <iostream>
+
+#include <dune/common/timer.hh>
+
+#define CHECK(condition)                                                \
+  do {                                                                  \
+    if (!(condition)) {                                                 \
+      std::cerr << "Check " #condition " failed at "                    \
+                << __FILE__ << ":" << __LINE__ << std::endl;            \
+      ++ret;                                                            \
+    }                                                                   \
+  } while (0)
+
+void sleep (double seconds)
+{
+  struct timespec t;
+  t.tv_sec = 0;
+  t.tv_nsec = long(seconds * 1e9);
+  nanosleep(&t, 0);
+}
+
+double busyWait (double seconds)
+{
+  Dune::WallTimer wall;
+  double x = 0;
+  while (wall.elapsed() < seconds)
+    x += 1e-9;
+  return x;
+}
+
+// the interface of Timer for every clock
+template<class T>
+int testInterface ()
+{
+  int ret = 0;
+  T timer(false);
+  CHECK(timer.elapsed() == 0.0);
+  timer.start();
+  busyWait(0.01);
+  double first = timer.stop();
+  CHECK(first > 0.0);
+  CHECK(timer.elapsed() == first && timer.lastElapsed() == first);
+  busyWait(0.01);
+  CHECK(timer.elapsed() == first);
+  timer.start();
+  busyWait(0.01);
+  double second = timer.stop();
+  CHECK(second > first);
+  CHECK(timer.lastElapsed() < second);
+  timer.reset();
+  CHECK(timer.elapsed() == 0.0);
+  return ret;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  ret += testInterface<Dune::Timer>();
+  ret += testInterface<Dune::WallTimer>();
+  ret += testInterface<Dune::ThreadCPUTimer>();
+  ret += testInterface<Dune::CycleTimer>();
+
+  // sleeping
+  Dune::WallTimer wall;
+  Dune::ThreadCPUTimer cpu;
+  Dune::CycleTimer cycles;
+  sleep(0.05);
+  double w = wall.stop(), c = cpu.stop(), t = cycles.stop();
+  CHECK(w >= 0.049);
+  CHECK(c >= 0.0 && c <= 1.01 * w);
+  CHECK(t > 0.0);
+
+  // busy waiting
+  wall.reset(); wall.start();
+  cpu.reset(); cpu.start();
+  busyWait(0.05);
+  w = wall.stop();
+  c = cpu.stop();
+  CHECK(w >= 0.05);
+  CHECK(c > 0.0 && c <= 1.01 * w);
+
+  // resolution: two readings in a row differ by much less than a microsecond
+  Dune::WallTimer fine;
+  CHECK(fine.elapsed() < 1e-4);
+
+  return ret;
+}
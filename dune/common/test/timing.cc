@@ -2,137 +2,86 @@
 #include "config.h"
 #endif
 
+// Compares the eager DenseVector operators with the fused evaluation of
+// lazy expressions from densevectorexpression.hh.
+//
+// usage: timing [number of entries]
+
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
+#include <vector>
+
+#include <dune/common/dynvector.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/timer.hh>
-#include <dune/istl/bvector.hh>
-#include <dune/common/iteratorfacades.hh>
 
-template<int bs, int sz>
-void timing_vector()
+// z = a + b - 2 c, with the eager operators and as a single expression
+template<class V>
+bool timing_vector(const char* name, std::vector<V>& a, std::vector<V>& b,
+                   std::vector<V>& c, int repetitions)
 {
-  std::cout << "timing_vector<" << bs << ", " << sz << ">\n";
-  typedef Dune::FieldVector<double,bs> VB;
-  typedef Dune::BlockVector<VB> BV;
-  typedef Dune::BlockVector<BV> BBV;
-  BV bv1(sz), bv2(sz);
-  BV bv3(sz), bv4(sz);
-  bv1 = 1;
-  bv2 = 0;
-  bv2[1][0]=1;
-  bv2[1][1]=2;
-
-  bv3 = 0;
-  bv4 = 0;
-
-  BBV bbv(2);
-  bbv[0].resize(bv1.N());
-  bbv[1].resize(bv2.N());
+  std::vector<V> eager(a), fused(a);
+  Dune::Timer stopwatch;
 
-  BBV bbv2(2);
-#warning deep copy is broken!
-  /* bbv2 = bbv2; */
-  bbv2[0] = bv3;
-  bbv2[1] = bv4;
-//  bbv2 = 0;
+  stopwatch.reset();
+  for (int r=0; r<repetitions; r++)
+    for (std::size_t k=0; k<a.size(); k++)
+    {
+      V scaled(c[k]);
+      scaled *= 2.0;
+      eager[k] = a[k] + b[k] - scaled;
+    }
+  std::cout << "  " << name << " eager: " << stopwatch.elapsed() << " s";
 
-  Dune::Timer stopwatch;
   stopwatch.reset();
-  for (int i=0; i<10; i++)
-  {
-#ifdef DUNE_EXPRESSIONTEMPLATES
-#ifdef DUNE_FLATIT
-    for (int a=0; a<2; a++)
-      for (int b=0; b<sz; b++)
-        for (int c=0; c<bs; c++)
-          bbv2[a][b][c] += 2*bbv[a][b][c];
-#else
-    bbv2 += 2*bbv;
-#endif
-#else
-    bbv2.axpy(2,bbv);
-#endif
-  }
-  std::cout << "Time [bbv2.axpy(2,bbv)] " << stopwatch.elapsed() << std::endl;
+  for (int r=0; r<repetitions; r++)
+    for (std::size_t k=0; k<a.size(); k++)
+      fused[k] = Dune::lazy(a[k]) + b[k] - 2.0*Dune::lazy(c[k]);
+  std::cout << ", fused: " << stopwatch.elapsed() << " s" << std::endl;
+
+  return eager == fused;
 }
 
-#if 0
-//template<int BlockSize, int N, int M>
-template<int BN, int BM, int N, int M>
-void timing_matrix()
+template<class V>
+void fill(std::vector<V>& v)
 {
-  std::cout << "timing_matrix<" << BN << ", " << BM << ", "
-            << N << ", " << M << ">\n";
-
-  typedef double matvec_t;
-  typedef Dune::FieldVector<matvec_t,BN> LVB;
-  typedef Dune::FieldVector<matvec_t,BM> VB;
-  typedef Dune::FieldMatrix<matvec_t,BN,BM> MB;
-  typedef Dune::BlockVector<LVB> LeftVector;
-  typedef Dune::BlockVector<VB> Vector;
-  typedef Dune::BCRSMatrix<MB> Matrix;
-
-  Matrix A(N,M,Matrix::row_wise);
-  typename Matrix::CreateIterator i=A.createbegin();
-  typename Matrix::CreateIterator end=A.createend();
-  std::cout << "Building matrix structure\n";
-  // build up the matrix structure
-  int c=0;
-  for (; i!=end; ++i)
-  {
-    // insert a non zero entry for myself
-    i.insert(c);
-    // insert index M-1
-    i.insert(M-1);
-    c++;
-  }
-  std::cout << "...done\n";
+  for (std::size_t k=0; k<v.size(); k++)
+    for (std::size_t i=0; i<v[k].size(); i++)
+      v[k][i] = double(std::rand()) / RAND_MAX;
+}
 
-  LeftVector v(N);
-  v = 0;
-  Vector x(M);
-  x = 1;
-  
-  Dune::Timer stopwatch;
-  stopwatch.reset();
-#ifdef DUNE_EXPRESSIONTEMPLATES
-  v += A * x;
-#else
-  A.umv(x,v);
-#endif
-  std::cout << "Time [v+=A*x] " << stopwatch.elapsed() << std::endl;
+template<int bs>
+bool timing_fieldvector(std::size_t n)
+{
+  typedef Dune::FieldVector<double,bs> V;
+  std::vector<V> a(n / bs), b(n / bs), c(n / bs);
+  fill(a); fill(b); fill(c);
+  std::cout << "timing_vector<FieldVector<double," << bs << "> >\n";
+  return timing_vector("many small vectors:", a, b, c, 10);
+}
 
-  std::cout << std::endl;
+bool timing_dynamicvector(std::size_t n)
+{
+  typedef Dune::DynamicVector<double> V;
+  std::vector<V> a(1, V(n)), b(1, V(n)), c(1, V(n));
+  fill(a); fill(b); fill(c);
+  std::cout << "timing_vector<DynamicVector<double> >\n";
+  return timing_vector("one large vector:   ", a, b, c, 10);
 }
-#endif
 
-int main ()
+int main (int argc, char** argv)
 {
-#ifdef DUNE_EXPRESSIONTEMPLATES
-#ifdef DUNE_FLATIT
-  std::cout << "Handwritten loops\n";
-#else
-  std::cout << "Expression Templates\n";
-#endif
-#else
-  std::cout << "Template Meta Program\n";
-#endif
+  std::size_t n = 1000000;
+  if (argc > 1)
+    n = std::atol(argv[1]);
 
-  timing_vector<1,1000000>();
-  timing_vector<2,500000>();
-  timing_vector<10,100000>();
-  timing_vector<40,25000>();
-  timing_vector<100,10000>();
-  timing_vector<400,2500>();
+  bool ok = true;
+  ok = timing_fieldvector<2>(n) && ok;
+  ok = timing_fieldvector<3>(n) && ok;
+  ok = timing_fieldvector<10>(n) && ok;
+  ok = timing_dynamicvector(n) && ok;
 
-//   timing_matrix<150,150,500,4000>();
-//   timing_matrix<150,150,1000,2000>();
-//  timing_matrix<1,18,400000,500000>();
-//   timing_matrix<6,3,400000,500000>();
-//   timing_matrix<3,6,400000,500000>();
-//   timing_matrix<18,1,400000,500000>();
-//   timing_matrix<50,50,9000,10000>();
-  
-  std::cout << std::endl;
+  if (!ok)
+    std::cerr << "Eager and fused results differ!" << std::endl;
+  return ok ? 0 : 1;
 }
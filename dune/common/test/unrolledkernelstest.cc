@@ -0,0 +1,182 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+// The unrolled FieldVector and FieldMatrix kernels have to give exactly
+// the same results as the generic loops of DenseVector and DenseMatrix,
+// which are used by DynamicVector and DynamicMatrix.
+
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+template<class K>
+K random ()
+{
+  return K(double(std::rand()) / RAND_MAX - 0.5);
+}
+
+template<class K, int n>
+bool equal (const Dune::FieldVector<K,n>& x, const Dune::DynamicVector<K>& y)
+{
+  for (int i=0; i<n; ++i)
+    if (x[i] != y[i])
+      return false;
+  return true;
+}
+
+template<class K, int n, int m>
+bool equal (const Dune::FieldMatrix<K,n,m>& A, const Dune::DynamicMatrix<K>& B)
+{
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<m; ++j)
+      if (A[i][j] != B[i][j])
+        return false;
+  return true;
+}
+
+#define CHECK(condition)                                                      \
+  do {                                                                        \
+    if (!(condition)) {                                                       \
+      std::cerr << "Check " #condition " failed for " << n << "x" << m        \
+                << " matrix at " << __FILE__ << ":" << __LINE__ << std::endl; \
+      ++ret;                                                                  \
+    }                                                                         \
+  } while (0)
+
+template<class K, int n, int m>
+int testKernels ()
+{
+  int ret = 0;
+
+  Dune::FieldMatrix<K,n,m> A;
+  Dune::DynamicMatrix<K> dA(n, m);
+  Dune::FieldVector<K,m> x, u;
+  Dune::FieldVector<K,n> y, v;
+  Dune::DynamicVector<K> dx(m), du(m), dy(n), dv(n);
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<m; ++j)
+      dA[i][j] = A[i][j] = random<K>();
+  for (int j=0; j<m; ++j) {
+    dx[j] = x[j] = random<K>();
+    du[j] = u[j] = random<K>();
+  }
+  for (int i=0; i<n; ++i)
+    dy[i] = y[i] = random<K>();
+
+  // vector kernels
+  CHECK(x * u == dx * du);
+  CHECK(x.dot(u) == dx.dot(du));
+  CHECK(x * du == dx * du);
+  CHECK(x.one_norm() == dx.one_norm());
+  CHECK(x.one_norm_real() == dx.one_norm_real());
+  CHECK(x.two_norm() == dx.two_norm());
+  CHECK(x.two_norm2() == dx.two_norm2());
+  CHECK(x.infinity_norm() == dx.infinity_norm());
+  CHECK(x.infinity_norm_real() == dx.infinity_norm_real());
+
+  // matrix-vector products
+  A.mv(x, v);
+  dA.mv(dx, dv);
+  CHECK(equal(v, dv));
+  A.mtv(y, u);
+  dA.mtv(dy, du);
+  CHECK(equal(u, du));
+  A.umv(x, v);
+  dA.umv(dx, dv);
+  CHECK(equal(v, dv));
+  A.umtv(y, u);
+  dA.umtv(dy, du);
+  CHECK(equal(u, du));
+  A.mmv(u, y);
+  dA.mmv(du, dy);
+  CHECK(equal(y, dy));
+  A.usmv(K(0.5), x, v);
+  dA.usmv(K(0.5), dx, dv);
+  CHECK(equal(v, dv));
+  A.mv(x, v);
+  A.mv(dx, dv);
+  CHECK(equal(v, dv));
+
+  // matrix-matrix products
+  Dune::FieldMatrix<K,n,n> L;
+  Dune::FieldMatrix<K,m,m> R;
+  Dune::DynamicMatrix<K> dL(n, n), dR(m, m);
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<n; ++j)
+      dL[i][j] = L[i][j] = random<K>();
+  for (int i=0; i<m; ++i)
+    for (int j=0; j<m; ++j)
+      dR[i][j] = R[i][j] = random<K>();
+  A.leftmultiply(L);
+  dA.leftmultiply(dL);
+  CHECK(equal(A, dA));
+  A.rightmultiply(R);
+  dA.rightmultiply(dR);
+  CHECK(equal(A, dA));
+
+  // determinant and inverse, diagonally dominant to avoid pivoting
+  // everywhere but in the first row
+  L[0][0] = 0;
+  for (int i=1; i<n; ++i)
+    L[i][i] += K(n);
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<n; ++j)
+      dL[i][j] = L[i][j];
+  CHECK(L.determinant() == dL.determinant());
+  L.invert();
+  dL.invert();
+  CHECK(equal(L, dL));
+
+  return ret;
+}
+
+template<int n>
+int testSingular ()
+{
+  int ret = 0;
+  const int m = n;
+
+  Dune::FieldMatrix<double,n,n> A(1.0);
+  CHECK(A.determinant() == 0.0);
+  try {
+    A.invert();
+    CHECK(false);
+  } catch (Dune::FMatrixError&) {}
+
+  return ret;
+}
+
+int main ()
+{
+  int ret = 0;
+
+  ret += testKernels<double,1,1>();
+  ret += testKernels<double,2,2>();
+  ret += testKernels<double,3,3>();
+  ret += testKernels<double,4,4>();
+  ret += testKernels<double,5,5>();
+  ret += testKernels<double,6,6>();
+  ret += testKernels<double,7,7>();
+  ret += testKernels<double,8,8>();
+  ret += testKernels<double,9,9>();
+  ret += testKernels<double,2,3>();
+  ret += testKernels<double,3,2>();
+  ret += testKernels<double,8,4>();
+  ret += testKernels<double,4,9>();
+  ret += testKernels<float,3,3>();
+  ret += testKernels<float,6,6>();
+  ret += testKernels<std::complex<double>,3,3>();
+  ret += testKernels<std::complex<double>,4,4>();
+
+  ret += testSingular<3>();
+  ret += testSingular<4>();
+  ret += testSingular<8>();
+
+  return ret;
+}
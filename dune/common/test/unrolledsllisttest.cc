@@ -0,0 +1,231 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include<dune/common/unrolledsllist.hh>
+#include<dune/common/test/iteratortest.hh>
+#include<dune/common/poolallocator.hh>
+#include<cstdlib>
+#include<iostream>
+#include<list>
+
+typedef Dune::PoolAllocator<int,8*1024-16> IntAllocator;
+
+template<typename T, class A, int N>
+int check(const Dune::UnrolledSLList<T,A,N>& alist, const std::list<T>& reference)
+{
+  typedef typename Dune::UnrolledSLList<T,A,N>::const_iterator Iterator;
+  typedef typename std::list<T>::const_iterator RIterator;
+
+  if(alist.size()!=int(reference.size())){
+    std::cerr<<"Size "<<alist.size()<<" should be "<<reference.size()<<"! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    return 1;
+  }
+  RIterator riter=reference.begin();
+  for(Iterator iter=alist.begin(); iter != alist.end(); ++iter, ++riter)
+    if(riter==reference.end() || *iter != *riter){
+      std::cerr<<"List missmatch! "<<__FILE__<<":"<<__LINE__<<std::endl;
+      return 1;
+    }
+  return 0;
+}
+
+int testPushPop()
+{
+  typedef Dune::UnrolledSLList<int,IntAllocator,4> List;
+  List alist;
+  std::list<int> reference;
+  int ret=0;
+
+  if(alist.begin() != alist.end() || !alist.empty()){
+    std::cerr<<"For empty list begin and end iterator do not match! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ret++;
+  }
+
+  for(int i=0; i<10; ++i){
+    alist.push_back(i);
+    reference.push_back(i);
+    alist.push_front(-i);
+    reference.push_front(-i);
+  }
+  ret+=check(alist, reference);
+
+  for(int i=0; i<7; ++i){
+    alist.pop_front();
+    reference.pop_front();
+  }
+  ret+=check(alist, reference);
+
+  while(!alist.empty())
+    alist.pop_front();
+  if(alist.size()!=0 || alist.begin()!=alist.end()){
+    std::cerr<<"Emptied list not empty! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ret++;
+  }
+
+  // the list has to be usable again after being emptied
+  alist.push_back(42);
+  if(*alist.begin()!=42){
+    std::cerr<<"Push back after emptying failed! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ret++;
+  }
+  return ret;
+}
+
+int testInsert()
+{
+  typedef Dune::UnrolledSLList<int,std::allocator<int>,4> List;
+  List alist;
+  int ret=0;
+
+  alist.push_back(3);
+  List::ModifyIterator iter=alist.beginModify();
+  iter.insert(7);
+
+  if(*iter!=3){
+    std::cerr<<"Value at current position changed due to insert! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ret++;
+  }
+  if(*alist.begin()!=7){
+    std::cerr<<"Insert did not change first element! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ret++;
+  }
+
+  iter = alist.endModify();
+  if(iter!=alist.end()){
+    std::cerr <<" Iterator got by endModify does not equal that got by end()! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+  iter.insert(20);
+  if(iter != alist.end()){
+    std::cerr<<"Insertion changed end iterator! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+
+  // Insert in front of every entry to force splitting of nodes,
+  // as done when merging sorted remote index lists.
+  alist.clear();
+  std::list<int> reference;
+  for(int i=0; i<40; i+=2){
+    alist.push_back(i);
+    reference.push_back(i);
+  }
+  iter=alist.beginModify();
+  std::list<int>::iterator riter=reference.begin();
+  for(int i=-1; i<40; i+=2){
+    while(iter!=alist.end() && *iter<i){
+      ++iter;
+      ++riter;
+    }
+    iter.insert(i);
+    reference.insert(riter, i);
+    if(iter!=alist.end() && *iter!=*riter){
+      std::cerr<<"Iterator moved by insertion! "<<__FILE__<<":"<<__LINE__<<std::endl;
+      ++ret;
+    }
+  }
+  ret+=check(alist, reference);
+
+  alist.clear();
+  iter=alist.beginModify();
+  iter.insert(5);
+  if(iter!=alist.end() || alist.size()!=1){
+    std::cerr<<"Insertion failed! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+  return ret;
+}
+
+int testDelete()
+{
+  typedef Dune::UnrolledSLList<int,std::allocator<int>,4> List;
+  List alist;
+  std::list<int> reference;
+  int ret=0;
+
+  for(int i=0; i<30; ++i){
+    alist.push_back(i);
+    reference.push_back(i);
+  }
+
+  // remove every entry divisible by three
+  List::ModifyIterator iter=alist.beginModify();
+  std::list<int>::iterator riter=reference.begin();
+  while(iter!=alist.end()){
+    if(*iter%3==0){
+      iter.remove();
+      riter=reference.erase(riter);
+      if(iter!=alist.end() && *iter!=*riter){
+        std::cerr<<"Iterator not positioned after removed entry! "<<__FILE__<<":"<<__LINE__<<std::endl;
+        ++ret;
+      }
+    }else{
+      ++iter;
+      ++riter;
+    }
+  }
+  ret+=check(alist, reference);
+
+  // removing everything must leave a usable list
+  iter=alist.beginModify();
+  while(iter!=alist.end())
+    iter.remove();
+  if(!alist.empty()){
+    std::cerr<<"Removing all entries failed! "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+  iter=alist.endModify();
+  iter.insert(1);
+  alist.push_back(2);
+  reference.clear();
+  reference.push_back(1);
+  reference.push_back(2);
+  ret+=check(alist, reference);
+  return ret;
+}
+
+int testAssign()
+{
+  typedef Dune::UnrolledSLList<int,IntAllocator> List;
+  List alist, blist;
+  int ret=0;
+
+  for(int i=0; i<50; ++i)
+    alist.push_back(i);
+  blist.push_back(-1);
+
+  blist=alist;
+  List copied(alist);
+  if(blist!=alist || !(copied==alist)){
+    std::cerr<<"Asignment failed "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+  *blist.begin()=7;
+  if(blist==alist){
+    std::cerr<<"Comparison failed "<<__FILE__<<":"<<__LINE__<<std::endl;
+    ++ret;
+  }
+  return ret;
+}
+
+int main()
+{
+  int ret=0;
+
+  Dune::UnrolledSLList<double> list;
+  for(int i=0; i<37; ++i)
+    list.push_back(i*0.5);
+
+  Printer<std::iterator_traits<Dune::UnrolledSLList<double>::ModifyIterator>::value_type> print;
+  Dune::UnrolledSLList<double>::ModifyIterator lbegin = list.beginModify(), lend = list.endModify();
+  *lbegin=5.0;
+
+  ret+=testConstIterator(lbegin, lend, print);
+  ret+=testIterator(list);
+  ret+=testPushPop();
+  ret+=testInsert();
+  ret+=testDelete();
+  ret+=testAssign();
+
+  return ret;
+}
@@ -8,6 +8,10 @@
 #include <sys/resource.h>
 #endif
 
+// headers for clock_gettime(2) and gettimeofday(2)
+#include <sys/time.h>
+#include <unistd.h>
+
 #include <ctime>
 
 // headers for stderror(3)
@@ -16,6 +20,10 @@
 // access to errno in C++
 #include <cerrno>
 
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 #include "exceptions.hh"
 
 namespace Dune {
@@ -25,37 +33,197 @@ namespace Dune {
 */
 
 /*! \file
-    \brief A simple timing class.
+    \brief A simple timing class and stop watches with other clocks.
 */
 
   /** \brief %Exception thrown by the Timer class */
   class TimerError : public SystemError {} ;
 
 
-  /** \brief A simple stop watch
+  /** \brief The clocks a BasicTimer can measure with
 
-  This class reports the elapsed user-time, i.e. time spent computing,
-  after the last call to Timer::reset(). The results are seconds and
-  fractional seconds. Note that the resolution of the timing depends
-  on your OS kernel which should be somewhere in the milisecond range.
+  Each clock provides a type time_point, the current time point now()
+  and the seconds between two time points seconds(). The clocks of
+  the operating system are read with clock_gettime(2), which takes
+  a few ten nanoseconds and has nanosecond resolution on Linux.
+  */
+  namespace TimerClocks {
 
-  The class is basically a wrapper for the libc-function getrusage()
-  
-  \warning In a multi-threading situation, this class does NOT return wall-time!
-  Instead, the run time for all threads will be added up.
-  For example, if you have four threads running in parallel taking one second each,
-  then the Timer class will return an elapsed time of four seconds.
+    /** \brief User time of the whole process, summed over all threads
+
+    This is the clock of Timer. It uses getrusage(2), or std::clock() if
+    TIMER_USE_STD_CLOCK is defined, and has a resolution in the
+    millisecond range.
+    */
+    struct ProcessUserTime
+    {
+#ifdef TIMER_USE_STD_CLOCK
+      typedef std::clock_t time_point;
+
+      static time_point now () throw (TimerError)
+      {
+        return std::clock();
+      }
+
+      static double seconds (const time_point& start, const time_point& end)
+      {
+        return (end-start) / static_cast<double>(CLOCKS_PER_SEC);
+      }
+#else
+      typedef struct timeval time_point;
+
+      static time_point now () throw (TimerError)
+      {
+        rusage ru;
+        if (getrusage(RUSAGE_SELF, &ru))
+          DUNE_THROW(TimerError, strerror(errno));
+        return ru.ru_utime;
+      }
+
+      static double seconds (const time_point& start, const time_point& end)
+      {
+        return 1.0 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / (1000.0 * 1000.0);
+      }
+#endif
+    };
+
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+    //! Reads a clock of clock_gettime(2)
+    template<clockid_t id>
+    struct PosixClock
+    {
+      typedef struct timespec time_point;
+
+      static time_point now () throw (TimerError)
+      {
+        time_point t;
+        if (clock_gettime(id, &t))
+          DUNE_THROW(TimerError, strerror(errno));
+        return t;
+      }
+
+      static double seconds (const time_point& start, const time_point& end)
+      {
+        return 1.0 * (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+      }
+    };
+#endif
+
+    /** \brief Monotonic wall clock time
+
+    Uses CLOCK_MONOTONIC, which is not affected by changes of the
+    system time. Falls back to gettimeofday(2) on systems without
+    clock_gettime(2).
+    */
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0) && defined(_POSIX_MONOTONIC_CLOCK)
+    struct WallTime : public PosixClock<CLOCK_MONOTONIC> {};
+#else
+    struct WallTime
+    {
+      typedef struct timeval time_point;
+
+      static time_point now () throw (TimerError)
+      {
+        time_point t;
+        if (gettimeofday(&t, 0))
+          DUNE_THROW(TimerError, strerror(errno));
+        return t;
+      }
+
+      static double seconds (const time_point& start, const time_point& end)
+      {
+        return 1.0 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / (1000.0 * 1000.0);
+      }
+    };
+#endif
+
+    /** \brief CPU time of the calling thread
+
+    Uses CLOCK_THREAD_CPUTIME_ID. A timer with this clock has to be
+    started, read and stopped by the same thread. Falls back to the
+    user time of the process on systems without thread CPU clocks.
+    */
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0) && defined(_POSIX_THREAD_CPUTIME)
+    struct ThreadCPUTime : public PosixClock<CLOCK_THREAD_CPUTIME_ID> {};
+#else
+    struct ThreadCPUTime : public ProcessUserTime {};
+#endif
+
+    /** \brief Wall clock time from the time stamp counter of the CPU
+
+    Reading the counter takes only a few nanoseconds. The counter
+    frequency is calibrated once against WallTime, which takes about
+    10 milliseconds on the first call of now(). The results are only
+    meaningful on CPUs with a constant rate time stamp counter, which
+    is synchronized between the cores, as all recent x86 CPUs have.
+    Falls back to WallTime on other architectures.
+    */
+#if defined(__i386__) || defined(__x86_64__)
+    struct CycleCounter
+    {
+      typedef unsigned long long time_point;
+
+      static time_point now () throw (TimerError)
+      {
+        // calibrate before the first reading, not inside a measurement
+        secondsPerTick();
+        return __rdtsc();
+      }
 
+      static double seconds (const time_point& start, const time_point& end)
+      {
+        return static_cast<double>(static_cast<long long>(end - start)) * secondsPerTick();
+      }
+
+      //! The calibrated length of one tick in seconds
+      static double secondsPerTick () throw (TimerError)
+      {
+        static const double perTick = calibrate();
+        return perTick;
+      }
+
+    private:
+      static double calibrate () throw (TimerError)
+      {
+        WallTime::time_point wallStart = WallTime::now();
+        time_point start = __rdtsc();
+        double wall;
+        do
+          wall = WallTime::seconds(wallStart, WallTime::now());
+        while (wall < 0.01);
+        time_point end = __rdtsc();
+        return wall / static_cast<double>(end - start);
+      }
+    };
+#else
+    struct CycleCounter : public WallTime {};
+#endif
+
+  } // end namespace TimerClocks
+
+
+  /** \brief A stop watch measuring with the clock Clock
+
+  Provides the interface of Timer for all clocks in TimerClocks.
+  The time since the last start is read from the clock directly,
+  stopping adds it to the sum, so the overhead of a start/stop pair
+  is that of reading the clock twice.
+
+  \tparam Clock one of the clocks in TimerClocks
   */
-  class Timer
+  template<class Clock>
+  class BasicTimer
   {
     public:
 
+      //! The clock this timer measures with
+      typedef Clock clock_type;
+
       /** \brief A new timer, create and reset
        *
        * \param startImmediately If true (default) the timer starts counting immediately
        */
-      Timer (bool startImmediately=true) throw(TimerError)
+      BasicTimer (bool startImmediately=true) throw(TimerError)
       {
         isRunning_ = startImmediately;
         reset();
@@ -81,7 +249,7 @@ namespace Dune {
       }
 
 
-      //! Get elapsed user-time from last reset until now/last stop in seconds.
+      //! Get elapsed time from last reset until now/last stop in seconds.
       double elapsed () const throw (TimerError)
       {
         // if timer is running add the time elapsed since last start to sum
@@ -92,7 +260,7 @@ namespace Dune {
       }
 
 
-      //! Get elapsed user-time from last start until now/last stop in seconds.
+      //! Get elapsed time from last start until now/last stop in seconds.
       double lastElapsed () const throw (TimerError)
       {
         // if timer is running return the current value
@@ -124,40 +292,58 @@ namespace Dune {
       double sumElapsed_;
       double storedLastElapsed_;
 
-
-#ifdef TIMER_USE_STD_CLOCK
       void rawReset() throw (TimerError)
       {
-        cstart = std::clock();
+        cstart = Clock::now();
       }
 
       double rawElapsed () const throw (TimerError)
       {
-        return (std::clock()-cstart) / static_cast<double>(CLOCKS_PER_SEC);
+        return Clock::seconds(cstart, Clock::now());
       }
 
-      std::clock_t cstart;
-#else
-      void rawReset() throw (TimerError)
-      {
-        rusage ru;
-        if (getrusage(RUSAGE_SELF, &ru))
-          DUNE_THROW(TimerError, strerror(errno));
-        cstart = ru.ru_utime;
-      }
+      typename Clock::time_point cstart;
+  }; // end class BasicTimer
 
-      double rawElapsed () const throw (TimerError)
-      {
-        rusage ru;
-        if (getrusage(RUSAGE_SELF, &ru))
-          DUNE_THROW(TimerError, strerror(errno));
-        return 1.0 * (ru.ru_utime.tv_sec - cstart.tv_sec) + (ru.ru_utime.tv_usec - cstart.tv_usec) / (1000.0 * 1000.0);
-      }
 
-      struct timeval cstart;
-#endif
+  /** \brief A simple stop watch
+
+  This class reports the elapsed user-time, i.e. time spent computing,
+  after the last call to Timer::reset(). The results are seconds and
+  fractional seconds. Note that the resolution of the timing depends
+  on your OS kernel which should be somewhere in the milisecond range.
+
+  The class is basically a wrapper for the libc-function getrusage()
+  
+  \warning In a multi-threading situation, this class does NOT return wall-time!
+  Instead, the run time for all threads will be added up.
+  For example, if you have four threads running in parallel taking one second each,
+  then the Timer class will return an elapsed time of four seconds.
+  Use WallTimer or ThreadCPUTimer there.
+
+  */
+  class Timer : public BasicTimer<TimerClocks::ProcessUserTime>
+  {
+    public:
+
+      /** \brief A new timer, create and reset
+       *
+       * \param startImmediately If true (default) the timer starts counting immediately
+       */
+      Timer (bool startImmediately=true) throw(TimerError)
+        : BasicTimer<TimerClocks::ProcessUserTime>(startImmediately)
+      {}
   }; // end class Timer
 
+  //! A stop watch measuring wall clock time with nanosecond resolution
+  typedef BasicTimer<TimerClocks::WallTime> WallTimer;
+
+  //! A stop watch measuring the CPU time of the calling thread
+  typedef BasicTimer<TimerClocks::ThreadCPUTime> ThreadCPUTimer;
+
+  //! A stop watch measuring wall clock time with the time stamp counter
+  typedef BasicTimer<TimerClocks::CycleCounter> CycleTimer;
+
 /** @} end documentation */
 
 } // end namespace
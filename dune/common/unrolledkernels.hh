@@ -0,0 +1,921 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_UNROLLEDKERNELS_HH
+#define DUNE_UNROLLEDKERNELS_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include <dune/common/densevector.hh>
+#include <dune/common/forloop.hh>
+#include <dune/common/ftraits.hh>
+#include <dune/common/precision.hh>
+#include <dune/common/promotiontraits.hh>
+
+/*! \file
+ *  \brief Fully unrolled kernels for small FieldVector and FieldMatrix
+ *
+ *  The kernels are built from ForLoop, so that each entry access uses a
+ *  compile-time index. They evaluate the same expressions in the same
+ *  order as the generic loops in DenseVector and DenseMatrix, hence the
+ *  results are identical. For sizes above UnrolledKernels::maxSize they
+ *  forward to the generic implementation.
+ */
+
+namespace Dune
+{
+
+  template< class MAT > class DenseMatrix;
+
+  namespace UnrolledKernels
+  {
+
+    //! sizes up to this value are unrolled
+    enum { maxSize = 8 };
+
+    //! whether loops of length n are unrolled
+    template< int n >
+    struct Unroll
+    {
+      enum { value = (n >= 1 && n <= maxSize) };
+    };
+
+#ifndef DOXYGEN
+    //===== vector operations, applied to entry i
+
+    template< int i >
+    struct AddProduct
+    {
+      template< class S, class X, class Y >
+      static void apply ( S &s, const X &x, const Y &y )
+      {
+        s += S( x[ i ] * y[ i ] );
+      }
+    };
+
+    template< int i >
+    struct AddDot
+    {
+      template< class S, class X, class Y >
+      static void apply ( S &s, const X &x, const Y &y )
+      {
+        s += Dune::dot( x[ i ], y[ i ] );
+      }
+    };
+
+    template< int i >
+    struct AddAbs
+    {
+      template< class S, class X >
+      static void apply ( S &s, const X &x )
+      {
+        s += std::abs( x[ i ] );
+      }
+    };
+
+    template< int i >
+    struct AddAbsReal
+    {
+      template< class S, class X >
+      static void apply ( S &s, const X &x )
+      {
+        s += fvmeta::absreal( x[ i ] );
+      }
+    };
+
+    template< int i >
+    struct AddAbs2
+    {
+      template< class S, class X >
+      static void apply ( S &s, const X &x )
+      {
+        s += fvmeta::abs2( x[ i ] );
+      }
+    };
+
+    template< int i >
+    struct MaxAbs
+    {
+      template< class S, class X >
+      static void apply ( S &s, const X &x )
+      {
+        if( i == 0 )
+          s = std::abs( x[ i ] );
+        else
+          s = std::max( s, std::abs( x[ i ] ) );
+      }
+    };
+
+    template< int i >
+    struct MaxAbsReal
+    {
+      template< class S, class X >
+      static void apply ( S &s, const X &x )
+      {
+        if( i == 0 )
+          s = fvmeta::absreal( x[ i ] );
+        else
+          s = std::max( s, fvmeta::absreal( x[ i ] ) );
+      }
+    };
+#endif // DOXYGEN
+
+    /** \brief Dot products and norms of a vector of size n
+     *
+     *  The primary template unrolls, the specialization for unroll=false
+     *  calls the generic DenseVector methods.
+     */
+    template< int n, bool unroll = Unroll< n >::value >
+    struct VectorKernels
+    {
+      template< class V, class Other >
+      static typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType
+      product ( const DenseVector< V > &x, const DenseVector< Other > &y )
+      {
+        typedef typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType PromotedType;
+        PromotedType result( 0 );
+        assert( y.size() == n );
+        ForLoop< AddProduct, 0, n-1 >::apply( result, x, y );
+        return result;
+      }
+
+      template< class V, class Other >
+      static typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType
+      dot ( const DenseVector< V > &x, const DenseVector< Other > &y )
+      {
+        typedef typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType PromotedType;
+        PromotedType result( 0 );
+        assert( y.size() == n );
+        ForLoop< AddDot, 0, n-1 >::apply( result, x, y );
+        return result;
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      one_norm ( const DenseVector< V > &x )
+      {
+        typename FieldTraits< typename DenseVector< V >::value_type >::real_type result( 0 );
+        ForLoop< AddAbs, 0, n-1 >::apply( result, x );
+        return result;
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      one_norm_real ( const DenseVector< V > &x )
+      {
+        typename FieldTraits< typename DenseVector< V >::value_type >::real_type result( 0 );
+        ForLoop< AddAbsReal, 0, n-1 >::apply( result, x );
+        return result;
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      two_norm2 ( const DenseVector< V > &x )
+      {
+        typename FieldTraits< typename DenseVector< V >::value_type >::real_type result( 0 );
+        ForLoop< AddAbs2, 0, n-1 >::apply( result, x );
+        return result;
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      infinity_norm ( const DenseVector< V > &x )
+      {
+        typename FieldTraits< typename DenseVector< V >::value_type >::real_type result( 0 );
+        ForLoop< MaxAbs, 0, n-1 >::apply( result, x );
+        return result;
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      infinity_norm_real ( const DenseVector< V > &x )
+      {
+        typename FieldTraits< typename DenseVector< V >::value_type >::real_type result( 0 );
+        ForLoop< MaxAbsReal, 0, n-1 >::apply( result, x );
+        return result;
+      }
+    };
+
+#ifndef DOXYGEN
+    template< int n >
+    struct VectorKernels< n, false >
+    {
+      template< class V, class Other >
+      static typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType
+      product ( const DenseVector< V > &x, const DenseVector< Other > &y )
+      {
+        return x.operator*( y );
+      }
+
+      template< class V, class Other >
+      static typename PromotionTraits< typename DenseVector< V >::field_type, typename DenseVector< Other >::field_type >::PromotedType
+      dot ( const DenseVector< V > &x, const DenseVector< Other > &y )
+      {
+        return x.dot( y );
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      one_norm ( const DenseVector< V > &x )
+      {
+        return x.one_norm();
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      one_norm_real ( const DenseVector< V > &x )
+      {
+        return x.one_norm_real();
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      two_norm2 ( const DenseVector< V > &x )
+      {
+        return x.two_norm2();
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      infinity_norm ( const DenseVector< V > &x )
+      {
+        return x.infinity_norm();
+      }
+
+      template< class V >
+      static typename FieldTraits< typename DenseVector< V >::value_type >::real_type
+      infinity_norm_real ( const DenseVector< V > &x )
+      {
+        return x.infinity_norm_real();
+      }
+    };
+
+    //===== matrix-vector operations
+    //
+    // The result is accumulated in a local array s, so that the compiler
+    // need not assume that y aliases A or x. For A x the loop over the
+    // columns is the outer one, such that the updates of all entries of s
+    // for one column are independent and can be vectorized. Each entry of
+    // s still receives its terms in the order of the generic loops.
+
+    template< int j >
+    struct ColumnUpdate
+    {
+      // s[ i ] += A[ i ][ j ] * x[ j ]
+      template< int i >
+      struct Add
+      {
+        template< class S, class M, class X >
+        static void apply ( S &s, const M &A, const X &x )
+        {
+          s[ i ] += A[ i ][ j ] * x[ j ];
+        }
+      };
+
+      // s[ i ] -= A[ i ][ j ] * x[ j ]
+      template< int i >
+      struct Subtract
+      {
+        template< class S, class M, class X >
+        static void apply ( S &s, const M &A, const X &x )
+        {
+          s[ i ] -= A[ i ][ j ] * x[ j ];
+        }
+      };
+
+      // s[ i ] += alpha * A[ i ][ j ] * x[ j ]
+      template< int i >
+      struct AddScaled
+      {
+        template< class S, class F, class M, class X >
+        static void apply ( S &s, const F &alpha, const M &A, const X &x )
+        {
+          s[ i ] += alpha * A[ i ][ j ] * x[ j ];
+        }
+      };
+    };
+
+    template< int i >
+    struct RowUpdate
+    {
+      // s[ j ] += A[ i ][ j ] * x[ i ]
+      template< int j >
+      struct Add
+      {
+        template< class S, class M, class X >
+        static void apply ( S &s, const M &A, const X &x )
+        {
+          s[ j ] += A[ i ][ j ] * x[ i ];
+        }
+      };
+    };
+
+    // apply Update< k >::Op< l > for l = 0, ..., n-1
+    template< template< int > class Update, int n >
+    struct Sweep
+    {
+      template< int k >
+      struct Add
+      {
+        template< class S, class M, class X >
+        static void apply ( S &s, const M &A, const X &x )
+        {
+          ForLoop< Update< k >::template Add, 0, n-1 >::apply( s, A, x );
+        }
+      };
+
+      template< int k >
+      struct Subtract
+      {
+        template< class S, class M, class X >
+        static void apply ( S &s, const M &A, const X &x )
+        {
+          ForLoop< Update< k >::template Subtract, 0, n-1 >::apply( s, A, x );
+        }
+      };
+
+      template< int k >
+      struct AddScaled
+      {
+        template< class S, class F, class M, class X >
+        static void apply ( S &s, const F &alpha, const M &A, const X &x )
+        {
+          ForLoop< Update< k >::template AddScaled, 0, n-1 >::apply( s, alpha, A, x );
+        }
+      };
+    };
+
+    template< int i >
+    struct Load
+    {
+      template< class S, class Y >
+      static void apply ( S &s, const Y &y )
+      {
+        s[ i ] = y[ i ];
+      }
+    };
+
+    template< int i >
+    struct Store
+    {
+      template< class S, class Y >
+      static void apply ( const S &s, Y &y )
+      {
+        y[ i ] = s[ i ];
+      }
+    };
+
+    // C = A B with l columns of A
+    template< int l, int cols >
+    struct Product
+    {
+      template< int i, int j >
+      struct Entry
+      {
+        template< int k >
+        struct Add
+        {
+          template< class S, class A, class B >
+          static void apply ( S &s, const A &a, const B &b )
+          {
+            s += a[ i ][ k ] * b[ k ][ j ];
+          }
+        };
+      };
+
+      template< int i >
+      struct Row
+      {
+        template< int j >
+        struct Assign
+        {
+          template< class C, class A, class B >
+          static void apply ( C &c, const A &a, const B &b )
+          {
+            c[ i ][ j ] = 0;
+            ForLoop< Entry< i, j >::template Add, 0, l-1 >::apply( c[ i ][ j ], a, b );
+          }
+        };
+      };
+
+      template< int i >
+      struct Assign
+      {
+        template< class C, class A, class B >
+        static void apply ( C &c, const A &a, const B &b )
+        {
+          ForLoop< Row< i >::template Assign, 0, cols-1 >::apply( c, a, b );
+        }
+      };
+    };
+#endif // DOXYGEN
+
+    /** \brief Matrix-vector and matrix-matrix products for a rows x cols
+     *  matrix
+     *
+     *  The specialization for unroll=false calls the generic DenseMatrix
+     *  methods.
+     */
+    template< int rows, int cols,
+              bool unroll = Unroll< rows >::value && Unroll< cols >::value >
+    struct MatrixKernels
+    {
+      //! y = A x
+      template< class M, class X, class Y >
+      static void mv ( const M &A, const X &x, Y &y )
+      {
+        typename Y::value_type s[ rows ] = {};
+        ForLoop< Sweep< ColumnUpdate, rows >::template Add, 0, cols-1 >::apply( s, A, x );
+        ForLoop< Store, 0, rows-1 >::apply( s, y );
+      }
+
+      //! y = A^T x
+      template< class M, class X, class Y >
+      static void mtv ( const M &A, const X &x, Y &y )
+      {
+        typename Y::value_type s[ cols ] = {};
+        ForLoop< Sweep< RowUpdate, cols >::template Add, 0, rows-1 >::apply( s, A, x );
+        ForLoop< Store, 0, cols-1 >::apply( s, y );
+      }
+
+      //! y += A x
+      template< class M, class X, class Y >
+      static void umv ( const M &A, const X &x, Y &y )
+      {
+        typename Y::value_type s[ rows ];
+        ForLoop< Load, 0, rows-1 >::apply( s, y );
+        ForLoop< Sweep< ColumnUpdate, rows >::template Add, 0, cols-1 >::apply( s, A, x );
+        ForLoop< Store, 0, rows-1 >::apply( s, y );
+      }
+
+      //! y += A^T x
+      template< class M, class X, class Y >
+      static void umtv ( const M &A, const X &x, Y &y )
+      {
+        typename Y::value_type s[ cols ];
+        ForLoop< Load, 0, cols-1 >::apply( s, y );
+        ForLoop< Sweep< RowUpdate, cols >::template Add, 0, rows-1 >::apply( s, A, x );
+        ForLoop< Store, 0, cols-1 >::apply( s, y );
+      }
+
+      //! y -= A x
+      template< class M, class X, class Y >
+      static void mmv ( const M &A, const X &x, Y &y )
+      {
+        typename Y::value_type s[ rows ];
+        ForLoop< Load, 0, rows-1 >::apply( s, y );
+        ForLoop< Sweep< ColumnUpdate, rows >::template Subtract, 0, cols-1 >::apply( s, A, x );
+        ForLoop< Store, 0, rows-1 >::apply( s, y );
+      }
+
+      //! y += alpha A x
+      template< class M, class F, class X, class Y >
+      static void usmv ( const M &A, const F &alpha, const X &x, Y &y )
+      {
+        typename Y::value_type s[ rows ];
+        ForLoop< Load, 0, rows-1 >::apply( s, y );
+        ForLoop< Sweep< ColumnUpdate, rows >::template AddScaled, 0, cols-1 >::apply( s, alpha, A, x );
+        ForLoop< Store, 0, rows-1 >::apply( s, y );
+      }
+
+      //! A = B A, B is a square matrix
+      template< class M, class B >
+      static void leftmultiply ( M &A, const B &b )
+      {
+        const M C( A );
+        ForLoop< Product< rows, cols >::template Assign, 0, rows-1 >::apply( A, b, C );
+      }
+
+      //! A = A B, B is a square matrix
+      template< class M, class B >
+      static void rightmultiply ( M &A, const B &b )
+      {
+        const M C( A );
+        ForLoop< Product< cols, cols >::template Assign, 0, rows-1 >::apply( A, C, b );
+      }
+    };
+
+#ifndef DOXYGEN
+    template< int rows, int cols >
+    struct MatrixKernels< rows, cols, false >
+    {
+      template< class M, class X, class Y >
+      static void mv ( const DenseMatrix< M > &A, const X &x, Y &y )
+      {
+        A.mv( x, y );
+      }
+
+      template< class M, class X, class Y >
+      static void mtv ( const DenseMatrix< M > &A, const X &x, Y &y )
+      {
+        A.mtv( x, y );
+      }
+
+      template< class M, class X, class Y >
+      static void umv ( const DenseMatrix< M > &A, const X &x, Y &y )
+      {
+        A.umv( x, y );
+      }
+
+      template< class M, class X, class Y >
+      static void umtv ( const DenseMatrix< M > &A, const X &x, Y &y )
+      {
+        A.umtv( x, y );
+      }
+
+      template< class M, class X, class Y >
+      static void mmv ( const DenseMatrix< M > &A, const X &x, Y &y )
+      {
+        A.mmv( x, y );
+      }
+
+      template< class M, class F, class X, class Y >
+      static void usmv ( const DenseMatrix< M > &A, const F &alpha, const X &x, Y &y )
+      {
+        A.usmv( alpha, x, y );
+      }
+
+      template< class M, class B >
+      static void leftmultiply ( DenseMatrix< M > &A, const B &b )
+      {
+        A.leftmultiply( b );
+      }
+
+      template< class M, class B >
+      static void rightmultiply ( DenseMatrix< M > &A, const B &b )
+      {
+        A.rightmultiply( b );
+      }
+    };
+#endif // DOXYGEN
+
+    /** \brief LU decomposition of a square n x n matrix
+     *
+     *  Same pivoting strategy as DenseMatrix::luDecomposition(), but
+     *  instead of throwing an FMatrixError for singular matrices apply()
+     *  returns false.
+     */
+    template< int n >
+    struct LU
+    {
+#ifndef DOXYGEN
+      template< int i, int k >
+      struct Update
+      {
+        template< int j >
+        struct Op
+        {
+          template< class M, class F >
+          static void apply ( M &A, const F &factor )
+          {
+            A[ k ][ j ] -= factor * A[ i ][ j ];
+          }
+        };
+      };
+
+      template< int i >
+      struct Eliminate
+      {
+        template< int k >
+        struct Op
+        {
+          template< class M, class Func >
+          static void apply ( M &A, Func &func )
+          {
+            typename M::field_type factor = A[ k ][ i ] / A[ i ][ i ];
+            A[ k ][ i ] = factor;
+            ForLoop< Update< i, k >::template Op, i+1, n-1 >::apply( A, factor );
+            func( factor, k, i );
+          }
+        };
+      };
+
+      template< int i, bool lastRow = (i == n-1) >
+      struct EliminateBelow
+      {
+        template< class M, class Func >
+        static void apply ( M &A, Func &func )
+        {
+          ForLoop< Eliminate< i >::template Op, i+1, n-1 >::apply( A, func );
+        }
+      };
+
+      template< int i >
+      struct EliminateBelow< i, true >
+      {
+        template< class M, class Func >
+        static void apply ( M &, Func & )
+        {}
+      };
+
+      template< int i >
+      struct Step
+      {
+        template< class M, class Func, class Real >
+        static void apply ( M &A, Func &func, const Real &pivthres, const Real &singthres, bool &regular )
+        {
+          if( !regular )
+            return;
+
+          Real pivmax = fvmeta::absreal( A[ i ][ i ] );
+
+          // pivoting ?
+          if( pivmax < pivthres )
+          {
+            // compute maximum of column
+            int imax = i;
+            Real abs( 0.0 );
+            for( int k = i+1; k < n; ++k )
+              if( (abs = fvmeta::absreal( A[ k ][ i ] )) > pivmax )
+              {
+                pivmax = abs; imax = k;
+              }
+            // swap rows
+            if( imax != i )
+            {
+              for( int j = 0; j < n; ++j )
+                std::swap( A[ i ][ j ], A[ imax ][ j ] );
+              func.swap( i, imax );
+            }
+          }
+
+          // singular ?
+          if( pivmax < singthres )
+          {
+            regular = false;
+            return;
+          }
+
+          EliminateBelow< i >::apply( A, func );
+        }
+      };
+#endif // DOXYGEN
+
+      //! decompose A in place, returns false if A is singular
+      template< class M, class Func >
+      static bool apply ( M &A, Func &func )
+      {
+        typedef typename FieldTraits< typename M::field_type >::real_type real_type;
+        const real_type norm = A.infinity_norm_real(); // for relative thresholds
+        const real_type pivthres = std::max( FMatrixPrecision< real_type >::absolute_limit(), norm * FMatrixPrecision< real_type >::pivoting_limit() );
+        const real_type singthres = std::max( FMatrixPrecision< real_type >::absolute_limit(), norm * FMatrixPrecision< real_type >::singular_limit() );
+
+        bool regular = true;
+        ForLoop< Step, 0, n-1 >::apply( A, func, pivthres, singthres, regular );
+        return regular;
+      }
+    };
+
+#ifndef DOXYGEN
+    //! records the row permutation of an LU decomposition
+    template< int n >
+    struct ElimPivot
+    {
+      ElimPivot ()
+      {
+        for( int i = 0; i < n; ++i )
+          pivot[ i ] = i;
+      }
+
+      void swap ( int i, int j )
+      {
+        pivot[ i ] = j;
+      }
+
+      template< class T >
+      void operator() ( const T &, int, int )
+      {}
+
+      int pivot[ n ];
+    };
+
+    //! records the sign of the row permutation of an LU decomposition
+    template< class K >
+    struct ElimDet
+    {
+      ElimDet () : sign( 1 ) {}
+
+      void swap ( int, int )
+      {
+        sign *= -1;
+      }
+
+      template< class T >
+      void operator() ( const T &, int, int )
+      {}
+
+      K sign;
+    };
+
+    template< int i >
+    struct MultiplyDiagonal
+    {
+      template< class K, class M >
+      static void apply ( K &det, const M &A )
+      {
+        det *= A[ i ][ i ];
+      }
+    };
+
+    template< int i >
+    struct SetIdentityRow
+    {
+      template< class M >
+      static void apply ( M &A )
+      {
+        A[ i ] = typename M::field_type();
+        A[ i ][ i ] = 1;
+      }
+    };
+
+    // row i of X -= LU[i][j] * row j of X
+    template< int n, int i, int j >
+    struct SubtractRow
+    {
+      template< int k >
+      struct Op
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          X[ i ][ k ] -= lu[ i ][ j ] * X[ j ][ k ];
+        }
+      };
+
+      template< class M, class LUType >
+      static void apply ( M &X, const LUType &lu )
+      {
+        ForLoop< Op, 0, n-1 >::apply( X, lu );
+      }
+    };
+
+    template< int n, int i >
+    struct ForwardSubstitution
+    {
+      template< int j >
+      struct Op
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          SubtractRow< n, i, j >::apply( X, lu );
+        }
+      };
+    };
+
+    template< int n, int i >
+    struct BackwardSubstitution
+    {
+      template< int j >
+      struct Op
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          SubtractRow< n, i, j >::apply( X, lu );
+        }
+      };
+
+      template< int k >
+      struct Divide
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          X[ i ][ k ] /= lu[ i ][ i ];
+        }
+      };
+    };
+
+    template< int n >
+    struct Substitution
+    {
+      // L Y = I, row i with i >= 1
+      template< int i >
+      struct Forward
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          ForLoop< ForwardSubstitution< n, i >::template Op, 0, i-1 >::apply( X, lu );
+        }
+      };
+
+      // U X = Y, row n-1-r
+      template< int r, bool lastRow = (r == 0) >
+      struct Backward
+      {
+        enum { i = n-1-r };
+
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          ForLoop< BackwardSubstitution< n, i >::template Op, i+1, n-1 >::apply( X, lu );
+          ForLoop< BackwardSubstitution< n, i >::template Divide, 0, n-1 >::apply( X, lu );
+        }
+      };
+
+      template< int r >
+      struct Backward< r, true >
+      {
+        template< class M, class LUType >
+        static void apply ( M &X, const LUType &lu )
+        {
+          ForLoop< BackwardSubstitution< n, n-1 >::template Divide, 0, n-1 >::apply( X, lu );
+        }
+      };
+
+      template< int r >
+      struct BackwardOp : public Backward< r > {};
+    };
+#endif // DOXYGEN
+
+    /** \brief Determinant of a rows x cols matrix by unrolled LU
+     *  decomposition
+     *
+     *  Only square matrices of size 4 to maxSize are handled here, the
+     *  closed forms in DenseMatrix::determinant() are used below.
+     */
+    template< int rows, int cols,
+              bool unroll = (rows == cols && rows >= 4 && Unroll< rows >::value) >
+    struct Determinant
+    {
+      template< class M >
+      static typename M::field_type apply ( const M &A )
+      {
+        M lu( A );
+        ElimDet< typename M::field_type > elim;
+        if( !LU< rows >::apply( lu, elim ) )
+          return 0;
+        typename M::field_type det = elim.sign;
+        ForLoop< MultiplyDiagonal, 0, rows-1 >::apply( det, lu );
+        return det;
+      }
+    };
+
+#ifndef DOXYGEN
+    template< int rows, int cols >
+    struct Determinant< rows, cols, false >
+    {
+      template< class M >
+      static typename DenseMatrix< M >::field_type apply ( const DenseMatrix< M > &A )
+      {
+        return A.determinant();
+      }
+    };
+#endif // DOXYGEN
+
+    /** \brief Inverse of a rows x cols matrix by unrolled LU
+     *  decomposition
+     *
+     *  Only square matrices of size 3 to maxSize are handled here, the
+     *  closed forms in DenseMatrix::invert() are used below. apply()
+     *  returns false if the matrix is singular.
+     */
+    template< int rows, int cols,
+              bool unroll = (rows == cols && rows >= 3 && Unroll< rows >::value) >
+    struct Inverse
+    {
+      template< class M >
+      static bool apply ( M &A )
+      {
+        M lu( A );
+        ElimPivot< rows > elim;
+        if( !LU< rows >::apply( lu, elim ) )
+          return false;
+
+        ForLoop< SetIdentityRow, 0, rows-1 >::apply( A );
+        ForLoop< Substitution< rows >::template Forward, 1, rows-1 >::apply( A, lu );
+        ForLoop< Substitution< rows >::template BackwardOp, 0, rows-1 >::apply( A, lu );
+
+        for( int i = rows; i > 0; )
+        {
+          --i;
+          if( i != elim.pivot[ i ] )
+            for( int j = 0; j < rows; ++j )
+              std::swap( A[ j ][ elim.pivot[ i ] ], A[ j ][ i ] );
+        }
+        return true;
+      }
+    };
+
+#ifndef DOXYGEN
+    template< int rows, int cols >
+    struct Inverse< rows, cols, false >
+    {
+      template< class M >
+      static bool apply ( DenseMatrix< M > &A )
+      {
+        A.invert();
+        return true;
+      }
+    };
+#endif // DOXYGEN
+
+  } // end namespace UnrolledKernels
+
+} // end namespace Dune
+
+#endif
@@ -0,0 +1,811 @@
+// $Id$
+#ifndef DUNE_UNROLLEDSLLIST_HH
+#define DUNE_UNROLLEDSLLIST_HH
+
+#include<memory>
+#include<cassert>
+#include"iteratorfacades.hh"
+#include"static_assert.hh"
+#include<ostream>
+
+namespace Dune
+{
+  /**
+   * @addtogroup Common
+   *
+   * @{
+   */
+  /**
+   * @file
+   * \brief Implements an unrolled singly linked list together with
+   * the necessary iterators.
+   */
+  template<typename T, class A, int N>
+  class UnrolledSLListIterator;
+
+  template<typename T, class A, int N>
+  class UnrolledSLListConstIterator;
+
+  template<typename T, class A, int N>
+  class UnrolledSLListModifyIterator;
+
+  /**
+   * @brief An unrolled singly linked list.
+   *
+   * Instead of allocating one node per entry as SLList does, each node
+   * stores up to N consecutive entries in an array. Traversing the list
+   * therefore touches contiguous memory and only has to follow a
+   * pointer every N entries.
+   *
+   * The interface is the one of SLList: Insertions at the front and
+   * at the end and removal at the front need constant time, insertion
+   * and removal at arbitrary positions is done via the
+   * UnrolledSLListModifyIterator with the same semantics as the
+   * SLListModifyIterator. Inserting or removing an entry moves the
+   * other entries of the same node, thus it invalidates all iterators
+   * into the list except the modifying iterator used.
+   *
+   * @tparam T The type of the entries. It has to be default
+   * constructible and assignable.
+   * @tparam A The allocator to use.
+   * @tparam N The maximum number of entries per node.
+   */
+  template<typename T, class A=std::allocator<T>, int N=16>
+  class UnrolledSLList
+  {
+    struct Node;
+    friend class UnrolledSLListIterator<T,A,N>;
+    friend class UnrolledSLListConstIterator<T,A,N>;
+    friend class UnrolledSLListModifyIterator<T,A,N>;
+
+    dune_static_assert(N>1, "A node has to hold at least two entries");
+
+  public:
+
+    /**
+     * @brief The size type.
+     */
+    typedef typename A::size_type size_type;
+
+    /**
+     * @brief The type we store.
+     */
+    typedef T MemberType;
+
+    /**
+     * @brief The allocator to use.
+     */
+    typedef typename A::template rebind<Node>::other Allocator;
+
+    /**
+     * @brief The mutable iterator of the list.
+     */
+    typedef UnrolledSLListIterator<T,A,N> iterator;
+
+    /**
+     * @brief The constant iterator of the list.
+     */
+    typedef UnrolledSLListConstIterator<T,A,N> const_iterator;
+
+    /**
+     * @brief The type of the iterator capable of deletion
+     * and insertion.
+     */
+    typedef UnrolledSLListModifyIterator<T,A,N> ModifyIterator;
+
+    enum{
+      /** @brief The maximum number of entries stored in one node. */
+      nodeSize=N
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    UnrolledSLList();
+
+    /**
+     * @brief Copy constructor.
+     */
+    UnrolledSLList(const UnrolledSLList<T,A,N>& other);
+
+    /**
+     * @brief Destructor.
+     *
+     * Deallocates all nodes of the list.
+     */
+    ~UnrolledSLList();
+
+    /**
+     * @brief Assignment operator.
+     */
+    UnrolledSLList<T,A,N>& operator=(const UnrolledSLList<T,A,N>& other);
+
+    /**
+     * @brief Add a new entry to the end of the list.
+     * @param item The item to add.
+     */
+    inline void push_back(const MemberType& item);
+
+    /**
+     * @brief Add a new entry to the beginning of the list.
+     * @param item The item to add.
+     */
+    inline void push_front(const MemberType& item);
+
+    /**
+     * @brief Remove the first item in the list.
+     */
+    inline void pop_front();
+
+    /** @brief Remove all elements from the list. */
+    inline void clear();
+
+    /**
+     * @brief Get an iterator pointing to the first
+     * element in the list.
+     *
+     * @return An iterator pointing to the first
+     * element or the end if the list is empty.
+     */
+    inline iterator begin();
+
+    /**
+     * @brief Get an iterator pointing to the first
+     * element in the list.
+     *
+     * @return An iterator pointing to the first
+     * element or the end if the list is empty.
+     */
+    inline const_iterator begin() const;
+
+    /**
+     * @brief Get an iterator capable of deleting and
+     * inserting elements.
+     *
+     * @return Modifying iterator positioned at the beginning
+     * of the list.
+     */
+    inline ModifyIterator beginModify();
+
+    /**
+     * @brief Get an iterator capable of deleting and
+     * inserting elements.
+     *
+     * @return Modifying iterator positioned after the end
+     * of the list.
+     */
+    inline ModifyIterator endModify();
+
+    /**
+     * @brief Get an iterator pointing to the
+     * end of the list.
+     *
+     * @return An iterator pointing to the end.
+     */
+    inline iterator end();
+
+    /**
+     * @brief Get an iterator pointing to the
+     * end of the list.
+     *
+     * @return An iterator pointing to the end.
+     */
+    inline const_iterator end() const;
+
+    /**
+     * @brief Check whether the list is empty.
+     *
+     * @return True if the list is empty;
+     */
+    inline bool empty() const;
+
+    /**
+     * @brief Get the number of elements the list
+     * contains.
+     */
+    inline int size() const;
+
+    bool operator==(const UnrolledSLList& sl) const;
+
+    bool operator!=(const UnrolledSLList& sl) const;
+
+  private:
+    /** @brief A node holding up to N consecutive entries. */
+    struct Node
+    {
+      /** @brief The next node in the list. */
+      Node* next_;
+      /** @brief The number of entries used. */
+      int count_;
+      /** @brief The entries, only the first count_ are valid. */
+      MemberType items_[N];
+
+      Node()
+        : next_(0), count_(0)
+      {}
+    };
+
+    /** @brief Allocate an empty node. */
+    Node* newNode();
+
+    /** @brief Deallocate a node. */
+    void deleteNode(Node* node);
+
+    /**
+     * @brief Insert an item before position index of a node.
+     *
+     * If the node is full it is split into two nodes first.
+     * @param node The node to insert into, holding index on entry.
+     * @param index The position to insert at, holding the position
+     * of the entry after the inserted one on exit.
+     * @param prev The node before node. Updated if the entry after the
+     * inserted one moved to a new node.
+     * @param item The item to insert.
+     */
+    void insertAt(Node*& node, int& index, Node*& prev, const T& item);
+
+    /**
+     * @brief Remove the entry at position index of a node.
+     *
+     * Empty nodes are unlinked and deallocated.
+     * @param node The node, holding the entry after the removed one
+     * (or 0 if there is none) on exit.
+     * @param index The position of the entry to remove, holding the
+     * position of the entry after the removed one on exit.
+     * @param prev The node before node, updated accordingly.
+     */
+    void removeAt(Node*& node, int& index, Node*& prev);
+
+    /**
+     * @brief Copy the elements from another list.
+     * @param other The other list.
+     */
+    void copyElements(const UnrolledSLList<T,A,N>& other);
+
+    /** @brief The first node or 0 if the list is empty. */
+    Node* head_;
+
+    /** @brief The last node or 0 if the list is empty. */
+    Node* tail_;
+
+    /** @brief The allocator we use. */
+    Allocator allocator_;
+
+    /** brief The number of elements the list holds. */
+    int size_;
+  };
+
+  /**
+   * @brief A mutable iterator for the UnrolledSLList.
+   */
+  template<typename T, class A, int N>
+  class UnrolledSLListIterator
+    : public Dune::ForwardIteratorFacade<UnrolledSLListIterator<T,A,N>, T, T&, std::size_t>
+  {
+    friend class UnrolledSLListConstIterator<T,A,N>;
+    friend class UnrolledSLListModifyIterator<T,A,N>;
+    friend class UnrolledSLList<T,A,N>;
+
+    typedef typename UnrolledSLList<T,A,N>::Node Node;
+
+  public:
+    inline UnrolledSLListIterator(Node* node, int index)
+      : node_(node), index_(index)
+    {}
+
+    inline UnrolledSLListIterator()
+      : node_(0), index_(0)
+    {}
+
+    inline UnrolledSLListIterator(const UnrolledSLListModifyIterator<T,A,N>& other)
+      : node_(other.node_), index_(other.index_)
+    {}
+
+    /**
+     * @brief Dereferencing function for the iterator facade.
+     * @return A reference to the element at the current position.
+     */
+    inline T& dereference() const
+    {
+      return node_->items_[index_];
+    }
+
+    /**
+     * @brief Equality test for the iterator facade.
+     * @param other The other iterator to check.
+     * @return true If the other iterator is at the same position.
+     */
+    inline bool equals(const UnrolledSLListConstIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Equality test for the iterator facade.
+     * @param other The other iterator to check.
+     * @return true If the other iterator is at the same position.
+     */
+    inline bool equals(const UnrolledSLListIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Equality test for the iterator facade.
+     * @param other The other iterator to check.
+     * @return true If the other iterator is at the same position.
+     */
+    inline bool equals(const UnrolledSLListModifyIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Increment function for the iterator facade.
+     */
+    inline void increment()
+    {
+      if(++index_==node_->count_){
+        node_ = node_->next_;
+        index_ = 0;
+      }
+    }
+
+  private:
+    /** @brief The current node. */
+    Node* node_;
+    /** @brief The position inside the current node. */
+    int index_;
+  };
+
+  /**
+   * @brief A constant iterator for the UnrolledSLList.
+   */
+  template<typename T, class A, int N>
+  class UnrolledSLListConstIterator
+    : public Dune::ForwardIteratorFacade<UnrolledSLListConstIterator<T,A,N>, const T, const T&, std::size_t>
+  {
+    friend class UnrolledSLListIterator<T,A,N>;
+    friend class UnrolledSLListModifyIterator<T,A,N>;
+    friend class UnrolledSLList<T,A,N>;
+
+    typedef typename UnrolledSLList<T,A,N>::Node Node;
+
+  public:
+    inline UnrolledSLListConstIterator()
+      : node_(0), index_(0)
+    {}
+
+    inline UnrolledSLListConstIterator(const Node* node, int index)
+      : node_(node), index_(index)
+    {}
+
+    inline UnrolledSLListConstIterator(const UnrolledSLListIterator<T,A,N>& other)
+      : node_(other.node_), index_(other.index_)
+    {}
+
+    inline UnrolledSLListConstIterator(const UnrolledSLListModifyIterator<T,A,N>& other)
+      : node_(other.node_), index_(other.index_)
+    {}
+
+    /**
+     * @brief Dereferencing function for the facade.
+     * @return A reference to the element at the current position.
+     */
+    inline const T& dereference() const
+    {
+      return node_->items_[index_];
+    }
+
+    /**
+     * @brief Equality test for the iterator facade.
+     * @param other The other iterator to check.
+     * @return true If the other iterator is at the same position.
+     */
+    inline bool equals(const UnrolledSLListConstIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Increment function for the iterator facade.
+     */
+    inline void increment()
+    {
+      if(++index_==node_->count_){
+        node_ = node_->next_;
+        index_ = 0;
+      }
+    }
+
+  private:
+    /** @brief The current node. */
+    const Node* node_;
+    /** @brief The position inside the current node. */
+    int index_;
+  };
+
+  /**
+   * @brief An iterator for the UnrolledSLList capable of inserting
+   * and removing entries.
+   *
+   * Insertion and removal behave exactly as for the SLListModifyIterator.
+   */
+  template<typename T, class A, int N>
+  class UnrolledSLListModifyIterator
+    : public Dune::ForwardIteratorFacade<UnrolledSLListModifyIterator<T,A,N>, T, T&, std::size_t>
+  {
+    friend class UnrolledSLListConstIterator<T,A,N>;
+    friend class UnrolledSLListIterator<T,A,N>;
+    friend class UnrolledSLList<T,A,N>;
+
+    typedef typename UnrolledSLList<T,A,N>::Node Node;
+
+  public:
+    inline UnrolledSLListModifyIterator(UnrolledSLList<T,A,N>* list, Node* prev,
+                                        Node* node, int index)
+      : list_(list), prev_(prev), node_(node), index_(index)
+    {}
+
+    inline UnrolledSLListModifyIterator()
+      : list_(0), prev_(0), node_(0), index_(0)
+    {}
+
+    /**
+     * @brief Dereferencing function for the iterator facade.
+     * @return A reference to the element at the current position.
+     */
+    inline T& dereference() const
+    {
+      return node_->items_[index_];
+    }
+
+    /**
+     * @brief Test whether another iterator is equal.
+     * @return true if the other iterator is at the same position as
+     * this one.
+     */
+    inline bool equals(const UnrolledSLListConstIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Test whether another iterator is equal.
+     * @return true if the other iterator is at the same position as
+     * this one.
+     */
+    inline bool equals(const UnrolledSLListIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Test whether another iterator is equal.
+     * @return true if the other iterator is at the same position as
+     * this one.
+     */
+    inline bool equals(const UnrolledSLListModifyIterator<T,A,N>& other) const
+    {
+      return node_==other.node_ && index_==other.index_;
+    }
+
+    /**
+     * @brief Increment function for the iterator facade.
+     */
+    inline void increment()
+    {
+      if(++index_==node_->count_){
+        prev_ = node_;
+        node_ = node_->next_;
+        index_ = 0;
+      }
+    }
+
+    /**
+     * @brief Insert an element at the current position.
+     *
+     * Starting from the element at the current position all
+     * elements will be shifted by one position to the back.
+     * The iterator will point to the same element as before
+     * after the insertion, i.e the number of increments to
+     * reach the same position from a begin iterator increases
+     * by one.
+     * This means the inserted element is the one before the one
+     * the iterator points to.
+     * @param v The value to insert.
+     */
+    inline void insert(const T& v)
+    {
+      assert(list_);
+      list_->insertAt(node_, index_, prev_, v);
+    }
+
+    /**
+     * @brief Delete the entry at the current position.
+     *
+     * The iterator will be positioned at the next postion after the
+     * deletion
+     * @warning This will invalidate all other iterators into the list! Use with care!
+     */
+    inline void remove()
+    {
+      assert(list_);
+      list_->removeAt(node_, index_, prev_);
+    }
+
+  private:
+    /** @brief The list we iterate over. */
+    UnrolledSLList<T,A,N>* list_;
+    /** @brief The node before the current one, 0 if at the first node. */
+    Node* prev_;
+    /** @brief The current node, 0 if at the end. */
+    Node* node_;
+    /** @brief The position inside the current node. */
+    int index_;
+  };
+
+  template<typename T, class A, int N>
+  std::ostream& operator<<(std::ostream& os, const UnrolledSLList<T,A,N>& list)
+  {
+    typedef typename UnrolledSLList<T,A,N>::const_iterator Iterator;
+    Iterator end = list.end();
+    Iterator current= list.begin();
+
+    os << "{ ";
+
+    if(current!=end){
+      os<<*current;
+      ++current;
+
+      for(; current != end; ++current)
+        os<<", "<<*current;
+    }
+    os<<"} ";
+    return os;
+  }
+
+  template<typename T, class A, int N>
+  UnrolledSLList<T,A,N>::UnrolledSLList()
+    : head_(0), tail_(0), allocator_(), size_(0)
+  {}
+
+  template<typename T, class A, int N>
+  UnrolledSLList<T,A,N>::UnrolledSLList(const UnrolledSLList<T,A,N>& other)
+    : head_(0), tail_(0), allocator_(), size_(0)
+  {
+    copyElements(other);
+  }
+
+  template<typename T, class A, int N>
+  UnrolledSLList<T,A,N>::~UnrolledSLList()
+  {
+    clear();
+  }
+
+  template<typename T, class A, int N>
+  UnrolledSLList<T,A,N>& UnrolledSLList<T,A,N>::operator=(const UnrolledSLList<T,A,N>& other)
+  {
+    if(this!=&other){
+      clear();
+      copyElements(other);
+    }
+    return *this;
+  }
+
+  template<typename T, class A, int N>
+  void UnrolledSLList<T,A,N>::copyElements(const UnrolledSLList<T,A,N>& other)
+  {
+    assert(size_==0);
+    for(const Node* node=other.head_; node; node=node->next_)
+      for(int i=0; i<node->count_; ++i)
+        push_back(node->items_[i]);
+    assert(other.size()==size());
+  }
+
+  template<typename T, class A, int N>
+  bool UnrolledSLList<T,A,N>::operator==(const UnrolledSLList& other) const
+  {
+    if(size()!=other.size())
+      return false;
+    for(const_iterator iter=begin(), oiter=other.begin();
+        iter != end(); ++iter, ++oiter)
+      if(*iter!=*oiter)
+        return false;
+    return true;
+  }
+
+  template<typename T, class A, int N>
+  bool UnrolledSLList<T,A,N>::operator!=(const UnrolledSLList& other) const
+  {
+    return !(*this==other);
+  }
+
+  template<typename T, class A, int N>
+  typename UnrolledSLList<T,A,N>::Node* UnrolledSLList<T,A,N>::newNode()
+  {
+    Node* node = allocator_.allocate(1, 0);
+    ::new (static_cast<void*>(node)) Node();
+    return node;
+  }
+
+  template<typename T, class A, int N>
+  void UnrolledSLList<T,A,N>::deleteNode(Node* node)
+  {
+    node->~Node();
+    allocator_.deallocate(node, 1);
+  }
+
+  template<typename T, class A, int N>
+  inline void UnrolledSLList<T,A,N>::push_back(const MemberType& item)
+  {
+    if(!tail_){
+      head_ = tail_ = newNode();
+    }else if(tail_->count_==N){
+      tail_->next_ = newNode();
+      tail_ = tail_->next_;
+    }
+    tail_->items_[tail_->count_++] = item;
+    ++size_;
+  }
+
+  template<typename T, class A, int N>
+  inline void UnrolledSLList<T,A,N>::push_front(const MemberType& item)
+  {
+    if(!head_ || head_->count_==N){
+      Node* node = newNode();
+      node->next_ = head_;
+      head_ = node;
+      if(!tail_)
+        tail_ = node;
+    }else{
+      for(int i=head_->count_; i>0; --i)
+        head_->items_[i] = head_->items_[i-1];
+    }
+    head_->items_[0] = item;
+    ++head_->count_;
+    ++size_;
+  }
+
+  template<typename T, class A, int N>
+  inline void UnrolledSLList<T,A,N>::pop_front()
+  {
+    assert(head_);
+    Node* node = head_;
+    Node* prev = 0;
+    int index = 0;
+    removeAt(node, index, prev);
+  }
+
+  template<typename T, class A, int N>
+  void UnrolledSLList<T,A,N>::insertAt(Node*& node, int& index, Node*& prev, const T& item)
+  {
+    if(!node){
+      // insertion at the end, the iterator stays there
+      push_back(item);
+      prev = tail_;
+      return;
+    }
+    assert(index<node->count_);
+
+    if(node->count_==N){
+      // split the full node in two halves
+      Node* second = newNode();
+      const int half = N/2;
+      for(int i=half; i<N; ++i){
+        second->items_[i-half] = node->items_[i];
+        node->items_[i] = T();
+      }
+      second->count_ = N-half;
+      node->count_ = half;
+      second->next_ = node->next_;
+      node->next_ = second;
+      if(tail_==node)
+        tail_ = second;
+      if(index>=half){
+        prev = node;
+        node = second;
+        index -= half;
+      }
+    }
+
+    for(int i=node->count_; i>index; --i)
+      node->items_[i] = node->items_[i-1];
+    node->items_[index] = item;
+    ++node->count_;
+    ++index;
+    ++size_;
+  }
+
+  template<typename T, class A, int N>
+  void UnrolledSLList<T,A,N>::removeAt(Node*& node, int& index, Node*& prev)
+  {
+    assert(node && index<node->count_);
+    for(int i=index+1; i<node->count_; ++i)
+      node->items_[i-1] = node->items_[i];
+    // release resources held by the now unused entry
+    node->items_[--node->count_] = T();
+    --size_;
+
+    if(node->count_==0){
+      // unlink the empty node
+      Node* next = node->next_;
+      if(prev)
+        prev->next_ = next;
+      else
+        head_ = next;
+      if(tail_==node)
+        tail_ = prev;
+      deleteNode(node);
+      node = next;
+      index = 0;
+    }else if(index==node->count_){
+      prev = node;
+      node = node->next_;
+      index = 0;
+    }
+  }
+
+  template<typename T, class A, int N>
+  inline void UnrolledSLList<T,A,N>::clear()
+  {
+    while(head_){
+      Node* next = head_->next_;
+      deleteNode(head_);
+      head_ = next;
+    }
+    tail_ = 0;
+    size_ = 0;
+  }
+
+  template<typename T, class A, int N>
+  inline bool UnrolledSLList<T,A,N>::empty() const
+  {
+    return size_==0;
+  }
+
+  template<typename T, class A, int N>
+  inline int UnrolledSLList<T,A,N>::size() const
+  {
+    return size_;
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListIterator<T,A,N> UnrolledSLList<T,A,N>::begin()
+  {
+    return iterator(head_, 0);
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListConstIterator<T,A,N> UnrolledSLList<T,A,N>::begin() const
+  {
+    return const_iterator(head_, 0);
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListIterator<T,A,N> UnrolledSLList<T,A,N>::end()
+  {
+    return iterator();
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListConstIterator<T,A,N> UnrolledSLList<T,A,N>::end() const
+  {
+    return const_iterator();
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListModifyIterator<T,A,N> UnrolledSLList<T,A,N>::beginModify()
+  {
+    return ModifyIterator(this, 0, head_, 0);
+  }
+
+  template<typename T, class A, int N>
+  inline UnrolledSLListModifyIterator<T,A,N> UnrolledSLList<T,A,N>::endModify()
+  {
+    return ModifyIterator(this, tail_, 0, 0);
+  }
+
+  /** }@ */
+}
+#endif
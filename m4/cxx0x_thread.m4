@@ -0,0 +1,42 @@
+# tests compiler and library support for the C++0x thread support
+# (<thread>, <mutex> and <atomic>)
+# the associated macro is called HAVE_STD_THREAD
+
+AC_DEFUN([STD_THREAD_CHECK],[
+  AC_REQUIRE([ACX_PTHREAD])
+  AC_CACHE_CHECK([whether std::thread, std::mutex and std::atomic are supported], dune_cv_std_thread_support, [
+    AC_REQUIRE([AC_PROG_CXX])
+    AC_REQUIRE([GXX0X])
+    AC_LANG_PUSH([C++])
+    ac_save_CXXFLAGS="$CXXFLAGS"
+    ac_save_LIBS="$LIBS"
+    CXXFLAGS="$CXXFLAGS $PTHREAD_CFLAGS"
+    LIBS="$PTHREAD_LIBS $LIBS"
+    AC_LINK_IFELSE([
+      AC_LANG_PROGRAM([#include <atomic>
+        #include <mutex>
+        #include <thread>
+
+        std::atomic<int> counter(0);
+        std::mutex m;
+
+        void work()
+        {
+          std::lock_guard<std::mutex> lock(m);
+          ++counter;
+        }],
+        [
+          std::thread t(work);
+          t.join();
+          return counter == 1 ? 0 : 1;
+        ])],
+      dune_cv_std_thread_support=yes,
+      dune_cv_std_thread_support=no)
+    CXXFLAGS="$ac_save_CXXFLAGS"
+    LIBS="$ac_save_LIBS"
+    AC_LANG_POP
+  ])
+  if test "x$dune_cv_std_thread_support" = xyes; then
+    AC_DEFINE(HAVE_STD_THREAD, 1, [Define to 1 if std::thread, std::mutex and std::atomic are supported])
+  fi
+])